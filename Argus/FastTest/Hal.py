@@ -12,7 +12,7 @@ sys.path.append(os.path.abspath('..'))
 
 import FastTest
 from FastTest import Broker, Exchange, Asset, Portfolio, Hydra
-from FastTest import PortfolioTracerType, ExchangeQueryType, OrderExecutionType
+from FastTest import PortfolioTracerType, ExchangeQueryType, OrderExecutionType, AssetLayout, AssetPrecision
 
 class Hal:
     def __init__(self, logging : int, cash : float = 0.0) -> None:
@@ -40,6 +40,9 @@ class Hal:
         to_epoch = pd.to_datetime(datetime).value
         self.hydra.goto_datetime(to_epoch)
         
+    def set_threads(self, threads : int):
+        self.hydra.set_threads(threads)
+        
     def get_hydra(self) -> FastTest.Hydra:
         return self.hydra
         
@@ -89,7 +92,24 @@ class Hal:
         self.run()
         pr.disable()
         pr.print_stats(sort='cumulative')
-        
+
+    def get_profile(self) -> pd.DataFrame:
+        """get the engine's event loop profile as a dataframe, one row per phase and strategy handler.
+        Latency histograms are available through hydra.get_profile()
+
+        Returns:
+            pd.DataFrame: calls, total, mean and max time in ns of each phase
+        """
+        profile = self.hydra.get_profile()
+        rows = {}
+        for phase, counter in profile["phases"].items():
+            rows[phase] = counter
+        for strategy_id, strategy_profile in profile["strategies"].items():
+            for handler, counter in strategy_profile.items():
+                rows[f"{strategy_id}.{handler}"] = counter
+        df = pd.DataFrame.from_dict(rows, orient = "index")
+        return df[["calls", "total_ns", "mean_ns", "max_ns"]]
+
     def get_hydra_time(self):
         return datetime.fromtimestamp(self.hydra.get_hydra_time())
 
@@ -116,15 +136,11 @@ class Hal:
 
     def asset_to_df(self, asset : FastTest.Asset):        
         datetime_index = asset.get_datetime_index_view()
-        data_rm = asset.get_data_view()
 
-        # Reshape the array to match the desired row-wise representation
-        num_rows = asset.get_rows()
-        num_cols = len(data_rm) // num_rows
-        data_rm = np.reshape(data_rm, (num_rows, num_cols))
+        # (rows, cols) view strided according to the asset's layout
+        data = asset.get_data_view()
 
-        data_cm = np.transpose(data_rm)
-        asset_df = pd.DataFrame(data_cm).T
+        asset_df = pd.DataFrame(np.array(data))
         asset_df.index = pd.to_datetime(datetime_index)
         asset_df.columns = asset.get_headers()
         return asset_df
@@ -134,7 +150,10 @@ class Hal:
                             asset_id : str,
                             exchange_id : str,
                             broker_id : str,
-                            warmup : int):
+                            warmup : int,
+                            layout : AssetLayout = AssetLayout.ROW_MAJOR,
+                            copy : bool = True,
+                            precision : AssetPrecision = AssetPrecision.FLOAT64):
         """register an load in a new asset from a pandas dataframe
 
         Args:
@@ -142,9 +161,64 @@ class Hal:
             asset_id (str): unique id of the new asset
             exchange_id (str): unique id of the exchange to place the asset on
             broker_id (str): unique id of the broker to place the asset on
+            layout (AssetLayout): memory layout of the asset's data
+            copy (bool): copy the dataframe's values, if false the asset views them directly
+            precision (AssetPrecision): element type to store the asset's values as
         """
-        asset = asset_from_df(df, asset_id, exchange_id, broker_id, warmup)
+        asset = asset_from_df(df, asset_id, exchange_id, broker_id, warmup, layout, copy, precision)
         self.register_asset(asset, exchange_id)
+
+    def register_assets_from_dfs(self,
+                            dfs : dict,
+                            exchange_id : str,
+                            broker_id : str,
+                            warmup : int = 0,
+                            layout : AssetLayout = AssetLayout.ROW_MAJOR,
+                            precision : AssetPrecision = AssetPrecision.FLOAT64):
+        """register and load many assets from pandas dataframes. The values are copied into the assets
+        across the hydra's threads (see set_threads) with the GIL released
+
+        Args:
+            dfs (dict): pandas dataframe of each asset keyed by asset id
+            exchange_id (str): unique id of the exchange to place the assets on
+            broker_id (str): unique id of the broker to place the assets on
+            warmup (int): warmup of each asset
+            layout (AssetLayout): memory layout of the assets' data
+            precision (AssetPrecision): element type to store the assets' values as
+        """
+        asset_ids, headers, values, indexes = [], [], [], []
+        for asset_id, df in dfs.items():
+            data = df.values
+            if data.dtype != np.float32:
+                data = data.astype(np.float64, copy = False)
+            if isinstance(df.index, pd.DatetimeIndex):
+                index = df.index.values.astype(np.int64)
+            elif df.index.dtype == 'object':
+                index = pd.to_datetime(df.index).values.astype(np.int64)
+            else:
+                index = df.index.values.astype(np.int64)
+            asset_ids.append(asset_id)
+            headers.append(df.columns.tolist())
+            values.append(data)
+            indexes.append(np.ascontiguousarray(index))
+        return self.hydra.register_assets(asset_ids, exchange_id, broker_id, headers, values, indexes,
+                                          warmup, layout, precision)
+
+    def register_asset_directory(self,
+                            path : str,
+                            exchange_id : str,
+                            broker_id : str,
+                            warmup : int = 0):
+        """memory map and register every binary asset file (.argus) in a directory
+
+        Args:
+            path (str): directory of asset files written with Asset.save_binary
+            exchange_id (str): unique id of the exchange to place the assets on
+            broker_id (str): unique id of the broker to place the assets on
+            warmup (int): warmup of each asset
+        """
+        for asset in FastTest.load_asset_directory(path, exchange_id, broker_id, warmup):
+            self.register_asset(asset, exchange_id)
         
     def get_order_history(self):
         orders = self.hydra.get_order_history()
@@ -190,7 +264,10 @@ def asset_from_df(df: Type[pd.DataFrame],
                 asset_id: str,
                 exchange_id : str,
                 broker_id : str,
-                warmup = 0) -> Asset:
+                warmup = 0,
+                layout : AssetLayout = AssetLayout.ROW_MAJOR,
+                copy : bool = True,
+                precision : AssetPrecision = AssetPrecision.FLOAT64) -> Asset:
     """generate a new asset object from a pandas dataframe. Pandas index must have a pandas datetime
     index or a ns epoch time index
     
@@ -199,11 +276,24 @@ def asset_from_df(df: Type[pd.DataFrame],
         asset_id (str): unique id of the new asset
         exchange_id (str): unique id of the exchange to place the asset on
         broker_id (str): unique id of the broker to place the asset on
+        layout (AssetLayout): memory layout of the asset's data, column major assets return contiguous
+            columns from get_column
+        copy (bool): copy the dataframe's values into the asset. If false the asset holds a reference
+            to the values and reads them in place, the layout then follows the values' strides
+        precision (AssetPrecision): element type to store the values as, float32 halves the memory
+            of the asset. Scalar reads are widened to float64 and column views keep the stored type
     Returns:
         Asset: a new Asset object
     """
-    # extract underlying numpy arrays
-    values = df.values.astype(np.float64)
+    # extract underlying numpy arrays, load_data expects the columns back to back while a view
+    # keeps the 2d values and their strides
+    if copy:
+        values = np.asfortranarray(df.values).ravel(order = "F")
+        if values.dtype != np.float32:
+            values = values.astype(np.float64)
+    else:
+        dtype = np.float32 if precision == AssetPrecision.FLOAT32 else np.float64
+        values = np.asarray(df.values, dtype = dtype)
     
     #convert datetime index to ns epoch time
     if isinstance(df.index, pd.DatetimeIndex):
@@ -216,6 +306,9 @@ def asset_from_df(df: Type[pd.DataFrame],
     # load the asset
     asset = FastTest.new_asset(asset_id, exchange_id, broker_id, warmup)
     asset.load_headers(df.columns.tolist())
-    asset.load_data(values, epoch_index, df.shape[0], df.shape[1], False)
+    if copy:
+        asset.load_data(values, epoch_index, df.shape[0], df.shape[1], False, layout, precision)
+    else:
+        asset.load_view(values, epoch_index)
 
     return asset
\ No newline at end of file
@@ -6,6 +6,7 @@ from test_asset import AssetTestMethods
 from test_exchange import ExchangeTestMethods
 from test_portfolio import PortfolioTestMethods
 from test_hal import HalTestMethods
+from test_runner import RunnerTestMethods
 
 stream = StringIO()
 runner = unittest.TextTestRunner(stream=stream)
@@ -36,4 +37,11 @@ print('Tests run ', result.testsRun)
 print('Errors ', result.errors)
 pprint(result.failures)
 stream.seek(0)
+print('Test output\n', stream.read())
+
+result = runner.run(unittest.makeSuite(RunnerTestMethods))
+print('Tests run ', result.testsRun)
+print('Errors ', result.errors)
+pprint(result.failures)
+stream.seek(0)
 print('Test output\n', stream.read())
\ No newline at end of file
@@ -1,15 +1,19 @@
 
+import gc
+import struct
 import sys
 import os
+import tempfile
 import time
 import unittest
+import numpy as np
 import pandas as pd
 
 sys.path.append(os.path.abspath('..'))
 sys.path.append(os.path.abspath('../lib'))
 
 import FastTest
-from FastTest import AssetTracerType
+from FastTest import AssetTracerType, AssetLayout, AssetPrecision
 from Hal import Hal, asset_from_df
 import helpers
 
@@ -95,6 +99,26 @@ class AssetTestMethods(unittest.TestCase):
         cpp_vol = spy.get_volatility()
         assert(abs(cpp_vol - vol) < 1e-6)
 
+    def test_vol_tracer_goto(self):
+        hal = helpers.create_spy_hal()
+        hydra = hal.get_hydra()
+        spy = hydra.get_asset("SPY")
+        spy.add_tracer(AssetTracerType.VOLATILITY, 252, True)
+        hydra.build()
+
+        df = pd.read_csv(helpers.test_spy_file_path)
+        df["returns"] = df["Close"].pct_change()
+        df["vol"] = df["returns"].rolling(251).var(ddof=0)
+
+        # seek forward then backward, the tracer is rebuilt from the window behind the new row
+        for row in [1000, 400, 1001]:
+            hal.goto_datetime(df["Date"].values[row])
+            hydra.forward_pass()
+            hydra.on_open()
+            assert(spy.get("Close", row) == df["Close"].values[row])
+            assert(abs(spy.get_volatility() - df["vol"].values[row]) < 1e-6)
+            hydra.backward_pass()
+
     def test_beta_tracer(self):
         hal = helpers.create_beta_hal(logging=0)
         hydra = hal.get_hydra()
@@ -143,5 +167,398 @@ class AssetTestMethods(unittest.TestCase):
                 assert(abs(betas[key] - asset_df["BETA"].values[1]) < 1e-4)
             hal.reset()
 
+    def test_indicator_tracers(self):
+        hal = helpers.create_spy_hal()
+        hydra = hal.get_hydra()
+        spy = hydra.get_asset("SPY")
+        length = 20
+        spy.add_tracer(AssetTracerType.SMA, length, True)
+        spy.add_tracer(AssetTracerType.EMA, length)
+        spy.add_tracer(AssetTracerType.ROLLING_MIN, length, column = "Low")
+        spy.add_tracer(AssetTracerType.ROLLING_MAX, length, column = "High")
+        spy.add_tracer(AssetTracerType.ROLLING_ZSCORE, length)
+        spy.add_tracer(AssetTracerType.ATR, length, name = "atr")
+        hydra.build()
+
+        df = pd.read_csv(helpers.test_spy_file_path)
+        close = df["Close"]
+        ema = np.full(len(df), np.nan)
+        ema[length - 1] = close.values[:length].mean()
+        for row in range(length, len(df)):
+            ema[row] = ema[row - 1] + 2 / (length + 1) * (close.values[row] - ema[row - 1])
+        previous_close = close.shift(1)
+        true_range = pd.concat([
+            df["High"] - df["Low"],
+            (df["High"] - previous_close).abs(),
+            (df["Low"] - previous_close).abs()], axis = 1).max(axis = 1)
+        expected = {
+            "sma_20_Close" : close.rolling(length).mean().values,
+            "ema_20_Close" : ema,
+            "min_20_Low" : df["Low"].rolling(length).min().values,
+            "max_20_High" : df["High"].rolling(length).max().values,
+            "zscore_20_Close" : ((close - close.rolling(length).mean()) / close.rolling(length).std(ddof = 1)).values,
+            "atr" : true_range.rolling(length).mean().values
+        }
+        handles = {name : spy.get_feature_handle(name) for name in expected}
+
+        # the tracers are warm at the warmup and read like columns at the current row
+        for row in range(length - 1, length + 50):
+            for name, values in expected.items():
+                assert(abs(spy.get_asset_feature(handles[name]) - values[row]) < 1e-6)
+            assert(abs(spy.get_tracer_value(AssetTracerType.ATR) - expected["atr"][row]) < 1e-6)
+            scaled = spy.get_asset_feature(spy.get_feature_handle("Close", AssetTracerType.SMA))
+            assert(abs(scaled - close.values[row] / expected["sma_20_Close"][row]) < 1e-6)
+            hydra.forward_pass()
+            hydra.on_open()
+            hydra.backward_pass()
+
+    def test_zscore_tracer_precision(self):
+        # a long walk at a high price level with small moves, where the variance from sums of squares
+        # cancels to noise
+        rows = 5000
+        length = 20
+        rng = np.random.default_rng(3)
+        close = 1e5 + np.cumsum(rng.normal(0, 0.01, rows))
+        df = pd.DataFrame({"OPEN" : close, "CLOSE" : close},
+            index = pd.date_range("2000-01-03", periods = rows, freq = "D").astype(np.int64))
+
+        hal = Hal(0)
+        hal.new_exchange("exchange1")
+        hal.new_broker("broker1", 100000.0)
+        asset = asset_from_df(df, "asset1", "exchange1", "broker1")
+        hal.register_asset(asset, "exchange1")
+        asset.add_tracer(AssetTracerType.ROLLING_ZSCORE, length)
+        hal.build()
+        hydra = hal.get_hydra()
+
+        # two pass z-score of each window
+        windows = np.lib.stride_tricks.sliding_window_view(close, length)
+        expected = (close[length - 1:] - windows.mean(axis = 1)) / windows.std(axis = 1, ddof = 1)
+        for row in range(rows):
+            hydra.forward_pass()
+            if row >= length - 1:
+                assert(abs(asset.get_tracer_value(AssetTracerType.ROLLING_ZSCORE) - expected[row - length + 1]) < 1e-6)
+            hydra.on_open()
+            hydra.backward_pass()
+
+    def test_generate_universe(self):
+        assets = FastTest.generate_universe(
+            "exchange1", "broker1", 20, 100,
+            columns = ["open", "high", "low", "close", "volume", "signal"],
+            gap = 0.2,
+            seed = 7
+        )
+        assert(len(assets) == 20)
+        for asset in assets:
+            assert(60 <= asset.get_rows() <= 100)
+            assert(asset.get_cols() == 6)
+            data = asset.get_data_view()
+            assert((data[:,1] >= data[:,[0,3]].max(axis = 1)).all())
+            assert((data[:,2] <= data[:,[0,3]].min(axis = 1)).all())
+
+        # same seed gives the same universe
+        again = FastTest.generate_universe("exchange1", "broker1", 20, 100,
+            columns = ["open", "high", "low", "close", "volume", "signal"], gap = 0.2, seed = 7)
+        assert((assets[3].get_datetime_index_view() == again[3].get_datetime_index_view()).all())
+        assert((assets[3].get_data_view() == again[3].get_data_view()).all())
+
+        hal = Hal(0)
+        hal.new_exchange("exchange1")
+        hal.new_broker("broker1", 100000.0)
+        for asset in assets:
+            hal.register_asset(asset, "exchange1")
+        hal.build()
+        hal.run()
+        assert(hal.get_candles() == sum(asset.get_rows() for asset in assets))
+
+    def test_asset_layout(self):
+        hals = []
+        for layout in [AssetLayout.ROW_MAJOR, AssetLayout.COLUMN_MAJOR]:
+            hal = Hal(0)
+            hal.new_exchange("exchange1")
+            hal.new_broker("broker1", 100000.0)
+            for asset in FastTest.generate_universe("exchange1", "broker1", 5, 50, seed = 3, layout = layout):
+                assert(asset.get_layout() == layout)
+                hal.register_asset(asset, "exchange1")
+            hal.build()
+            hal.run(steps = 20)
+            hals.append(hal)
+
+        for i in range(5):
+            row_asset = hals[0].get_hydra().get_asset(f"ASSET{i}")
+            col_asset = hals[1].get_hydra().get_asset(f"ASSET{i}")
+            assert((row_asset.get_data_view() == col_asset.get_data_view()).all())
+            assert(row_asset.get("close", 7) == col_asset.get("close", 7))
+
+            # column major lookbacks are contiguous views
+            row_close = row_asset.get_column("close", 10)
+            col_close = col_asset.get_column("close", 10)
+            assert(col_close.flags["C_CONTIGUOUS"])
+            assert((row_close == col_close).all())
+
+            # the views keep their asset alive
+            assert(isinstance(row_close.base, FastTest.Asset))
+
+        df = hals[1].asset_to_df(hals[1].get_hydra().get_asset("ASSET0"))
+        assert(df.shape == (50, 2))
+
+    def test_asset_column_keep_alive(self):
+        hal = helpers.create_simple_hal()
+        hal.build()
+        hal.run(steps = 4)
+        column = hal.get_hydra().get_asset(helpers.test2_asset_id).get_column("CLOSE", 2)
+        values = column.copy()
+
+        # the view holds the asset after the hydra that owned it is gone
+        del hal
+        gc.collect()
+        assert((column == values).all())
+
+        # so do the data and datetime views of every layout and precision
+        views = []
+        for layout, precision in [(AssetLayout.ROW_MAJOR, AssetPrecision.FLOAT64),
+                                  (AssetLayout.COLUMN_MAJOR, AssetPrecision.FLOAT64),
+                                  (AssetLayout.COLUMN_MAJOR, AssetPrecision.FLOAT32)]:
+            asset = FastTest.generate_universe("exchange1", "broker1", 1, 50, seed = 4, layout = layout,
+                precision = precision)[0]
+            for view in [asset.get_data_view(), asset.get_datetime_index_view()]:
+                assert(isinstance(view.base, FastTest.Asset))
+                views.append((view, view.copy()))
+        del asset
+        gc.collect()
+        for view, values in views:
+            assert((view == values).all())
+
+    def test_asset_load_view(self):
+        df = helpers.load_df(helpers.test1_file_path, helpers.test1_asset_id)
+        expected = df.values.copy()
+        for order, layout in [("F", AssetLayout.COLUMN_MAJOR), ("C", AssetLayout.ROW_MAJOR)]:
+            values = np.array(df.values, dtype = np.float64, order = order)
+            epoch_index = np.array(df.index.values, dtype = np.int64)
+            asset = FastTest.new_asset("asset1", "exchange1", "broker1", 0)
+            asset.load_headers(df.columns.tolist())
+            asset.load_view(values, epoch_index)
+
+            # the asset reads the array in place and keeps it alive after the last python reference
+            assert(asset.get_data_view().ctypes.data == values.ctypes.data)
+            del values
+            del epoch_index
+            assert(asset.get_layout() == layout)
+            assert((asset.get_data_view() == expected).all())
+            assert(asset.get("CLOSE", 0) == 101)
+            assert(asset.get("OPEN", 3) == 105)
+
+        # the view must be float64
+        asset = FastTest.new_asset("asset1", "exchange1", "broker1", 0)
+        asset.load_headers(df.columns.tolist())
+        self.assertRaises(RuntimeError, asset.load_view, df.values.astype(np.float32), df.index.values)
+
+        # a view takes the layout of the buffer, requesting another one through load_data raises
+        values = np.array(df.values, dtype = np.float64, order = "C")
+        epoch_index = np.array(df.index.values, dtype = np.int64)
+        self.assertRaises(RuntimeError, asset.load_data, values, epoch_index, values.shape[0], values.shape[1],
+            True, AssetLayout.COLUMN_MAJOR)
+        asset.load_data(values, epoch_index, values.shape[0], values.shape[1], True)
+        assert(asset.get_layout() == AssetLayout.ROW_MAJOR)
+        assert(asset.get_data_view().ctypes.data == values.ctypes.data)
+
+        # a zero copy asset from a dataframe runs like a copied one
+        hal = Hal(0)
+        hal.new_exchange("exchange1")
+        hal.new_broker("broker1", 100000.0)
+        hal.register_asset_from_df(df, "asset1", "exchange1", "broker1", 0, copy = False)
+        hal.build()
+        hal.run()
+        assert(hal.get_candles() == df.shape[0])
+
+    def test_asset_precision(self):
+        hals = []
+        for precision in [AssetPrecision.FLOAT64, AssetPrecision.FLOAT32]:
+            hal = Hal(0)
+            hal.new_exchange("exchange1")
+            hal.new_broker("broker1", 100000.0)
+            for asset in FastTest.generate_universe("exchange1", "broker1", 5, 50, seed = 3, precision = precision):
+                assert(asset.get_precision() == precision)
+                hal.register_asset(asset, "exchange1")
+            hal.build()
+            hal.run(steps = 20)
+            hals.append(hal)
+
+        for i in range(5):
+            f64_asset = hals[0].get_hydra().get_asset(f"ASSET{i}")
+            f32_asset = hals[1].get_hydra().get_asset(f"ASSET{i}")
+
+            # views keep the stored type, scalar reads are widened to double
+            assert(f32_asset.get_data_view().dtype == np.float32)
+            assert(f32_asset.get_column("close", 10).dtype == np.float32)
+            assert((f64_asset.get_data_view().astype(np.float32) == f32_asset.get_data_view()).all())
+            assert(f32_asset.get("close", 7) == float(np.float32(f64_asset.get("close", 7))))
+
+        # float32 dataframes load without a float64 copy
+        df = helpers.load_df(helpers.test1_file_path, helpers.test1_asset_id).astype(np.float32)
+        asset = asset_from_df(df, "asset1", "exchange1", "broker1", precision = AssetPrecision.FLOAT32, copy = False)
+        assert(asset.get_precision() == AssetPrecision.FLOAT32)
+        assert(asset.get("CLOSE", 0) == 101)
+
+    def test_asset_binary_file(self):
+        with tempfile.TemporaryDirectory() as directory:
+            assets = FastTest.generate_universe("exchange1", "broker1", 3, 50, gap = 0.2, seed = 5)
+            assets.append(FastTest.generate_universe("exchange1", "broker1", 1, 50, seed = 6,
+                prefix = "COLUMN", layout = AssetLayout.COLUMN_MAJOR)[0])
+            for asset in assets:
+                asset.save_binary(os.path.join(directory, asset.get_asset_id() + ".argus"))
+
+            # a mapped asset reads the same values in the layout it was written with
+            for asset in assets:
+                mapped = FastTest.new_asset(asset.get_asset_id(), "exchange1", "broker1", 0)
+                mapped.load_mmap(os.path.join(directory, asset.get_asset_id() + ".argus"))
+                assert(mapped.get_layout() == asset.get_layout())
+                assert(mapped.get_headers() == asset.get_headers())
+                assert((mapped.get_data_view() == asset.get_data_view()).all())
+                assert((mapped.get_datetime_index_view() == asset.get_datetime_index_view()).all())
+
+            # the directory loader takes the asset ids from the files
+            hal = Hal(0)
+            hal.new_exchange("exchange1")
+            hal.new_broker("broker1", 100000.0)
+            hal.register_asset_directory(directory, "exchange1", "broker1")
+            hal.build()
+            hal.run()
+            assert(hal.get_candles() == sum(asset.get_rows() for asset in assets))
+
+            with open(os.path.join(directory, "bad.argus"), "wb") as file:
+                file.write(b"not an asset file")
+            self.assertRaises(RuntimeError, FastTest.load_asset_directory, directory, "exchange1", "broker1")
+
+    def test_asset_binary_file_invalid(self):
+        asset = FastTest.generate_universe("exchange1", "broker1", 1, 50, seed = 5)[0]
+        with tempfile.TemporaryDirectory() as directory:
+            path = os.path.join(directory, "asset.argus")
+            asset.save_binary(path)
+            with open(path, "rb") as file:
+                contents = file.read()
+
+            def check_invalid(data):
+                bad_path = os.path.join(directory, "bad.argus")
+                with open(bad_path, "wb") as file:
+                    file.write(data)
+                self.assertRaises(RuntimeError, FastTest.load_asset_file, bad_path, "exchange1", "broker1")
+
+            # header fields are uint64 starting at byte 24: rows, cols, row stride, col stride, start
+            # time, end time, datetime offset, data offset, file size
+            def patch(field, value):
+                data = bytearray(contents)
+                struct.pack_into("<Q", data, 24 + 8 * field, value)
+                return bytes(data)
+
+            # truncated files, with and without the recorded size matching
+            check_invalid(contents[:len(contents) - 8])
+            check_invalid(contents[:100])
+            check_invalid(patch(8, len(contents) - 8)[:len(contents) - 8])
+
+            # zero and aliasing strides
+            check_invalid(patch(2, 0))
+            check_invalid(patch(3, 0))
+            check_invalid(patch(2, 1))
+
+            # sizes and offsets that overflow or point past the end of the file
+            check_invalid(patch(0, 2 ** 62))
+            check_invalid(patch(1, 2 ** 62))
+            check_invalid(patch(2, 2 ** 63))
+            check_invalid(patch(6, 2 ** 64 - 64))
+            check_invalid(patch(7, 2 ** 64 - 64))
+            check_invalid(patch(7, len(contents) + 64))
+
+            # the untouched file still loads
+            mapped = FastTest.load_asset_file(path, "exchange1", "broker1")
+            assert((mapped.get_data_view() == asset.get_data_view()).all())
+
+    def test_asset_stream_ema_seek(self):
+        source = FastTest.generate_universe("exchange1", "broker1", 1, 400, seed = 8, prefix = "SOURCE")[0]
+        datetime_index = np.array(source.get_datetime_index_view())
+        close = np.array(source.get_data_view())[:, source.get_headers().index("close")]
+        length = 5
+
+        with tempfile.TemporaryDirectory() as directory:
+            path = os.path.join(directory, "source.argus")
+            source.save_binary(path)
+            stream = FastTest.new_asset("STREAM", "exchange1", "broker1", 0)
+            stream.load_file_stream(path, chunk_rows = 16, lookback = 3)
+
+            hal = Hal(0)
+            hal.new_exchange("exchange1")
+            hal.new_broker("broker1", 100000.0)
+            hal.register_asset(source, "exchange1")
+            hal.register_asset(stream, "exchange1")
+            for asset in [source, stream]:
+                asset.add_tracer(AssetTracerType.EMA, length)
+            hal.build()
+            hydra = hal.get_hydra()
+
+            # seeks forward and backward replay the same rows whether or not the asset is streamed,
+            # the average only differs from one over the full history by the truncated weight
+            alpha = 2 / (length + 1)
+            for row in [300, 120, 250]:
+                hydra.goto_datetime(int(datetime_index[row]))
+                for current in range(row, row + 10):
+                    hydra.forward_pass()
+                    hydra.on_open()
+                    value = stream.get_tracer_value(AssetTracerType.EMA)
+                    assert(value == source.get_tracer_value(AssetTracerType.EMA))
+
+                    expected = close[:length].mean()
+                    for price in close[length:current + 1]:
+                        expected += alpha * (price - expected)
+                    assert(abs(value - expected) < 1e-6)
+                    hydra.backward_pass()
+
+    def test_asset_stream(self):
+        source = FastTest.generate_universe("exchange1", "broker1", 1, 200, seed = 7, prefix = "SOURCE")[0]
+        data = np.array(source.get_data_view())
+        datetime_index = np.array(source.get_datetime_index_view())
+
+        with tempfile.TemporaryDirectory() as directory:
+            path = os.path.join(directory, "source.argus")
+            source.save_binary(path)
+
+            # chunks are produced by a callable so the stream can be rewound
+            python_stream = FastTest.new_asset("PYTHON", "exchange1", "broker1", 0)
+            python_stream.load_headers(source.get_headers())
+            python_stream.load_stream(lambda: (data[i:i + 7] for i in range(0, len(data), 7)),
+                datetime_index, chunk_rows = 16, lookback = 3)
+            file_stream = FastTest.new_asset("FILE", "exchange1", "broker1", 0)
+            file_stream.load_file_stream(path, chunk_rows = 16, lookback = 3)
+
+            hal = Hal(0)
+            hal.new_exchange("exchange1")
+            hal.new_broker("broker1", 100000.0)
+            hal.register_asset(source, "exchange1")
+            hal.register_asset(python_stream, "exchange1")
+            hal.register_asset(file_stream, "exchange1")
+            hal.build()
+            hal.run(steps = 150)
+
+            # only the window is held, the lookback stays readable
+            for asset in [python_stream, file_stream]:
+                assert(asset.is_streaming())
+                assert(asset.get_data_view().shape[0] <= 16 + 5)
+                assert((asset.get_column("close", 3) == source.get_column("close", 3)).all())
+                self.assertRaises(RuntimeError, asset.get, "open", 0)
+
+            # columns and data views of streaming assets are copies that outlive a refill of the window
+            columns = [asset.get_column("close", 3) for asset in [python_stream, file_stream]]
+            columns += [asset.get_data_view() for asset in [python_stream, file_stream]]
+            values = [column.copy() for column in columns]
+            hal.run(steps = 40)
+            for column, value in zip(columns, values):
+                assert(column.base is None)
+                assert((column == value).all())
+
+            # rewinding restarts the stream
+            hal.reset()
+            hal.run(steps = 10)
+            for asset in [python_stream, file_stream]:
+                assert((asset.get_column("open", 3) == source.get_column("open", 3)).all())
+
 if __name__ == '__main__':
     unittest.main()
@@ -11,7 +11,7 @@ sys.path.append(os.path.abspath('..'))
 sys.path.append(os.path.abspath('../lib'))
 
 import FastTest
-from FastTest import ExchangeQueryType
+from FastTest import ExchangeQueryType, CrossSectionTransform, AssetTracerType, AssetPrecision
 import helpers
 
 class ExchangeTestMethods(unittest.TestCase):
@@ -101,6 +101,32 @@ class ExchangeTestMethods(unittest.TestCase):
         exchange_features2 = exchange.get_exchange_feature("CLOSE", -1)
         assert(exchange_features2 == exchange_features)
         
+    def test_exchange_feature_reset(self):
+        hydra = helpers.create_simple_hydra(logging=0)
+        exchange = hydra.get_exchange(helpers.test1_exchange_id)
+        
+        hydra.build()
+        hydra.forward_pass()
+        hydra.backward_pass()
+        hydra.forward_pass()
+        
+        exchange_features = exchange.get_exchange_feature("CLOSE")
+        assert(exchange_features[helpers.test1_asset_id] == 101.0)
+        
+        # after a reset only assets streaming at the first time are in view
+        hydra.reset()
+        hydra.forward_pass()
+        
+        exchange_features = exchange.get_exchange_feature("CLOSE")
+        assert(exchange_features == {helpers.test2_asset_id : 101.5})
+        
+        hydra.backward_pass()
+        hydra.forward_pass()
+        
+        exchange_features = exchange.get_exchange_feature("CLOSE")
+        assert(exchange_features[helpers.test2_asset_id] == 99.0)
+        assert(exchange_features[helpers.test1_asset_id] == 101.0)
+        
     def test_exchange_exchange_feature_sorted(self):
         hydra = helpers.create_simple_hydra(logging=0)
         mp = hydra.get_master_portfolio()
@@ -122,8 +148,161 @@ class ExchangeTestMethods(unittest.TestCase):
         
         exchange_features =  exchange.get_exchange_feature("CLOSE", query_type = ExchangeQueryType.NSMALLEST, N = 1)
         assert(exchange_features == {helpers.test2_asset_id : 99.0})
+
+        # repeated queries within a bar are served from the exchange's cache
+        exchange_features =  exchange.get_exchange_feature("CLOSE", query_type = ExchangeQueryType.NLARGEST, N = 1)
+        assert(exchange_features == {helpers.test1_asset_id : 101.0})
+
+    def test_exchange_exchange_feature_array(self):
+        hydra = helpers.create_simple_hydra(logging=0)
+        exchange = hydra.get_exchange(helpers.test1_exchange_id)
+
+        hydra.build()
+        hydra.forward_pass()
+        hydra.on_open()
+        hydra.backward_pass()
+
+        hydra.forward_pass()
+        hydra.on_open()
+
+        asset_ids = exchange.get_slot_asset_ids()
+        slots, values = exchange.get_exchange_feature_array("CLOSE", query_type = ExchangeQueryType.NSMALLEST, N = 2)
+        assert([asset_ids[slot] for slot in slots] == [helpers.test2_asset_id, helpers.test1_asset_id])
+        assert(np.array_equal(values, np.array([99.0, 101.0])))
+
+        slots, values = exchange.get_exchange_feature_array("CLOSE")
+        assert(dict(zip([asset_ids[slot] for slot in slots], values)) == exchange.get_exchange_feature("CLOSE"))
         
         
+    def test_exchange_cross_section(self):
+        hydra = helpers.create_simple_hydra(logging=0)
+        exchange = hydra.get_exchange(helpers.test1_exchange_id)
+        exchange.set_asset_group(helpers.test1_asset_id, "sector1")
+        exchange.set_asset_group(helpers.test2_asset_id, "sector1")
+
+        hydra.build()
+        hydra.forward_pass()
+        hydra.on_open()
+        hydra.backward_pass()
+
+        hydra.forward_pass()
+        hydra.on_open()
+
+        slots = {asset_id : slot for slot, asset_id in enumerate(exchange.get_slot_asset_ids())}
+        slot1, slot2 = slots[helpers.test1_asset_id], slots[helpers.test2_asset_id]
+
+        rank = exchange.get_cross_section("CLOSE", CrossSectionTransform.RANK)
+        assert(rank[slot1] == 2.0 and rank[slot2] == 1.0)
+
+        percentile = exchange.get_cross_section("CLOSE", CrossSectionTransform.PERCENTILE)
+        assert(percentile[slot1] == 1.0 and percentile[slot2] == 0.5)
+
+        zscore = exchange.get_cross_section("CLOSE", CrossSectionTransform.ZSCORE)
+        assert(np.allclose(zscore[[slot1, slot2]], [1 / np.sqrt(2), -1 / np.sqrt(2)]))
+
+        winsorized = exchange.get_cross_section("CLOSE", CrossSectionTransform.WINSORIZE, lower = 0.25, upper = 0.75)
+        assert(np.allclose(winsorized[[slot1, slot2]], [100.5, 99.5]))
+
+        demeaned = exchange.get_cross_section("CLOSE", CrossSectionTransform.GROUP_DEMEAN)
+        assert(np.allclose(demeaned[[slot1, slot2]], [1.0, -1.0]))
+
+        # results own their values, later transforms do not overwrite them
+        assert(rank[slot1] == 2.0 and rank[slot2] == 1.0)
+        assert(percentile[slot1] == 1.0 and percentile[slot2] == 0.5)
+
+    def test_exchange_trigger_book(self):
+        hydra = helpers.create_simple_hydra(logging=0)
+        portfolio = hydra.new_portfolio("test_portfolio1", 100000.0)
+        exchange = hydra.get_exchange(helpers.test1_exchange_id)
+        broker = hydra.get_broker(helpers.test1_broker_id)
+        hydra.build()
+
+        # asset2 opens at 101 and closes at 101.5, 99, 97, none of the orders cross at the open
+        hydra.forward_pass()
+        eager = FastTest.OrderExecutionType.EAGER
+        portfolio.place_limit_order(helpers.test2_asset_id, 10.0, 99.5, "dummy", eager)
+        portfolio.place_limit_order(helpers.test2_asset_id, 10.0, 98.5, "dummy", eager)
+        portfolio.place_limit_order(helpers.test2_asset_id, 10.0, 90.0, "dummy", eager)
+        with self.assertRaises(RuntimeError):
+            portfolio.place_limit_order(helpers.test2_asset_id, 0.0, 100.0, "dummy", eager)
+        portfolio.place_stop_loss_order(helpers.test2_asset_id, 5.0, 101.25, "dummy", eager)
+        portfolio.place_stop_loss_order(helpers.test2_asset_id, -5.0, 97.5, "dummy", eager)
+        portfolio.place_take_profit_order(helpers.test2_asset_id, 5.0, 100.5, "dummy", eager)
+
+        orders = {(order.get_order_type(), order.get_units(), order.get_limit()) : order for order in broker.get_open_orders()}
+        buy_limit1 = orders[(FastTest.OrderType.LIMIT_ORDER, 10.0, 99.5)]
+        buy_limit2 = orders[(FastTest.OrderType.LIMIT_ORDER, 10.0, 98.5)]
+        canceled = orders[(FastTest.OrderType.LIMIT_ORDER, 10.0, 90.0)]
+        buy_stop = orders[(FastTest.OrderType.STOP_LOSS_ORDER, 5.0, 101.25)]
+        sell_stop = orders[(FastTest.OrderType.STOP_LOSS_ORDER, -5.0, 97.5)]
+        take_profit = orders[(FastTest.OrderType.TAKE_PROFIT_ORDER, 5.0, 100.5)]
+        assert(all(order.get_order_state() == FastTest.OrderState.OPEN for order in orders.values()))
+
+        # orders with zero units are rejected as they could never fill, canceled orders stop resting
+        assert(exchange.get_open_order_count() == 6)
+        broker.cancel_order(canceled.get_order_id())
+        assert(canceled.get_order_state() == FastTest.OrderState.CANCELED)
+        assert(exchange.get_open_order_count() == 5)
+
+        # a buy stop fills once the price rises to its stop
+        hydra.on_open()
+        hydra.backward_pass()
+        assert(buy_stop.get_order_state() == FastTest.OrderState.FILLED)
+        assert(buy_stop.get_average_price() == 101.5)
+        assert(portfolio.get_position(helpers.test2_asset_id).get_units() == 5.0)
+        assert(exchange.get_open_order_count() == 4)
+
+        # a buy take profit fills at the open of 100, the higher buy limit at the close of 99
+        hydra.forward_pass()
+        assert(take_profit.get_order_state() == FastTest.OrderState.FILLED)
+        assert(take_profit.get_average_price() == 100.0)
+        assert(buy_limit1.get_order_state() == FastTest.OrderState.OPEN)
+        hydra.on_open()
+        hydra.backward_pass()
+        assert(buy_limit1.get_order_state() == FastTest.OrderState.FILLED)
+        assert(buy_limit1.get_average_price() == 99.0)
+        assert(buy_limit2.get_order_state() == FastTest.OrderState.OPEN)
+        assert(exchange.get_open_order_count() == 2)
+
+        # the lower buy limit fills at the open of 98, the sell stop at the close of 97
+        hydra.forward_pass()
+        assert(buy_limit2.get_average_price() == 98.0)
+        assert(sell_stop.get_order_state() == FastTest.OrderState.OPEN)
+        hydra.on_open()
+        hydra.backward_pass()
+        assert(sell_stop.get_order_state() == FastTest.OrderState.FILLED)
+        assert(sell_stop.get_average_price() == 97.0)
+        assert(portfolio.get_position(helpers.test2_asset_id).get_units() == 25.0)
+        assert(exchange.get_open_order_count() == 0)
+        assert(canceled.get_order_state() == FastTest.OrderState.CANCELED)
+        assert(len(broker.get_open_orders()) == 0)
+
+    def test_exchange_trigger_book_out_of_view(self):
+        hydra = helpers.create_simple_hydra(logging=0)
+        portfolio = hydra.new_portfolio("test_portfolio1", 100000.0)
+        exchange = hydra.get_exchange(helpers.test1_exchange_id)
+        broker = hydra.get_broker(helpers.test1_broker_id)
+        hydra.build()
+
+        # asset1 has its last row on 2000-06-09, the exchange steps once more on 2000-06-12
+        for _ in range(4):
+            hydra.forward_pass()
+            hydra.on_open()
+            hydra.backward_pass()
+        hydra.forward_pass()
+        portfolio.place_limit_order(helpers.test1_asset_id, 10.0, 50.0, "dummy", FastTest.OrderExecutionType.EAGER)
+        order = broker.get_open_orders()[0]
+        hydra.on_open()
+        hydra.backward_pass()
+        assert(exchange.get_open_order_count() == 1)
+
+        # resting orders of an asset out of view are skipped instead of raising
+        hydra.forward_pass()
+        hydra.on_open()
+        hydra.backward_pass()
+        assert(order.get_order_state() == FastTest.OrderState.OPEN)
+        assert(exchange.get_open_order_count() == 1)
+
     def test_exchange_asset_column(self):
         hydra = helpers.create_simple_hydra(logging=0)
         mp = hydra.get_master_portfolio()
@@ -154,7 +333,226 @@ class ExchangeTestMethods(unittest.TestCase):
         
         col1 = asset2.get_column("CLOSE", 3)
         assert(np.array_equal(np.array([101.5, 99,97]), col1))
-    
-    
+
+    def test_exchange_feature_handle(self):
+        hydra = helpers.create_simple_hydra(logging=0)
+        exchange = hydra.get_exchange(helpers.test1_exchange_id)
+        asset2 = exchange.get_asset(helpers.test2_asset_id)
+
+        handle = exchange.get_feature_handle("CLOSE")
+        assert(handle.column == "CLOSE")
+        assert(handle.column_index == asset2.get_feature_handle("CLOSE").column_index)
+        with self.assertRaises(RuntimeError):
+            exchange.get_feature_handle("NOT_A_COLUMN")
+
+        # a handle to a tracer only asset1 has is past the end of asset2's features
+        asset1 = exchange.get_asset(helpers.test1_asset_id)
+        asset1.add_tracer(AssetTracerType.SMA, 2, name = "fast")
+        tracer_handle = asset1.get_feature_handle("fast")
+
+        hydra.build()
+        hydra.forward_pass()
+        hydra.on_open()
+        hydra.backward_pass()
+        hydra.forward_pass()
+
+        assert(exchange.get_exchange_feature(handle) == exchange.get_exchange_feature("CLOSE"))
+        assert(exchange.get_exchange_feature(handle, query_type = ExchangeQueryType.NSMALLEST, N = 1) == {helpers.test2_asset_id : 99.0})
+        assert(exchange.get_asset_feature(helpers.test2_asset_id, handle) == 99.0)
+        assert(asset2.get_asset_feature(handle, -1) == 101.5)
+        assert(asset2.get(handle, 0) == asset2.get("CLOSE", 0))
+        with self.assertRaises(RuntimeError):
+            asset2.get_asset_feature(tracer_handle)
+
+    def test_exchange_panel(self):
+        hydra = helpers.create_simple_hydra(logging=0)
+        exchange = hydra.get_exchange(helpers.test1_exchange_id)
+        exchange.enable_panel(["OPEN", "CLOSE"])
+        hydra.build()
+
+        # slots are sorted by asset id, asset1 starts one bar after the exchange
+        asset_ids = exchange.get_panel_asset_ids()
+        assert(asset_ids == sorted([helpers.test1_asset_id, helpers.test2_asset_id]))
+        slot1 = asset_ids.index(helpers.test1_asset_id)
+        slot2 = asset_ids.index(helpers.test2_asset_id)
+
+        close = exchange.get_panel("CLOSE")
+        valid = exchange.get_panel_valid()
+        assert(close.shape == (exchange.get_datetime_index_view().size, 2))
+        assert(close.shape == valid.shape)
+        assert(not valid[0, slot1] and np.isnan(close[0, slot1]))
+        assert(valid[0, slot2] and close[0, slot2] == 101.5)
+
+        hydra.forward_pass()
+        row = exchange.get_panel_row("CLOSE")
+        assert(row[slot2] == 101.5)
+        assert(exchange.get_exchange_feature("CLOSE") == {helpers.test2_asset_id : 101.5})
+        hydra.backward_pass()
+
+        hydra.forward_pass()
+        assert(np.array_equal(exchange.get_panel_row("CLOSE", -1), close[0], equal_nan=True))
+        assert(exchange.get_exchange_feature("CLOSE") == {helpers.test1_asset_id : 101.0, helpers.test2_asset_id : 99.0})
+        assert(exchange.get_exchange_feature("CLOSE", query_type = ExchangeQueryType.NLARGEST, N = 1) == {helpers.test1_asset_id : 101.0})
+
+        with self.assertRaises(RuntimeError):
+            exchange.get_panel("HIGH")
+
+        # a rebuild of the same shape refills the panel in place, one that changes the shape leaves
+        # views taken before it on the previous values
+        before = close.copy()
+        hydra.build()
+        assert(exchange.get_panel("CLOSE").ctypes.data == close.ctypes.data)
+        assert(np.array_equal(close, before, equal_nan=True))
+        exchange.enable_panel(["CLOSE"])
+        hydra.build()
+        assert(exchange.get_panel("CLOSE").ctypes.data != close.ctypes.data)
+        assert(np.array_equal(exchange.get_panel("CLOSE"), before, equal_nan=True))
+        assert(np.array_equal(close, before, equal_nan=True))
+        hydra.forward_pass()
+        hydra.backward_pass()
+        hydra.forward_pass()
+
+        # panel views outlive their exchange
+        row = exchange.get_panel_row("CLOSE")
+        values = row.copy()
+        del exchange, hydra
+        gc.collect()
+        assert(np.array_equal(row, values, equal_nan=True))
+        assert(np.array_equal(close[1], values, equal_nan=True))
+
+    def test_exchange_volatility_bank(self):
+        length = 252
+
+        # volatility added through the exchange is kept in its bank, through the asset by the asset
+        banked_hal = helpers.create_beta_hal(logging=0)
+        banked_exchange = banked_hal.get_hydra().get_exchange(helpers.test1_exchange_id)
+        banked_exchange.add_tracer(AssetTracerType.VOLATILITY, length, True)
+        banked_hal.build()
+
+        hal = helpers.create_beta_hal(logging=0)
+        exchange = hal.get_hydra().get_exchange(helpers.test1_exchange_id)
+        for asset in exchange.get_market().values():
+            asset.add_tracer(AssetTracerType.VOLATILITY, length, True)
+        hal.build()
+
+        with self.assertRaises(RuntimeError):
+            banked_exchange.add_tracer(AssetTracerType.VOLATILITY, length + 1, True)
+
+        banked_market = banked_exchange.get_market()
+        market = exchange.get_market()
+        for i in range(300):
+            for asset_id, asset in market.items():
+                banked_asset = banked_market[asset_id]
+                assert(banked_asset.get_volatility() == asset.get_volatility())
+            for h in [banked_hal, hal]:
+                h.get_hydra().forward_pass()
+                h.get_hydra().on_open()
+                h.get_hydra().backward_pass()
+
+    def test_exchange_parallel_step(self):
+        # enough assets stream at once that the threaded exchange steps them in parallel (at least
+        # ARGUS_PARALLEL_STEP_MIN), assets list late and delist early so the view and expirations change
+        hydras = []
+        for threads in [1, 4]:
+            hydra = FastTest.Hydra(0, 0.0)
+            hydra.new_broker("broker1", 100000.0)
+            exchange = hydra.new_exchange("exchange1")
+            hydra.set_threads(threads)
+            assets = FastTest.generate_universe("exchange1", "broker1", 400, 60, gap = 0.1, seed = 11)
+            assets += FastTest.generate_universe("exchange1", "broker1", 20, 30, seed = 12, prefix = "SHORT")
+            for asset in assets:
+                hydra.register_asset(asset, "exchange1")
+
+            # a float32 index widens its close column once, beta tracers built in parallel share it
+            index = FastTest.generate_universe("exchange1", "broker1", 1, 60, seed = 13, prefix = "INDEX",
+                precision = AssetPrecision.FLOAT32)[0]
+            hydra.register_index_asset(index, "exchange1")
+            exchange.add_tracer(AssetTracerType.VOLATILITY, 10)
+            exchange.add_tracer(AssetTracerType.SMA, 5)
+            exchange.add_tracer(AssetTracerType.BETA, 10)
+            hydra.build()
+            hydras.append((hydra, exchange, dict(exchange.get_market())))
+        assert(hydras[1][0].get_threads() == 4)
+
+        (serial, serial_exchange, serial_assets), (threaded, threaded_exchange, threaded_assets) = hydras
+        for _ in range(serial.get_datetime_index_view().size):
+            for hydra, _, _ in hydras:
+                hydra.forward_pass()
+            assert(serial_exchange.get_exchange_feature("close") == threaded_exchange.get_exchange_feature("close"))
+            for asset_id, asset in serial_assets.items():
+                threaded_asset = threaded_assets[asset_id]
+                assert(np.array_equal(
+                    [asset.get_volatility(), asset.get_tracer_value(AssetTracerType.SMA), asset.get_beta()],
+                    [threaded_asset.get_volatility(), threaded_asset.get_tracer_value(AssetTracerType.SMA),
+                        threaded_asset.get_beta()],
+                    equal_nan=True))
+            for hydra, _, _ in hydras:
+                hydra.on_open()
+                hydra.backward_pass()
+
+        # assets expire in the same order whether or not they stepped in parallel
+        expired = serial_exchange.get_expired_asset_ids()
+        assert(len(expired) == len(serial_assets))
+        assert(expired == threaded_exchange.get_expired_asset_ids())
+
+    def test_exchange_lazy_tracers(self):
+        length = 252
+        hals = []
+        for lazy in [False, True]:
+            hal = helpers.create_beta_hal(logging=0)
+            exchange = hal.get_hydra().get_exchange(helpers.test1_exchange_id)
+            exchange.add_tracer(AssetTracerType.VOLATILITY, length, True)
+            exchange.add_tracer(AssetTracerType.BETA, length, True)
+            exchange.add_tracer(AssetTracerType.SMA, 20, True)
+            exchange.set_lazy_tracers(lazy)
+            hal.build()
+            hals.append((hal, exchange.get_market()))
+
+        # lazy tracers are only read every few bars and must catch up to the eager values
+        (eager_hal, eager_market), (lazy_hal, lazy_market) = hals
+        for i in range(300):
+            if i % 7 == 0:
+                for asset_id, asset in eager_market.items():
+                    lazy_asset = lazy_market[asset_id]
+                    assert(lazy_asset.get_volatility() == asset.get_volatility())
+                    assert(lazy_asset.get_beta() == asset.get_beta())
+                    assert(lazy_asset.get_tracer_value(AssetTracerType.SMA) == asset.get_tracer_value(AssetTracerType.SMA))
+                    handle = asset.get_feature_handle("Close", AssetTracerType.VOLATILITY)
+                    assert(lazy_asset.get_asset_feature(handle) == asset.get_asset_feature(handle))
+            if i == 200:
+                lazy_hal.get_hydra().get_exchange(helpers.test1_exchange_id).set_lazy_tracers(False)
+            for hal, _ in hals:
+                hal.get_hydra().forward_pass()
+                hal.get_hydra().on_open()
+                hal.get_hydra().backward_pass()
+
+        # assets that expired while lazy go back to eager with the exchange, asset1 expires a bar
+        # before asset2 on the simple hydra
+        hydras = []
+        for lazy in [False, True]:
+            hydra = helpers.create_simple_hydra(logging=0)
+            exchange = hydra.get_exchange(helpers.test1_exchange_id)
+            exchange.add_tracer(AssetTracerType.SMA, 2)
+            exchange.set_lazy_tracers(lazy)
+            hydra.build()
+            hydras.append((hydra, exchange.get_asset(helpers.test1_asset_id)))
+        (eager_hydra, eager_asset), (lazy_hydra, lazy_asset) = hydras
+        for _ in range(5):
+            for hydra, _ in hydras:
+                hydra.forward_pass()
+                hydra.on_open()
+                hydra.backward_pass()
+        assert(helpers.test1_asset_id not in lazy_hydra.get_exchange(helpers.test1_exchange_id).get_market())
+        assert(lazy_asset.get_lazy_tracers())
+        lazy_hydra.get_exchange(helpers.test1_exchange_id).set_lazy_tracers(False)
+        assert(not lazy_asset.get_lazy_tracers())
+        assert(lazy_asset.get_tracer_value(AssetTracerType.SMA) == eager_asset.get_tracer_value(AssetTracerType.SMA))
+
+        # the asset stays eager once it is brought back into the market
+        for hydra, _ in hydras:
+            hydra.reset()
+        assert(not lazy_asset.get_lazy_tracers())
+
+
 if __name__ == '__main__':
     unittest.main()
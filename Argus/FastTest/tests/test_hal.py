@@ -1,10 +1,12 @@
 import sys
 import os
+import tempfile
 import time
 import unittest
 import cProfile
 
 import numpy as np
+import pandas as pd
 os.add_dll_directory("C:\\msys64\\mingw64\\bin")
 sys.path.append(os.path.abspath('..'))
 sys.path.append(os.path.abspath('../lib'))
@@ -12,7 +14,7 @@ sys.path.append(os.path.abspath('../lib'))
 import FastTest
 from Hal import Hal
 from FastTest import Portfolio, Exchange, Broker
-from FastTest import OrderExecutionType, OrderTargetType, PortfolioTracerType
+from FastTest import OrderExecutionType, OrderTargetType, PortfolioTracerType, AssetTracerType
 
 import helpers
 
@@ -79,6 +81,109 @@ class HalTestMethods(unittest.TestCase):
         hal.run()
         assert(True)
 
+    def test_hal_register_assets_from_dfs(self):
+        hal = Hal(logging=0)
+        hal.new_exchange(helpers.test1_exchange_id)
+        hal.new_broker(helpers.test1_broker_id, 100000.0)
+        hal.set_threads(2)
+        dfs = {
+            helpers.test1_asset_id : helpers.load_df(helpers.test1_file_path, helpers.test1_asset_id),
+            helpers.test2_asset_id : helpers.load_df(helpers.test2_file_path, helpers.test2_asset_id)
+        }
+        assets = hal.register_assets_from_dfs(dfs, helpers.test1_exchange_id, helpers.test1_broker_id)
+        hal.build()
+
+        for asset, (asset_id, df) in zip(assets, dfs.items()):
+            assert(asset.get_asset_id() == asset_id)
+            assert(np.array_equal(np.array(asset.get_data_view()), df.values))
+            assert(np.array_equal(asset.get_datetime_index_view(), df.index.values))
+
+        # an unknown exchange fails before any asset is loaded or registered
+        with self.assertRaises(RuntimeError):
+            hal.register_assets_from_dfs({"asset_id3" : dfs[helpers.test1_asset_id]}, "missing_exchange", helpers.test1_broker_id)
+        assert(hal.get_hydra().get_asset("asset_id3") is None)
+
+    def test_hal_profile(self):
+        hal = helpers.create_simple_hal(logging=0)
+        strategy = SimpleStrategy(hal)
+        hal.register_strategy(strategy,"test")
+        hal.build()
+        hal.run()
+
+        profile = hal.get_hydra().get_profile()
+        steps = len(hal.get_hydra().get_datetime_index_view())
+
+        for phase in ["forward_pass", "on_open", "backward_pass", "strategy_on_open", "strategy_on_close"]:
+            counter = profile["phases"][phase]
+            assert(counter["calls"] == steps)
+            assert(counter["histogram"].sum() == steps)
+            assert(counter["total_ns"] >= counter["max_ns"])
+
+        assert(profile["strategies"]["test"]["on_close"]["calls"] == steps)
+        assert(len(profile["bucket_edges_ns"]) == len(profile["phases"]["forward_pass"]["histogram"]))
+
+        df = hal.get_profile()
+        assert(df.loc["test.on_close", "calls"] == steps)
+
+        # the clock calibration survives a reset, it is not restarted over an empty interval
+        edges = profile["bucket_edges_ns"]
+        hal.reset()
+        profile = hal.get_hydra().get_profile()
+        assert(profile["phases"]["forward_pass"]["calls"] == 0)
+        assert(np.allclose(profile["bucket_edges_ns"], edges, rtol=0.1))
+
+    def test_hal_alloc_strict(self):
+        hal = helpers.create_simple_hal(logging=0)
+        if not hal.get_hydra().get_alloc_profile()["enabled"]:
+            self.skipTest("FastTest was built without ARGUS_ALLOC_TRACKING")
+
+        hal.build()
+        hal.get_hydra().set_alloc_strict(True)
+        hal.run()
+
+        profile = hal.get_hydra().get_alloc_profile()
+        steps = len(hal.get_hydra().get_datetime_index_view())
+        assert(len(profile["step_allocations"]) == steps)
+        assert(profile["phases"]["forward_pass"]["violations"] == 0)
+        assert(profile["phases"]["backward_pass"]["violations"] == 0)
+        assert(profile["violations"] == 0)
+
+    def test_hal_alloc_strict_threads(self):
+        if not FastTest.Hydra(0, 0.0).get_alloc_profile()["enabled"]:
+            self.skipTest("FastTest was built without ARGUS_ALLOC_TRACKING")
+
+        source = FastTest.generate_universe("exchange1", "broker1", 1, 60, seed = 3)[0]
+        with tempfile.TemporaryDirectory() as directory:
+            path = os.path.join(directory, "source.argus")
+            source.save_binary(path)
+
+            # the tracer retains more rows than the streams first loaded, so every asset grows its
+            # window on the first refill. Enough assets stream for the threaded exchange to step
+            # them on the pool, the allocations are made by whichever thread steps the asset
+            profiles = []
+            for threads in [1, 4]:
+                hydra = FastTest.Hydra(0, 0.0)
+                hydra.new_broker("broker1", 100000.0)
+                exchange = hydra.new_exchange("exchange1")
+                hydra.set_threads(threads)
+                for i in range(300):
+                    asset = FastTest.new_asset(f"STREAM{i}", "exchange1", "broker1", 0)
+                    asset.load_file_stream(path, chunk_rows = 16, lookback = 3)
+                    hydra.register_asset(asset, "exchange1")
+                exchange.add_tracer(AssetTracerType.SMA, 20, False)
+                hydra.build()
+                hydra.reset_alloc_profile()
+                hydra.set_alloc_strict(True, 0)
+                hydra.run()
+                profiles.append(hydra.get_alloc_profile())
+
+        # allocations on the workers count against the step that handed them out
+        serial, threaded = profiles
+        assert(serial["violations"] >= 300)
+        assert(threaded["violations"] == serial["violations"])
+        assert(threaded["phases"]["forward_pass"]["allocations"] == serial["phases"]["forward_pass"]["allocations"])
+        assert(threaded["total"]["allocations"] == serial["total"]["allocations"])
+
     def test_hal_register_strategy(self):
         hal = helpers.create_simple_hal(logging=0)
 
@@ -312,6 +417,54 @@ class HalTestMethods(unittest.TestCase):
         nlv_history = mp.get_tracer(PortfolioTracerType.VALUE).get_nlv_history()
         assert(np.array_equal(nlv_history,np.array([100050,  99800,  99600, 100050, 100000, 100000.0])))
     
+    def test_hal_disjoint_exchanges(self):
+        # the exchanges never print at the same time, asset1 expires before the last hydra time
+        dates1 = ["2000-01-03", "2000-01-05", "2000-01-07"]
+        dates2 = ["2000-01-04", "2000-01-06", "2000-01-08", "2000-01-10"]
+        closes1 = [10.0, 11.0, 12.0]
+        closes2 = [20.0, 21.0, 22.0, 23.0]
+        hal = Hal(0)
+        hal.new_broker(helpers.test1_broker_id, 100000.0)
+        for exchange_id in ["exchange1", "exchange2"]:
+            hal.new_exchange(exchange_id)
+        for asset_id, exchange_id, dates, closes in [
+                ("asset1", "exchange1", dates1, closes1),
+                ("asset2", "exchange2", dates2, closes2)]:
+            df = pd.DataFrame({"OPEN" : closes, "CLOSE" : closes}, index = pd.to_datetime(dates).astype(np.int64))
+            hal.register_asset_from_df(df, asset_id, exchange_id, helpers.test1_broker_id, warmup = 0)
+        portfolio = hal.new_portfolio("test_portfolio1", 100000.0)
+        hal.build()
+
+        hydra = hal.get_hydra()
+        exchange1 = hal.get_exchange("exchange1")
+        exchange2 = hal.get_exchange("exchange2")
+        asset1 = hydra.get_asset("asset1")
+        asset2 = hydra.get_asset("asset2")
+        handle = asset1.get_feature_handle("CLOSE")
+        dates = sorted(dates1 + dates2)
+        assert(hydra.get_datetime_index_view().size == len(dates))
+
+        # an idle exchange is not stepped, its assets stay on their last row
+        for row, date in enumerate(dates):
+            hydra.forward_pass()
+            if row == 0:
+                portfolio.place_market_order("asset1", 10.0, "dummy", OrderExecutionType.EAGER)
+            if date <= dates1[-1]:
+                assert(asset1.get_asset_feature(handle) == closes1[sum(d <= date for d in dates1) - 1])
+            if date >= dates2[0]:
+                assert(asset2.get_asset_feature(handle) == closes2[sum(d <= date for d in dates2) - 1])
+            hydra.on_open()
+            hydra.backward_pass()
+
+            # asset1 expires on its exchange's last time and its position is closed there
+            if date == dates1[-1]:
+                assert("asset1" not in exchange1.get_market())
+                assert(exchange1.get_expired_asset_ids() == ["asset1"])
+                assert(portfolio.get_position("asset1") is None)
+            elif date < dates1[-1]:
+                assert(portfolio.get_position("asset1").get_units() == 10.0)
+        assert(exchange2.get_expired_asset_ids() == ["asset2"])
+
     def test_hal_big(self):
         hal = helpers.create_big_hal(logging = 0, cash = 100000.0)
         exchange = hal.get_exchange(helpers.test1_exchange_id)
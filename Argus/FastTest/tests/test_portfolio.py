@@ -38,6 +38,11 @@ class PortfolioTestMethods(unittest.TestCase):
         
         assert(portfolio3.get_mem_address() == portfolio3_search_mp.get_mem_address() == portfolio3_search_1.get_mem_address())
 
+        # sibling portfolios are both reachable, missing ids are not found
+        portfolio2_search = mp.find_portfolio("test_portfolio2");
+        assert(portfolio2.get_mem_address() == portfolio2_search.get_mem_address())
+        assert(mp.find_portfolio("missing_portfolio") is None)
+
     def test_portfolio_order_prop(self):
         hydra = helpers.create_simple_hydra(logging=0)
         mp = hydra.get_master_portfolio()
@@ -79,6 +84,41 @@ class PortfolioTestMethods(unittest.TestCase):
         #assert(trade1.get_mem_address() == trade_mp.get_mem_address())
         #assert(trade1.get_units() == 100.0)
         #assert(trade1.get_average_price() == 101.0)
+    def test_portfolio_symbol_routing(self):
+        # each asset routes its orders to its own exchange and broker by symbol
+        asset1 = helpers.load_asset(helpers.test1_file_path, helpers.test1_asset_id, "exchange_id2", "broker_id2")
+        asset2 = helpers.load_asset(helpers.test2_file_path, helpers.test2_asset_id, helpers.test1_exchange_id, helpers.test1_broker_id)
+        asset3 = helpers.load_asset(helpers.test2_file_path, "asset_id3", helpers.test1_exchange_id, "missing_broker")
+
+        hydra = FastTest.Hydra(0, 0.0)
+        hydra.new_broker(helpers.test1_broker_id, 100000.0)
+        hydra.new_broker("broker_id2", 100000.0)
+        hydra.new_exchange(helpers.test1_exchange_id)
+        hydra.new_exchange("exchange_id2")
+        hydra.register_asset(asset1, "exchange_id2")
+        hydra.register_asset(asset2, helpers.test1_exchange_id)
+        hydra.register_asset(asset3, helpers.test1_exchange_id)
+        portfolio = hydra.new_portfolio("test_portfolio1", 100000.0)
+        hydra.build()
+
+        # only the first exchange has a row at the first time
+        hydra.forward_pass()
+        portfolio.place_market_order(helpers.test2_asset_id, 100.0, "dummy", FastTest.OrderExecutionType.EAGER, -1)
+        assert(portfolio.get_position(helpers.test2_asset_id).get_average_price() == 101.0)
+
+        # an asset whose broker was never added raises instead of routing to nothing
+        with self.assertRaises(RuntimeError):
+            portfolio.place_market_order("asset_id3", 100.0, "dummy", FastTest.OrderExecutionType.EAGER, -1)
+        assert(portfolio.get_position("asset_id3") is None)
+        hydra.on_open()
+        hydra.backward_pass()
+
+        hydra.forward_pass()
+        portfolio.place_market_order(helpers.test1_asset_id, 10.0, "dummy", FastTest.OrderExecutionType.EAGER, -1)
+        position = portfolio.get_position(helpers.test1_asset_id)
+        assert(position.get_units() == 10.0)
+        assert(position.get_average_price() == 100.0)
+
     def test_portfolio_order_increase(self):
         hydra = helpers.create_simple_hydra(logging=0)
         mp = hydra.get_master_portfolio()
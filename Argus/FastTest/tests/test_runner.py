@@ -0,0 +1,108 @@
+import sys
+import os
+import tempfile
+import unittest
+
+import numpy as np
+import pandas as pd
+
+sys.path.append(os.path.abspath('..'))
+sys.path.append(os.path.abspath('../lib'))
+
+import FastTest
+import helpers
+
+class RunnerTestMethods(unittest.TestCase):
+    def test_run_description_parse(self):
+        description = FastTest.RunDescription.parse(
+            "# comment line\n"
+            "[Hydra]\n"
+            "Logging = 0 ; trailing comment\n"
+            "\n"
+            "[exchange exchange1]\n"
+            "tracers = sma:20, volatility:10\n"
+            "lazy_tracers = yes\n"
+            "threads = 4\n",
+            "base")
+
+        # section types and keys are lower cased, ids are kept as written
+        sections = description.sections
+        assert([(section.type, section.id, section.line) for section in sections] == [("hydra", "", 2), ("exchange", "exchange1", 5)])
+        assert(sections[0].values == {"logging" : "0"})
+        exchange = sections[1]
+        assert(exchange.get_list("tracers") == ["sma:20", "volatility:10"])
+        assert(exchange.get_bool("lazy_tracers", False))
+        assert(exchange.get_size("threads", 1) == 4)
+        assert(exchange.get_size("missing", 7) == 7)
+        assert(description.resolve_path("data.csv") == os.path.join("base", "data.csv"))
+
+        # malformed values name their key and section
+        bad = FastTest.RunDescription.parse("[broker broker1]\ncash = lots\nthreads = -1\n").sections[0]
+        with self.assertRaisesRegex(RuntimeError, r"\[broker broker1\].*cash"):
+            bad.get_double("cash", 0.0)
+        with self.assertRaisesRegex(RuntimeError, r"\[broker broker1\].*threads"):
+            bad.get_size("threads", 1)
+
+        for text in ["[hydra\n", "key = value\n", "[hydra]\nno value\n"]:
+            with self.assertRaises(RuntimeError):
+                FastTest.RunDescription.parse(text)
+
+    def test_string_to_nanosecond_epoch_time(self):
+        assert(FastTest.string_to_nanosecond_epoch_time("2000-06-06") == pd.Timestamp("2000-06-06").value)
+        assert(FastTest.string_to_nanosecond_epoch_time(" 2000-06-06 09:30:15 ") == pd.Timestamp("2000-06-06 09:30:15").value)
+        assert(FastTest.string_to_nanosecond_epoch_time("960249600000000000") == 960249600000000000)
+        for datetime in ["", "not a date", "2000-13-01", "96024960000000000x"]:
+            with self.assertRaises(RuntimeError):
+                FastTest.string_to_nanosecond_epoch_time(datetime)
+
+    def test_load_asset_csv(self):
+        df = helpers.load_df(helpers.test1_file_path, helpers.test1_asset_id)
+        asset = FastTest.load_asset_csv(helpers.test1_file_path, helpers.test1_asset_id,
+            helpers.test1_exchange_id, helpers.test1_broker_id)
+        assert(asset.get_headers() == ["OPEN", "CLOSE"])
+        assert(np.array_equal(np.array(asset.get_data_view()), df.values))
+        assert(np.array_equal(asset.get_datetime_index_view(), df.index.values))
+
+        with tempfile.TemporaryDirectory() as directory:
+            # empty fields load as nan
+            path = os.path.join(directory, "gaps.csv")
+            with open(path, "w") as file:
+                file.write("DATE,OPEN,CLOSE\n2000-06-06,100,\n2000-06-07,,103\n")
+            asset = FastTest.load_asset_csv(path, "gaps", "exchange1", "broker1")
+            data = np.array(asset.get_data_view())
+            assert(np.isnan(data[0, 1]) and np.isnan(data[1, 0]))
+            assert(data[0, 0] == 100 and data[1, 1] == 103)
+
+            for name, text in [
+                    ("columns.csv", "DATE,OPEN,CLOSE\n2000-06-06,100\n"),
+                    ("value.csv", "DATE,OPEN,CLOSE\n2000-06-06,100,abc\n"),
+                    ("datetime.csv", "DATE,OPEN,CLOSE\nyesterday,100,101\n"),
+                    ("empty.csv", "DATE,OPEN,CLOSE\n")]:
+                path = os.path.join(directory, name)
+                with open(path, "w") as file:
+                    file.write(text)
+                with self.assertRaises(RuntimeError):
+                    FastTest.load_asset_csv(path, "bad", "exchange1", "broker1")
+
+    def test_runner(self):
+        # the example description runs end to end
+        path = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "examples", "equal_weight.run")
+        runner = FastTest.Runner(FastTest.RunDescription.parse_file(path))
+        runner.build()
+        runner.run()
+        assert(runner.get_hydra().get_candles() == 10)
+
+        # a tracer lookback that is not a number names the section it was found in
+        description = FastTest.RunDescription.parse(
+            "[exchange exchange1]\n"
+            "tracers = sma:abc\n"
+            "[broker broker1]\n"
+            "[asset test1]\n"
+            f"path = {os.path.abspath(helpers.test1_file_path)}\n"
+            "exchange = exchange1\n"
+            "broker = broker1\n")
+        with self.assertRaisesRegex(RuntimeError, r"\[exchange exchange1\].*tracers.*sma:abc"):
+            FastTest.Runner(description).build()
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,159 @@
+#ifndef ARGUS_BENCH_H
+#define ARGUS_BENCH_H
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+#include <fmt/core.h>
+
+#include "asset.h"
+#include "generator.h"
+#include "hydra.h"
+
+using namespace std;
+
+namespace ArgusBench {
+
+/// default epoch time of the first synthetic row (2000-01-01)
+static long long constexpr BENCH_START_TIME = 946684800000000000LL;
+
+/// spacing between synthetic rows (one day in ns)
+static long long constexpr BENCH_ROW_SPACING = 86400000000000LL;
+
+struct BenchConfig
+{
+    size_t assets = 500;        ///< number of assets in the synthetic universe
+    size_t rows = 2520;         ///< number of rows in each synthetic asset
+    size_t iterations = 10;     ///< number of timed iterations per benchmark
+    string filter = "";         ///< only run benchmarks whose name contains the filter
+};
+
+struct BenchResult
+{
+    string name;                ///< name of the benchmark
+    size_t iterations;          ///< number of timed iterations
+    double total_ns;            ///< total time spent in the timed region
+    double items;               ///< number of items processed per iteration (candles, orders, ...)
+};
+
+/**
+ * @brief keep a value observable so the compiler cannot drop or hoist the work that produced it,
+ *  unlike a store to a volatile local this does not force a narrowing copy or a branch in the timed code
+ *
+ * @tparam T        type of the value
+ * @param value     value to keep alive
+ */
+template <typename T>
+inline void do_not_optimize(T const& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static_cast<void>(*reinterpret_cast<const volatile char*>(&value));
+#endif
+}
+
+/**
+ * @brief time a function over a number of iterations, an untimed setup function is called before
+ *  each iteration and one untimed warmup iteration is run before timing begins
+ *
+ * @param name          name of the benchmark
+ * @param iterations    number of timed iterations
+ * @param items         number of items processed per iteration, used to report items per second
+ * @param setup         untimed function called before each iteration
+ * @param func          function to time
+ * @return BenchResult  timing results
+ */
+inline BenchResult run_bench(
+    const string& name,
+    size_t iterations,
+    double items,
+    const std::function<void()>& setup,
+    const std::function<void()>& func)
+{
+    setup();
+    func();
+
+    double total_ns = 0;
+    for(size_t i = 0; i < iterations; i++)
+    {
+        setup();
+        auto t0 = std::chrono::steady_clock::now();
+        func();
+        auto t1 = std::chrono::steady_clock::now();
+        total_ns += std::chrono::duration<double, std::nano>(t1 - t0).count();
+    }
+    return BenchResult{name, iterations, total_ns, items};
+}
+
+/// run a benchmark that needs no setup
+inline BenchResult run_bench(
+    const string& name,
+    size_t iterations,
+    double items,
+    const std::function<void()>& func)
+{
+    return run_bench(name, iterations, items, [](){}, func);
+}
+
+/// print the header of the benchmark result table
+inline void print_header()
+{
+    fmt::print("{:<44} {:>8} {:>16} {:>16} {:>18}\n", "benchmark", "iters", "ns/iter", "ns/item", "items/sec");
+}
+
+/// print a single benchmark result
+inline void print_result(const BenchResult& result)
+{
+    double ns_per_iter = result.total_ns / result.iterations;
+    double ns_per_item = ns_per_iter / result.items;
+    fmt::print("{:<44} {:>8} {:>16.1f} {:>16.3f} {:>18.1f}\n",
+        result.name,
+        result.iterations,
+        ns_per_iter,
+        ns_per_item,
+        1e9 / ns_per_item);
+}
+
+/**
+ * @brief build a hydra with a single exchange and broker holding a synthetic universe
+ *
+ * @param assets    number of assets to register
+ * @param rows      number of rows in each asset
+ * @param aligned   if false each asset lists and delists at a random point in the first and last quarter of the universe
+ * @param cash      starting cash of the hydra and broker
+ * @param layout    memory layout of the assets' data
+ * @return shared_ptr<Hydra> built hydra
+ */
+inline shared_ptr<Hydra> synthetic_hydra(
+    size_t assets,
+    size_t rows,
+    bool aligned,
+    double cash = 1e9,
+    AssetLayout layout = AssetLayout::RowMajor)
+{
+    auto hydra = make_shared<Hydra>(0, cash);
+    hydra->new_exchange("exchange1");
+    hydra->new_broker("broker1", cash);
+
+    UniverseConfig universe;
+    universe.assets = assets;
+    universe.rows = rows;
+    universe.gap = aligned ? 0.0 : 0.25;
+    universe.seed = 42;
+    universe.start_time = BENCH_START_TIME;
+    universe.spacing = BENCH_ROW_SPACING;
+    universe.layout = layout;
+    for(auto& asset : generate_universe("exchange1", "broker1", universe))
+    {
+        hydra->register_asset(asset, "exchange1");
+    }
+    hydra->build();
+    return hydra;
+}
+
+}
+
+#endif // ARGUS_BENCH_H
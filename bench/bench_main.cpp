@@ -0,0 +1,629 @@
+//
+// argus_bench: native microbenchmarks for the argus core library
+//
+// usage: argus_bench [--assets N] [--rows N] [--iters N] [filter]
+//
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fmt/core.h>
+
+#include "asset_file.h"
+#include "bench.h"
+#include "exchange.h"
+#include "generator.h"
+#include "hydra.h"
+#include "portfolio.h"
+#include "utils_array.h"
+
+// utils_gmp.h has no include guard and is already pulled in through portfolio.h
+
+using namespace std;
+using namespace ArgusBench;
+
+static bool bench_enabled(const BenchConfig& config, const string& name)
+{
+    return config.filter.empty() || name.find(config.filter) != string::npos;
+}
+
+static vector<string> asset_ids(size_t assets)
+{
+    vector<string> ids;
+    for(size_t i = 0; i < assets; i++)
+    {
+        ids.push_back(fmt::format("ASSET{}", i));
+    }
+    return ids;
+}
+
+static void bench_sorted_union(const BenchConfig& config, vector<BenchResult>& results)
+{
+    auto name = fmt::format("container_sorted_union/{}x{}", config.assets, config.rows);
+    if(!bench_enabled(config, name)) return;
+
+    auto hydra = synthetic_hydra(config.assets, config.rows, false);
+    auto exchange = hydra->get_exchange("exchange1");
+
+    results.push_back(run_bench(name, config.iterations, static_cast<double>(exchange->candles), [&]()
+    {
+        auto datetime_index = container_sorted_union(
+            exchange->market,
+            [](const shared_ptr<Asset> &obj)
+            { return obj->get_datetime_index(true); },
+            [](const shared_ptr<Asset> &obj)
+            { return obj->get_rows() - obj->get_warmup(); });
+        do_not_optimize(get<0>(datetime_index));
+        delete[] get<0>(datetime_index);
+    }));
+}
+
+static void bench_generate_universe(const BenchConfig& config, vector<BenchResult>& results)
+{
+    auto name = fmt::format("generator/generate_universe/{}x{}", config.assets, config.rows);
+    if(!bench_enabled(config, name)) return;
+
+    UniverseConfig universe;
+    universe.assets = config.assets;
+    universe.rows = config.rows;
+    universe.columns = {"open", "high", "low", "close", "volume"};
+    universe.gap = 0.25;
+
+    results.push_back(run_bench(name, config.iterations, static_cast<double>(config.assets * config.rows), [&]()
+    {
+        auto assets = generate_universe("exchange1", "broker1", universe);
+        do_not_optimize(assets.data());
+    }));
+}
+
+static void bench_exchange_build(const BenchConfig& config, vector<BenchResult>& results)
+{
+    auto name = fmt::format("exchange/build/{}x{}", config.assets, config.rows);
+    if(!bench_enabled(config, name)) return;
+
+    UniverseConfig universe;
+    universe.assets = config.assets;
+    universe.rows = config.rows;
+    universe.gap = 0.25;
+    auto assets = generate_universe("exchange1", "broker1", universe);
+
+    auto hydra = make_shared<Hydra>(0, 0.0);
+    auto exchange = hydra->new_exchange("exchange1");
+    for(auto& asset : assets)
+    {
+        hydra->register_asset(asset, "exchange1");
+    }
+
+    // rebuilding an exchange replaces its datetime index, so repeated builds do the same work
+    results.push_back(run_bench(name, config.iterations, static_cast<double>(config.assets * config.rows), [&]()
+    {
+        exchange->build();
+        do_not_optimize(exchange->candles);
+    }));
+}
+
+static void bench_asset_directory(const BenchConfig& config, vector<BenchResult>& results)
+{
+    auto name = fmt::format("asset_file/load_directory/{}x{}", config.assets, config.rows);
+    if(!bench_enabled(config, name)) return;
+
+    UniverseConfig universe;
+    universe.assets = config.assets;
+    universe.rows = config.rows;
+    universe.columns = {"open", "high", "low", "close", "volume"};
+    universe.gap = 0.25;
+    auto assets = generate_universe("exchange1", "broker1", universe);
+
+    auto directory = std::filesystem::temp_directory_path() / "argus_bench_assets";
+    std::filesystem::create_directories(directory);
+    for(auto& asset : assets)
+    {
+        asset->save_binary((directory / (asset->get_asset_id() + ASSET_FILE_EXTENSION)).string());
+    }
+
+    // files are in the page cache after the first iteration so this measures mapping, not disk reads
+    results.push_back(run_bench(name, config.iterations, static_cast<double>(config.assets * config.rows), [&]()
+    {
+        auto loaded = load_asset_directory(directory.string(), "exchange1", "broker1");
+        do_not_optimize(loaded.data());
+    }));
+    std::filesystem::remove_all(directory);
+}
+
+static void bench_asset_stream(const BenchConfig& config, vector<BenchResult>& results, bool stream)
+{
+    // a single long asset, rows scale with the universe so the pass is comparable to the others
+    auto rows = config.assets * config.rows;
+    auto name = fmt::format("asset_file/{}/{}", stream ? "stream" : "mmap", rows);
+    if(!bench_enabled(config, name)) return;
+
+    UniverseConfig universe;
+    universe.assets = 1;
+    universe.rows = rows;
+    universe.columns = {"open", "high", "low", "close", "volume"};
+    auto path = (std::filesystem::temp_directory_path() / "argus_bench_stream.argus").string();
+    generate_universe("exchange1", "broker1", universe)[0]->save_binary(path);
+
+    auto asset = new_asset("ASSET0", "exchange1", "broker1");
+    if(stream)
+    {
+        asset->load_file_stream(path);
+    }
+    else
+    {
+        asset->load_mmap(path);
+    }
+    asset->add_tracer(AssetTracerType::Volatility, 20, true);
+    asset->build();
+
+    // one iteration steps through every row, the stream rereads the file each pass
+    results.push_back(run_bench(name, config.iterations, static_cast<double>(rows),
+        [&]() { asset->reset_asset(); },
+        [&]()
+        {
+            while(asset->get_rows_remaining() > 1) asset->step();
+            do_not_optimize(asset->get_rows_remaining());
+        }
+    ));
+    std::filesystem::remove(path);
+}
+
+static void bench_asset_goto(const BenchConfig& config, vector<BenchResult>& results)
+{
+    auto rows = config.assets * config.rows;
+    auto name = fmt::format("asset/goto_datetime/{}", rows);
+    if(!bench_enabled(config, name)) return;
+
+    UniverseConfig universe;
+    universe.assets = 1;
+    universe.rows = rows;
+    auto asset = generate_universe("exchange1", "broker1", universe)[0];
+    asset->add_tracer(AssetTracerType::Volatility, 20, true);
+    asset->build();
+
+    // one iteration jumps back and forth between the first quarter and the last quarter of the index
+    auto datetime_index = asset->get_datetime_index();
+    size_t constexpr jumps = 1000;
+    results.push_back(run_bench(name, config.iterations, static_cast<double>(jumps), [&]()
+    {
+        for(size_t i = 0; i < jumps; i++)
+        {
+            auto row_index = (i % 2 ? rows / 4 : 3 * rows / 4) + i;
+            asset->goto_datetime(datetime_index[row_index]);
+        }
+        do_not_optimize(asset->get_rows_remaining());
+    }));
+}
+
+static void bench_market_view(const BenchConfig& config, vector<BenchResult>& results, bool aligned)
+{
+    auto name = fmt::format("exchange/get_market_view/{}/{}x{}",
+        aligned ? "aligned" : "unaligned", config.assets, config.rows);
+    if(!bench_enabled(config, name)) return;
+
+    auto hydra = synthetic_hydra(config.assets, config.rows, aligned);
+    auto exchange = hydra->get_exchange("exchange1");
+
+    // one iteration is a full pass over the exchange, items are the candles stepped
+    results.push_back(run_bench(name, config.iterations, static_cast<double>(exchange->candles),
+        [&]() { exchange->reset_exchange(); },
+        [&]()
+        {
+            while(exchange->get_market_view()){}
+            do_not_optimize(exchange->get_panel_time());
+        }
+    ));
+}
+
+/// every asset carries a volatility and beta tracer, threads is the size of the hydra's thread pool
+static void bench_step_tracers(const BenchConfig& config, vector<BenchResult>& results, size_t threads)
+{
+    auto name = fmt::format("exchange/step_tracers/threads{}/{}x{}", threads, config.assets, config.rows);
+    if(!bench_enabled(config, name)) return;
+
+    auto hydra = make_shared<Hydra>(0, 1e9);
+    auto exchange = hydra->new_exchange("exchange1");
+    hydra->new_broker("broker1", 1e9);
+    hydra->set_threads(threads);
+
+    UniverseConfig universe;
+    universe.assets = config.assets;
+    universe.rows = config.rows;
+    universe.seed = 42;
+    auto assets = generate_universe("exchange1", "broker1", universe);
+    for(auto& asset : assets)
+    {
+        hydra->register_asset(asset, "exchange1");
+    }
+
+    universe.assets = 1;
+    universe.prefix = "INDEX";
+    hydra->register_index_asset(generate_universe("exchange1", "broker1", universe)[0], "exchange1");
+    for(auto& asset : assets)
+    {
+        asset->add_tracer(AssetTracerType::Volatility, 60);
+        asset->add_tracer(AssetTracerType::Beta, 60);
+    }
+    hydra->build();
+
+    results.push_back(run_bench(name, config.iterations, static_cast<double>(exchange->candles),
+        [&]() { exchange->reset_exchange(); },
+        [&]()
+        {
+            while(exchange->get_market_view()){}
+            do_not_optimize(exchange->get_panel_time());
+        }
+    ));
+}
+
+/// mode is one of market_view (lookup by column name), handle (feature handle) or panel
+static void bench_cross_section(const BenchConfig& config, vector<BenchResult>& results, const string& mode)
+{
+    auto name = fmt::format("exchange/cross_section/{}/{}x{}", mode, config.assets, config.rows);
+    if(!bench_enabled(config, name)) return;
+
+    auto hydra = synthetic_hydra(config.assets, config.rows, false);
+    auto exchange = hydra->get_exchange("exchange1");
+    auto panel = mode == "panel";
+    if(panel)
+    {
+        exchange->enable_panel({"close"});
+        exchange->build();
+    }
+    auto const & exchange_panel = exchange->get_panel();
+    auto handle = exchange->get_feature_handle("close");
+    auto use_handle = mode == "handle";
+
+    // one iteration is a full pass over the exchange summing the close of every streaming asset each bar
+    results.push_back(run_bench(name, config.iterations, static_cast<double>(exchange->candles),
+        [&]() { exchange->reset_exchange(); },
+        [&]()
+        {
+            double total = 0;
+            while(exchange->get_market_view())
+            {
+                if(panel)
+                {
+                    auto time = exchange->get_panel_time();
+                    auto row = exchange_panel.get_row(0, time);
+                    for(size_t slot = 0; slot < exchange_panel.get_assets(); slot++)
+                    {
+                        if(exchange_panel.is_valid(time, slot)) total += row[slot];
+                    }
+                    continue;
+                }
+                for(auto asset : exchange->get_market_view_slots())
+                {
+                    if(!asset) continue;
+                    total += use_handle ?
+                        asset->get_asset_feature(handle, 0) :
+                        asset->get_asset_feature("close", 0);
+                }
+            }
+            do_not_optimize(total);
+        }
+    ));
+}
+
+/// a top n rebalancer querying the largest and smallest closes three times per bar
+static void bench_top_n(const BenchConfig& config, vector<BenchResult>& results)
+{
+    auto name = fmt::format("exchange/top_n/{}x{}", config.assets, config.rows);
+    if(!bench_enabled(config, name)) return;
+
+    auto hydra = synthetic_hydra(config.assets, config.rows, false);
+    auto exchange = hydra->get_exchange("exchange1");
+    auto handle = exchange->get_feature_handle("close");
+
+    results.push_back(run_bench(name, config.iterations, static_cast<double>(exchange->candles),
+        [&]() { exchange->reset_exchange(); },
+        [&]()
+        {
+            double total = 0;
+            while(exchange->get_market_view())
+            {
+                for(int i = 0; i < 3; i++)
+                {
+                    for(auto const & pair : exchange->select_exchange_feature(handle, 0, ExchangeQueryType::NLargest, 10))
+                    {
+                        total += pair.second;
+                    }
+                    for(auto const & pair : exchange->select_exchange_feature(handle, 0, ExchangeQueryType::NSmallest, 10))
+                    {
+                        total -= pair.second;
+                    }
+                }
+            }
+            do_not_optimize(total);
+        }
+    ));
+}
+
+static void bench_portfolio_evaluate(const BenchConfig& config, vector<BenchResult>& results)
+{
+    auto name = fmt::format("portfolio/evaluate/{}", config.assets);
+    if(!bench_enabled(config, name)) return;
+
+    auto hydra = synthetic_hydra(config.assets, config.rows, true);
+    auto portfolio = hydra->get_master_portflio();
+    hydra->forward_pass();
+    for(auto& asset_id : asset_ids(config.assets))
+    {
+        portfolio->place_market_order(asset_id, 10, "bench", OrderExecutionType::EAGER);
+    }
+
+    size_t constexpr evaluations = 100;
+    results.push_back(run_bench(name, config.iterations, static_cast<double>(evaluations * config.assets), [&]()
+    {
+        for(size_t i = 0; i < evaluations; i++)
+        {
+            portfolio->evaluate(i % 2);
+        }
+        do_not_optimize(portfolio->get_nlv());
+    }));
+}
+
+static void bench_broker_send_orders(const BenchConfig& config, vector<BenchResult>& results)
+{
+    auto name = fmt::format("broker/send_orders/{}", config.assets);
+    if(!bench_enabled(config, name)) return;
+
+    auto hydra = synthetic_hydra(config.assets, config.rows, true);
+    auto portfolio = hydra->get_master_portflio();
+    auto broker = hydra->get_broker("broker1");
+    auto ids = asset_ids(config.assets);
+    hydra->forward_pass();
+
+    // alternate between opening and closing a position in every asset
+    double units = 10;
+    results.push_back(run_bench(name, config.iterations, static_cast<double>(config.assets),
+        [&]()
+        {
+            for(auto& asset_id : ids)
+            {
+                portfolio->place_market_order(asset_id, units, "bench", OrderExecutionType::LAZY);
+            }
+            units *= -1;
+        },
+        [&]()
+        {
+            broker->send_orders();
+            do_not_optimize(portfolio->get_cash());
+        }
+    ));
+}
+
+/// every asset carries a ladder of resting buy limits below the market, none of them trigger
+static void bench_exchange_process_orders(const BenchConfig& config, vector<BenchResult>& results)
+{
+    size_t constexpr ladder = 100;
+    auto name = fmt::format("exchange/process_orders/{}x{}", config.assets, ladder);
+    if(!bench_enabled(config, name)) return;
+
+    auto hydra = synthetic_hydra(config.assets, config.rows, true);
+    auto portfolio = hydra->get_master_portflio();
+    auto exchange = hydra->get_exchange("exchange1");
+    hydra->forward_pass();
+    for(auto& asset_id : asset_ids(config.assets))
+    {
+        for(size_t i = 0; i < ladder; i++)
+        {
+            portfolio->place_limit_order(asset_id, 1, 1e-6 * static_cast<double>(i + 1), "bench", OrderExecutionType::EAGER);
+        }
+    }
+
+    size_t constexpr passes = 100;
+    results.push_back(run_bench(name, config.iterations, static_cast<double>(passes * config.assets * ladder), [&]()
+    {
+        for(size_t i = 0; i < passes; i++)
+        {
+            exchange->process_orders();
+        }
+        do_not_optimize(exchange->get_panel_time());
+    }));
+}
+
+static void bench_gmp(const BenchConfig& config, vector<BenchResult>& results)
+{
+    size_t constexpr ops = 1000000;
+
+    if(bench_enabled(config, "gmp/gmp_add_assign"))
+    {
+        results.push_back(run_bench("gmp/gmp_add_assign", config.iterations, ops, [&]()
+        {
+            double x = 0;
+            for(size_t i = 0; i < ops; i++) gmp_add_assign(x, 0.01);
+            do_not_optimize(x);
+        }));
+    }
+    if(bench_enabled(config, "gmp/gmp_sub_assign"))
+    {
+        results.push_back(run_bench("gmp/gmp_sub_assign", config.iterations, ops, [&]()
+        {
+            double x = 0;
+            for(size_t i = 0; i < ops; i++) gmp_sub_assign(x, 0.01);
+            do_not_optimize(x);
+        }));
+    }
+    if(bench_enabled(config, "gmp/gmp_mult"))
+    {
+        results.push_back(run_bench("gmp/gmp_mult", config.iterations, ops, [&]()
+        {
+            double x = 0;
+            for(size_t i = 0; i < ops; i++) x += gmp_mult(1.0001, static_cast<double>(i));
+            do_not_optimize(x);
+        }));
+    }
+    if(bench_enabled(config, "gmp/gmp_sub"))
+    {
+        results.push_back(run_bench("gmp/gmp_sub", config.iterations, ops, [&]()
+        {
+            double x = 0;
+            for(size_t i = 0; i < ops; i++) x += gmp_sub(1.0001, static_cast<double>(i));
+            do_not_optimize(x);
+        }));
+    }
+}
+
+static void bench_asset_lookback(
+    const BenchConfig& config,
+    vector<BenchResult>& results,
+    AssetLayout layout,
+    AssetPrecision precision = AssetPrecision::Float64)
+{
+    size_t constexpr lookback = 60;
+    auto name = fmt::format("asset/lookback_sum/{}{}/{}x{}",
+        layout == AssetLayout::RowMajor ? "row" : "column",
+        precision == AssetPrecision::Float64 ? "" : "/f32",
+        config.assets, config.rows);
+    if(!bench_enabled(config, name) || config.rows <= lookback) return;
+
+    // sum the close column over a trailing window, the access pattern of a rolling indicator computed
+    // in strategy code. Assets carry a realistic number of columns so row major windows span many cache lines
+    UniverseConfig universe;
+    universe.assets = config.assets;
+    universe.rows = config.rows;
+    universe.columns = {"open", "high", "low", "close", "volume", "feature1", "feature2", "feature3"};
+    universe.layout = layout;
+    universe.precision = precision;
+    auto universe_assets = generate_universe("exchange1", "broker1", universe);
+
+    // read the close column in the precision it is stored in, get_column_ptr is null for float32
+    // assets and get_column_series would time a widened float64 copy rather than the float32 storage
+    vector<double*> closes;
+    vector<float*> closes_f32;
+    for(auto& asset : universe_assets)
+    {
+        if(precision == AssetPrecision::Float64) closes.push_back(asset->get_column_ptr(asset->close_column));
+        else closes_f32.push_back(asset->get_column_ptr_f32(asset->close_column));
+    }
+    if(std::count(closes.begin(), closes.end(), nullptr) || std::count(closes_f32.begin(), closes_f32.end(), nullptr))
+    {
+        fmt::print(stderr, "{}: close column not stored in the requested precision, skipping\n", name);
+        return;
+    }
+    auto stride = universe_assets.front()->get_row_stride();
+
+    // step major like the event loop, every bar reads the trailing window of every asset
+    results.push_back(run_bench(name, config.iterations, static_cast<double>(config.assets * (config.rows - lookback)), [&]()
+    {
+        double total = 0;
+        for(size_t i = lookback; i < config.rows; i++)
+        {
+            for(size_t k = 0; k < config.assets; k++)
+            {
+                double sum = 0;
+                if(precision == AssetPrecision::Float64)
+                {
+                    auto close = closes[k];
+                    for(size_t j = i - lookback; j < i; j++)
+                    {
+                        sum += close[j * stride];
+                    }
+                }
+                else
+                {
+                    auto close = closes_f32[k];
+                    for(size_t j = i - lookback; j < i; j++)
+                    {
+                        sum += close[j * stride];
+                    }
+                }
+                total += sum;
+            }
+        }
+        do_not_optimize(total);
+    }));
+}
+
+static void bench_hydra_run(const BenchConfig& config, vector<BenchResult>& results, bool aligned, bool rebalance)
+{
+    auto name = fmt::format("hydra/run/{}{}/{}x{}",
+        aligned ? "aligned" : "unaligned",
+        rebalance ? "/rebalance" : "",
+        config.assets, config.rows);
+    if(!bench_enabled(config, name)) return;
+
+    auto hydra = synthetic_hydra(config.assets, config.rows, aligned);
+    auto portfolio = hydra->get_master_portflio();
+    auto ids = asset_ids(std::min<size_t>(config.assets, 50));
+    auto strategy = hydra->new_strategy("bench");
+
+    // every 10th bar flip a position in a subset of the universe at the close
+    size_t bar = 0;
+    strategy->cxx_handler_on_open = [](){};
+    strategy->cxx_handler_on_close = [&]()
+    {
+        bar++;
+        if(!rebalance || bar % 10)
+        {
+            return;
+        }
+        for(auto& asset_id : ids)
+        {
+            auto position = portfolio->get_position(asset_id);
+            double units = position.has_value() ? -1 * position.value()->get_units() : 10;
+            portfolio->place_market_order(asset_id, units, "bench", OrderExecutionType::LAZY);
+        }
+    };
+
+    results.push_back(run_bench(name, config.iterations, static_cast<double>(hydra->get_candles()),
+        [&]() { hydra->reset(true, false); bar = 0; },
+        [&]()
+        {
+            hydra->run();
+            do_not_optimize(portfolio->get_nlv());
+        }
+    ));
+}
+
+int main(int argc, char** argv)
+{
+    BenchConfig config;
+    for(int i = 1; i < argc; i++)
+    {
+        if(!strcmp(argv[i], "--assets") && i + 1 < argc)     config.assets = std::strtoull(argv[++i], nullptr, 10);
+        else if(!strcmp(argv[i], "--rows") && i + 1 < argc)  config.rows = std::strtoull(argv[++i], nullptr, 10);
+        else if(!strcmp(argv[i], "--iters") && i + 1 < argc) config.iterations = std::strtoull(argv[++i], nullptr, 10);
+        else config.filter = argv[i];
+    }
+
+    vector<BenchResult> results;
+    print_header();
+
+    auto run = [&](auto bench)
+    {
+        auto start = results.size();
+        bench();
+        for(size_t i = start; i < results.size(); i++) print_result(results[i]);
+    };
+
+    run([&]() { bench_generate_universe(config, results); });
+    run([&]() { bench_asset_directory(config, results); });
+    run([&]() { bench_asset_stream(config, results, false); });
+    run([&]() { bench_asset_stream(config, results, true); });
+    run([&]() { bench_asset_goto(config, results); });
+    run([&]() { bench_exchange_build(config, results); });
+    run([&]() { bench_sorted_union(config, results); });
+    run([&]() { bench_market_view(config, results, true); });
+    run([&]() { bench_market_view(config, results, false); });
+    run([&]() { bench_step_tracers(config, results, 1); });
+    run([&]() { bench_step_tracers(config, results, 4); });
+    run([&]() { bench_cross_section(config, results, "market_view"); });
+    run([&]() { bench_cross_section(config, results, "handle"); });
+    run([&]() { bench_cross_section(config, results, "panel"); });
+    run([&]() { bench_top_n(config, results); });
+    run([&]() { bench_portfolio_evaluate(config, results); });
+    run([&]() { bench_broker_send_orders(config, results); });
+    run([&]() { bench_exchange_process_orders(config, results); });
+    run([&]() { bench_gmp(config, results); });
+    run([&]() { bench_asset_lookback(config, results, AssetLayout::RowMajor); });
+    run([&]() { bench_asset_lookback(config, results, AssetLayout::ColumnMajor); });
+    run([&]() { bench_asset_lookback(config, results, AssetLayout::RowMajor, AssetPrecision::Float32); });
+    run([&]() { bench_asset_lookback(config, results, AssetLayout::ColumnMajor, AssetPrecision::Float32); });
+    run([&]() { bench_hydra_run(config, results, true, false); });
+    run([&]() { bench_hydra_run(config, results, false, false); });
+    run([&]() { bench_hydra_run(config, results, true, true); });
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+//
+// heap allocation accounting for the hydra event loop, only active in builds with ARGUS_ALLOC_TRACKING
+//
+
+#ifndef ARGUS_ALLOC_TRACKER_H
+#define ARGUS_ALLOC_TRACKER_H
+
+#include <cstddef>
+
+#include "profiler.h"
+
+/**
+ * @brief number of allocations and bytes requested while a phase was active
+ *
+ */
+struct AllocCounter
+{
+    size_t allocations = 0;     ///< number of calls to operator new
+    size_t bytes = 0;           ///< number of bytes requested
+    size_t frees = 0;           ///< number of calls to operator delete
+};
+
+/**
+ * @brief global allocation tracker. In builds with ARGUS_ALLOC_TRACKING the global operator new and
+ *  delete are replaced and every allocation made on a thread with an active phase is attributed to
+ *  the innermost phase. In strict mode any allocation made while strict is active is recorded as a violation.
+ *  The counters are atomic, thread pool workers take the phase and strict mode of the thread that
+ *  handed them the work so allocations made on them are counted like the caller's.
+ *
+ */
+class AllocTracker
+{
+public:
+    /// was the tracker compiled in
+    static bool is_enabled();
+
+    /// get the counter of allocations made while a phase was the innermost active phase
+    static AllocCounter get_phase_counter(ProfilePhase phase);
+
+    /// get the counter of all allocations made while any phase was active
+    static AllocCounter get_total_counter();
+
+    /// clear all counters and violations
+    static void reset();
+
+    /// number of allocations made while strict mode was active
+    static size_t get_violations();
+
+    /// number of violations attributed to a phase
+    static size_t get_phase_violations(ProfilePhase phase);
+
+    /// record an allocation on the current thread (called by the replaced operator new)
+    static void record_allocation(size_t bytes);
+
+    /// record a free on the current thread (called by the replaced operator delete)
+    static void record_free();
+
+    /// set the innermost active phase on the current thread, returns the previous phase (-1 for none)
+    static int set_phase(int phase);
+
+    /// innermost active phase on the current thread (-1 for none)
+    static int get_phase();
+
+    /// set wether strict mode is active on the current thread, returns the previous value
+    static bool set_strict(bool strict);
+
+    /// is strict mode active on the current thread
+    static bool get_strict();
+};
+
+/**
+ * @brief sets the allocation phase of the current thread for the lifetime of the scope
+ *
+ */
+class AllocPhaseScope
+{
+public:
+    explicit AllocPhaseScope(ProfilePhase phase) : previous(AllocTracker::set_phase(phase)) {}
+    ~AllocPhaseScope() {AllocTracker::set_phase(this->previous);}
+
+    AllocPhaseScope(const AllocPhaseScope&) = delete;
+    AllocPhaseScope& operator=(const AllocPhaseScope&) = delete;
+
+private:
+    int previous;
+};
+
+/**
+ * @brief activates strict mode on the current thread for the lifetime of the scope
+ *
+ */
+class AllocStrictScope
+{
+public:
+    explicit AllocStrictScope(bool strict) : previous(AllocTracker::set_strict(strict)) {}
+    ~AllocStrictScope() {AllocTracker::set_strict(this->previous);}
+
+    AllocStrictScope(const AllocStrictScope&) = delete;
+    AllocStrictScope& operator=(const AllocStrictScope&) = delete;
+
+private:
+    bool previous;
+};
+
+#ifdef ARGUS_ALLOC_TRACKING
+/// attribute allocations in the remainder of the scope to a phase
+#define ARGUS_ALLOC_PHASE(phase) AllocPhaseScope ARGUS_PROFILE_CONCAT(argus_alloc_phase_, __LINE__)(phase)
+/// flag allocations in the remainder of the scope as violations if strict is true
+#define ARGUS_ALLOC_STRICT(strict) AllocStrictScope ARGUS_PROFILE_CONCAT(argus_alloc_strict_, __LINE__)(strict)
+#else
+#define ARGUS_ALLOC_PHASE(phase)
+#define ARGUS_ALLOC_STRICT(strict)
+#endif
+
+#endif // ARGUS_ALLOC_TRACKER_H
@@ -12,17 +12,25 @@
 #include <pybind11/numpy.h>
 
 #include "containers.h"
+#include "symbol_table.h"
 
 namespace py = pybind11;
 using namespace std;
 
 class Asset;
 class AssetTracer;
+class AssetChunkSource;
 
 enum AssetTracerType
 {
     Volatility,
-    Beta
+    Beta,
+    MovingAverage,              ///< mean of a column over the lookback
+    ExponentialMovingAverage,   ///< exponential average of a column with span lookback
+    RollingMin,                 ///< minimum of a column over the lookback
+    RollingMax,                 ///< maximum of a column over the lookback
+    RollingZScore,              ///< z-score of the current value of a column within the lookback
+    AverageTrueRange            ///< mean true range over the lookback from the high, low and close
 };
 
  enum AssetFrequency
@@ -30,6 +38,42 @@ enum AssetTracerType
     Daily
  };
 
+/// @brief memory layout of an asset's data
+enum AssetLayout
+{
+    RowMajor,       ///< each row is contiguous, rows are strided by the number of columns
+    ColumnMajor     ///< each column is contiguous and cache line aligned, rows are strided by one
+};
+
+/// @brief element type of an asset's stored values, values are always read back as double
+enum AssetPrecision
+{
+    Float64,        ///< values are stored as double
+    Float32         ///< values are stored as float and widened on read, halves memory and bandwidth
+};
+
+/// alignment in bytes of asset data allocations, column major columns start on this boundary
+static size_t constexpr ASSET_DATA_ALIGNMENT = 64;
+
+/// default number of rows a streaming asset reads from its source per refill
+static size_t constexpr ASSET_STREAM_CHUNK_ROWS = 4096;
+
+/// column index of a feature handle that is looked up by name in each asset it reads
+static size_t constexpr FEATURE_UNRESOLVED = static_cast<size_t>(-1);
+
+/**
+ * @brief a column name resolved once to a column index and an optional tracer scaler, reads
+ *  through a handle skip the header lookup. Handles resolved by an exchange hold the column index
+ *  shared by every listed asset, or FEATURE_UNRESOLVED if the listed assets disagree
+ */
+struct FeatureHandle
+{
+    string column;                                      ///< name of the column
+    size_t column_index = FEATURE_UNRESOLVED;           ///< index of the column in the asset data
+    optional<AssetTracerType> query_scaler = nullopt;   ///< tracer the value is divided by
+    optional<size_t> panel_index = nullopt;             ///< index of the column in the exchange panel
+};
+
 
 class Asset
 { 
@@ -64,6 +108,10 @@ public:
     string exchange_id;         ///< unique id of the exchange the asset is on
     string broker_id;           ///< unique id of the broker the asset is listed on 
 
+    symbol_t asset_symbol;      ///< interned symbol of the asset id
+    symbol_t exchange_symbol;   ///< interned symbol of the exchange id
+    symbol_t broker_symbol;     ///< interned symbol of the broker id
+
     size_t open_column;         ///< index of the open column;
     size_t close_column;        ///< index of the close column
     size_t current_index;       ///< index of the current row the asset is at
@@ -73,6 +121,9 @@ public:
     /// @brief vector of tracers registered to the asset
     vector<shared_ptr<AssetTracer>> tracers;
 
+    /// @brief tracers stepped by the asset, the ones not kept in a tracer bank
+    vector<AssetTracer*> step_tracers;
+
     /**
      * @brief fork an asset into a view, the new object will be a new object entirly except for the 
      *        data and datetime index pointers, they will point to this existing object (i.e. no dyn alloc)
@@ -101,7 +152,9 @@ public:
     void build();
 
     /**
-     * @brief move the asset to an exact point in time
+     * @brief move the asset to a point in time, the next row exposed is the first at or after the
+     *  datetime. The row is found with a binary search and tracers are rebuilt from the lookback
+     *  window behind it, so the asset can be moved forward or backward.
      * 
      * @param datetime ns epoch time to move the asset to
      */
@@ -132,24 +185,43 @@ public:
     optional<shared_ptr<AssetTracer>> get_tracer(AssetTracerType tracer_type) const;
 
     /**
-     * @brief Get the value set be a specific tracer by type
+     * @brief Get the value set be a specific tracer by type, the first tracer of the type if the
+     *  asset has several. Throws if the tracer is not warm.
      * 
      * @param tracer_type the type of tracer to get (not searching for, just deref appropriate pointer)
      * @return current value of the tracer
      */
     double get_tracer_value(AssetTracerType tracer_type) const;
 
-    /// @brief get a pointer to the current row of the asset
-    /// @return const pointer to the underlying row data
+    /**
+     * @brief index a column or tracer is read at through a feature handle. Tracers are read as
+     *  columns after the asset's own, only at the current row.
+     * 
+     * @param name name of a column or tracer
+     * @return optional<size_t> nullopt if the asset has neither
+     */
+    [[nodiscard]] optional<size_t> get_feature_index(const string& name) const;
+
+    /// @brief get a pointer to the first column of the current row of a float64 asset, the value of
+    ///        column j is at get_row()[j * get_col_stride()]
+    /// @return const pointer to the underlying row data, nullptr for float32 assets
     double * get_row() const {return this->row;}
 
+    /// @brief get a pointer to the first column of the current row of a float32 asset
+    /// @return const pointer to the underlying row data, nullptr for float64 assets
+    float * get_row_f32() const {return this->row_f32;}
+
     /// @brief get the number of rows of data remaining for the asset
     /// @return number of rows remaining, including the current one
     size_t get_rows_remaining() const{return this->rows - this->current_index - 1;}
     
     [[nodiscard]] size_t get_rows() const { return this->rows; } ///< return the number of rows in the asset
     [[nodiscard]] size_t get_cols() const { return this->cols; } ///< return the number of columns in the asset
-    [[nodiscard]] string get_asset_id() const;                   ///< return the id of an asset
+    [[nodiscard]] size_t get_row_stride() const { return this->row_stride; } ///< elements between consecutive rows of a column
+    [[nodiscard]] size_t get_col_stride() const { return this->col_stride; } ///< elements between consecutive columns of a row
+    [[nodiscard]] AssetLayout get_layout() const { return this->layout; }    ///< return the memory layout of the asset data
+    [[nodiscard]] AssetPrecision get_precision() const { return this->precision; } ///< return the element type of the asset data
+    [[nodiscard]] string const & get_asset_id() const;           ///< return the id of an asset
 
     /// return pointer to the first element of the datetime index;
     [[nodiscard]] long long *get_datetime_index(bool warmup_start = false) const;
@@ -157,23 +229,41 @@ public:
     /**
      * @brief Get a read only array of the datetime index of the asset
      * 
+     * @param owner python object of the asset, the view keeps it alive
      * @return * py::array_t<long long> 
      */
-    py::array_t<long long> get_datetime_index_view();
+    py::array_t<long long> get_datetime_index_view(py::handle owner = py::handle());
 
     /**
      * @brief Get pointer to the asset's underlying data
      * 
-     * @return double* pointer to first element of the asset's data
+     * @return double* pointer to first element of the asset's data, nullptr for float32 assets
      */
     double* get_data() {return this->data;};
 
     /**
-     * @brief Get the data of the asset object as a row major py array
+     * @brief Get pointer to the underlying data of a float32 asset
      * 
-     * @return py::array_t<double> underlying data of the asset
+     * @return float* pointer to first element of the asset's data, nullptr for float64 assets
      */
-    py::array_t<double> get_data_view();
+    float* get_data_f32() {return this->data_f32;};
+
+    /**
+     * @brief Get a read only (rows, cols) view of the data of the asset object, strided according
+     *        to the asset's layout
+     * 
+     * @param owner python object of the asset, the view keeps it alive
+     * @return py::array underlying data of the asset, float32 for float32 assets. Streaming assets
+     *  return a copy of the rows in their window as the window is moved on refill
+     */
+    py::array get_data_view(py::handle owner = py::handle());
+
+    /// @brief get the index of a column, nullopt if the asset does not have it
+    [[nodiscard]] optional<size_t> get_column_index(const string& column) const
+    {
+        auto it = this->headers.find(column);
+        return it == this->headers.end() ? nullopt : optional<size_t>(it->second);
+    }
 
     /**
      * @brief Get the headers of the asset object
@@ -199,27 +289,198 @@ public:
      * @param datetime_index    pointer to the start of the datetime index
      * @param rows              number of rows in the data
      * @param cols              number of columns in the data
+     * @param layout            memory layout to store the data in
+     * @param precision         element type to store the data as
      */
-    void load_data(const double *data, const long long *datetime_index, size_t rows, size_t cols);
-    
+    void load_data(
+        const double *data,
+        const long long *datetime_index,
+        size_t rows,
+        size_t cols,
+        AssetLayout layout = AssetLayout::RowMajor,
+        AssetPrecision precision = AssetPrecision::Float64);
+
+    /**
+     * @brief load in the data from a strided (rows, cols) array of values, e.g. a 2d numpy array in
+     *  either order. Does not touch python so assets can be loaded in parallel (see Hydra::register_assets).
+     * 
+     * @param data              pointer to the value at row 0, column 0
+     * @param datetime_index    pointer to the start of the datetime index
+     * @param rows              number of rows in the data
+     * @param cols              number of columns in the data
+     * @param data_row_stride   number of elements between consecutive rows of a column
+     * @param data_col_stride   number of elements between consecutive columns of a row
+     * @param layout            memory layout to store the data in
+     * @param precision         element type to store the data as
+     */
+    void load_strided_data(
+        const double *data,
+        const long long *datetime_index,
+        size_t rows,
+        size_t cols,
+        size_t data_row_stride,
+        size_t data_col_stride,
+        AssetLayout layout = AssetLayout::RowMajor,
+        AssetPrecision precision = AssetPrecision::Float64);
+
+    /// @brief load_strided_data from float32 values
+    void load_strided_data(
+        const float *data,
+        const long long *datetime_index,
+        size_t rows,
+        size_t cols,
+        size_t data_row_stride,
+        size_t data_col_stride,
+        AssetLayout layout = AssetLayout::RowMajor,
+        AssetPrecision precision = AssetPrecision::Float64);
+
+    /**
+     * @brief allocate uninitialized storage for the asset's data and datetime index, the caller is
+     *        responsible for writing every value through get_data() (get_data_f32() for float32
+     *        storage) and get_datetime_index()
+     *
+     * @param rows              number of rows in the data
+     * @param cols              number of columns in the data
+     * @param layout            memory layout of the allocated storage
+     * @param precision         element type of the allocated storage
+     */
+    void allocate_data(
+        size_t rows,
+        size_t cols,
+        AssetLayout layout = AssetLayout::RowMajor,
+        AssetPrecision precision = AssetPrecision::Float64);
+
     // NOTE: only for test use
-    void load_view(double *data, long long *datetime_index, size_t rows, size_t cols);
+    void load_view(
+        double *data,
+        long long *datetime_index,
+        size_t rows,
+        size_t cols,
+        AssetLayout layout = AssetLayout::RowMajor);
+
+    /**
+     * @brief load a zero copy view of externally owned data, the asset reads directly from the passed
+     *        memory and holds on to the owner until it is destroyed
+     * 
+     * @param data              pointer to the value of the first column of the first row
+     * @param datetime_index    pointer to the start of the datetime index
+     * @param rows              number of rows in the data
+     * @param cols              number of columns in the data
+     * @param row_stride        number of elements between consecutive rows of a column
+     * @param col_stride        number of elements between consecutive columns of a row
+     * @param owner             keeps the data and datetime index alive for the lifetime of the asset
+     */
+    void load_owned_view(
+        double *data,
+        long long *datetime_index,
+        size_t rows,
+        size_t cols,
+        size_t row_stride,
+        size_t col_stride,
+        shared_ptr<void> owner);
+
+    /// @brief load a zero copy view of externally owned float32 data (see load_owned_view)
+    void load_owned_view(
+        float *data,
+        long long *datetime_index,
+        size_t rows,
+        size_t cols,
+        size_t row_stride,
+        size_t col_stride,
+        shared_ptr<void> owner);
+
+    /**
+     * @brief zero copy load from python, the asset keeps a reference to both buffers
+     * 
+     * @param data              float64 or float32 buffer, either a 2d (rows, cols) array with any strides
+     *                          or a 1d array holding the columns back to back. The asset's precision
+     *                          follows the buffer's dtype
+     * @param datetime_index    contiguous int64 buffer holding the datetime index of the asset
+     */
+    void py_load_view(const py::buffer &data, const py::buffer &datetime_index);
 
     /**
      * @brief load in data from python using numpy array interface
      * 
-     * @param data              a py buffer object holding a column major numpy array of the asset's values
+     * @param data              a py buffer object holding a column major float64 or float32 numpy array
+     *                          of the asset's values
      * @param datetime_index    a py buffer object olding the datetime index of the asset
      * @param rows              number of rows in the asset
      * @param cols              number of columns in the asset
-     * @param is_view           is_view leads to 0 copy asset creation (test use only, very bad performance)
+     * @param is_view           load a zero copy view of the buffers instead of copying (see py_load_view)
+     * @param layout            memory layout to store the data in, views take the layout of the buffer
+     *                          and throw if any other than the default is requested
+     * @param precision         element type to store the data as, ignored for views
      */
     void py_load_data(
         const py::buffer &data, 
         const py::buffer &datetime_index, 
         size_t rows, 
         size_t cols,
-        bool is_view);
+        bool is_view,
+        AssetLayout layout = AssetLayout::RowMajor,
+        AssetPrecision precision = AssetPrecision::Float64);
+
+    /**
+     * @brief write the asset to a binary asset file (see asset_file.h)
+     * 
+     * @param path path of the file to create or overwrite
+     */
+    void save_binary(const string& path);
+
+    /**
+     * @brief load the asset by memory mapping a binary asset file read only, the asset's data points
+     *        straight into the mapping which is released with the asset
+     * 
+     * @param path path of the file
+     */
+    void load_mmap(const string& path);
+
+    /**
+     * @brief load the asset as a stream. The datetime index is held in full but values are read from
+     *        the source into a sliding window of rows as the asset steps. The window keeps the larger of
+     *        lookback and the longest tracer lookback behind the current row, rows before it can not be
+     *        read and seeking backwards rewinds the source. Streaming assets are row major float64,
+     *        headers must be loaded first.
+     * 
+     * @param source            source delivering every row of the asset in order
+     * @param datetime_index    datetime index of the rows (copied)
+     * @param rows              number of rows the source delivers
+     * @param chunk_rows        rows read from the source per refill of the window
+     * @param lookback          rows behind the current row that stay readable
+     */
+    void load_stream(
+        shared_ptr<AssetChunkSource> source,
+        const long long *datetime_index,
+        size_t rows,
+        size_t chunk_rows = ASSET_STREAM_CHUNK_ROWS,
+        size_t lookback = 0);
+
+    /**
+     * @brief load the asset as a stream of python chunks (see load_stream)
+     * 
+     * @param chunks            callable returning an iterable of 2-D (rows, cols) arrays, called again on reset
+     * @param datetime_index    int64 datetime index of every row the chunks hold
+     * @param chunk_rows        rows read per refill of the window
+     * @param lookback          rows behind the current row that stay readable
+     */
+    void py_load_stream(
+        py::object chunks,
+        const py::buffer &datetime_index,
+        size_t chunk_rows = ASSET_STREAM_CHUNK_ROWS,
+        size_t lookback = 0);
+
+    /// @brief load the asset as a stream over a binary asset file read in chunks (see load_stream)
+    void load_file_stream(const string& path, size_t chunk_rows = ASSET_STREAM_CHUNK_ROWS, size_t lookback = 0);
+
+    /// @brief is the asset streamed from a chunk source
+    [[nodiscard]] bool get_is_streaming() const {return this->stream_source != nullptr;}
+
+    /// @brief can the asset be stepped off the main thread, false if its stream source needs the gil
+    [[nodiscard]] bool get_is_thread_safe() const;
+
+    /// @brief row index of the first row held in the asset's data, 0 unless the asset is streaming
+    [[nodiscard]] size_t get_window_start() const {return this->window_start;}
 
     /// @brief get data point from current asset row
     [[nodiscard]] double c_get(size_t column_offset) const;
@@ -227,6 +488,9 @@ public:
     /// @brief get data point from asset
     [[nodiscard]] double get(const string &column, size_t row_index) const;
 
+    /// @brief get a value by feature handle and absolute row index (no tracer scaling)
+    [[nodiscard]] double get(const FeatureHandle& handle, size_t row_index) const;
+
     /// @brief get fixed point rep of current market price
     [[nodiscard]] double get_market_price(bool on_close) const;
 
@@ -251,23 +515,62 @@ public:
         optional<AssetTracerType> query_scaler = nullopt
     );
 
+    /**
+     * @brief resolve a column of the asset to a handle for repeated reads
+     * 
+     * @param column_name name of the column, throws if the asset does not have it
+     * @param query_scaler optional tracer to divide values read through the handle by
+     * @return FeatureHandle handle holding the asset's column index
+     */
+    [[nodiscard]] FeatureHandle get_feature_handle(
+        const string& column_name,
+        optional<AssetTracerType> query_scaler = nullopt
+    ) const;
+
+    /// @brief get specific data point through a feature handle, index 0 is current, -1 is previous, ...
+    [[nodiscard]] double get_asset_feature(const FeatureHandle& handle, int index = 0);
+
     /**
      * @brief Get a column from the asset, end index is the current value
      * 
      * @param column_name name of the column to retrieve
      * @param length lookback period, i.e. 10 will get last 10 values including current
-     * @return py::array_t<double> column values
+     * @param owner python object of the asset, the view keeps it alive
+     * @return py::array column values, float32 for float32 assets. Streaming assets return a copy
+     *  as their window is moved on refill
      */
-    [[nodiscard]] py::array_t<double> get_column(const string& column_name, size_t length);
+    [[nodiscard]] py::array get_column(const string& column_name, size_t length, py::handle owner = py::handle());
 
     /**
-     * @brief Get a pointer to the start of a particular column
+     * @brief Get a pointer to the start of a particular column, consecutive rows of the column are
+     *        get_row_stride() elements apart
      * 
      * @param column_index index of the column to get
-     * @return double* pointer to the start of the column
+     * @return double* pointer to the start of the column, nullptr for float32 assets
      */
     double* get_column_ptr(size_t column_index);
 
+    /// @brief Get a pointer to the start of a particular column of a float32 asset, nullptr for float64 assets
+    float* get_column_ptr_f32(size_t column_index);
+
+    /**
+     * @brief Get the close column as doubles, used by tracers. Float32 assets widen a copy of the
+     *        column the first time it is requested. The copy holds 8 bytes per row for the life of
+     *        the asset, so each widened column gives back twice what float32 storage saved on it
+     * 
+     * @return double* pointer to the first close value, consecutive rows are get_close_stride() apart
+     */
+    double* get_close_series() { return this->get_column_series(this->close_column); }
+
+    /// @brief Get a column as doubles like get_close_series()
+    double* get_column_series(size_t column_index);
+
+    /// @brief number of elements between consecutive rows of get_close_series() and get_column_series()
+    [[nodiscard]] size_t get_close_stride() const
+    {
+        return this->precision == AssetPrecision::Float64 ? this->row_stride : 1;
+    }
+
     /**
      * @brief Set the warmup of the asset object, moves the row pointer to index so data must be loaded already
      * 
@@ -290,16 +593,50 @@ public:
     void set_beta(double* beta_){this->beta = (beta_ == nullptr) ? nullopt : optional<double*>(beta_);}
     
     /**
-     * @brief build and add a new tracer object to the asset
+     * @brief build and add a new tracer object to the asset. The tracer can be read as a feature
+     *  by its name. Only one volatility and beta tracer can be added, other tracers must have
+     *  unique names.
      * 
-     * @param tracer_type type of tracer to add
-     * @param lookback    lookback of the tracer
+     * @param tracer_type   type of tracer to add
+     * @param lookback      lookback of the tracer
+     * @param adjust_warmup raise the warmup of the asset to the lookback
+     * @param column        column the tracer reads, the close if empty. Volatility, beta and average
+     *                      true range read their own columns and ignore it.
+     * @param name          name the tracer is read by as a feature, generated from the type, lookback
+     *                      and column if empty (i.e. sma_20_CLOSE)
      */
-    void add_tracer(AssetTracerType tracer_type, size_t lookback, bool adjust_warmup = false);
+    void add_tracer(
+        AssetTracerType tracer_type,
+        size_t lookback,
+        bool adjust_warmup = false,
+        const string& column = "",
+        const string& name = "");
+
+    /**
+     * @brief add a tracer object built outside of the asset, i.e. one kept in an exchange's tracer
+     *  bank. The same rules as above apply, the name is generated from the type and lookback if empty.
+     *
+     * @param tracer        tracer to add, its parent must be this asset
+     * @param adjust_warmup raise the warmup of the asset to the lookback
+     */
+    void add_tracer(const shared_ptr<AssetTracer>& tracer, bool adjust_warmup = false);
 
     /// step the asset forward in time
     void step();
 
+    /**
+     * @brief set lazy tracer mode. Lazy tracers are not stepped with the asset, they record the row
+     *  they were stepped to and catch up by stepping over the skipped rows when their value is read.
+     *  Tracers that read other assets at each step (beta) are always stepped. Assets listed on an
+     *  exchange are set through the exchange, which then leaves the banked tracers to the assets.
+     *
+     * @param lazy_tracers_ step the tracers only when they are read
+     */
+    void set_lazy_tracers(bool lazy_tracers_);
+
+    /// @brief are the tracers stepped only when they are read
+    [[nodiscard]] bool get_lazy_tracers() const {return this->lazy_tracers;}
+
 private:
     bool is_loaded = false;     ///< has the asset data been loaded in   
     bool is_built  = false;     ///< has the asset been built
@@ -309,13 +646,97 @@ private:
     std::vector<string>                headers_ordered; ///<ordered list of columns
 
     long long*  datetime_index = nullptr;   ///< datetime index of the asset (ns epoch time stamp)
-    double*     data           = nullptr;   ///< underlying data of the asset
-    double*     row            = nullptr;   ///< pointer to the current row
+    double*     data           = nullptr;   ///< underlying data of a float64 asset
+    double*     row            = nullptr;   ///< pointer to the current row of a float64 asset
+    float*      data_f32       = nullptr;   ///< underlying data of a float32 asset
+    float*      row_f32        = nullptr;   ///< pointer to the current row of a float32 asset
+
+    AssetPrecision precision = AssetPrecision::Float64; ///< element type of the asset data
+    /// widened columns of a float32 asset used by tracers, one float64 copy of every row per column
+    /// read through get_column_series(), typically only the close column
+    std::unordered_map<size_t, vector<double>> columns_f64;
+
+    bool lazy_tracers = false;          ///< are the tracers stepped only when read
+    mutable size_t tracer_index = 0;    ///< current index the deferrable tracers have been stepped to
+
+    /// step the deferrable tracers over the rows skipped since they were last read
+    void catch_up_tracers() const;
+
+    /// value at an element offset from the current row pointer, widened for float32 assets
+    inline double row_value(ptrdiff_t offset) const
+    {
+        return this->precision == AssetPrecision::Float64 ? this->row[offset] : this->row_f32[offset];
+    }
+
+    /// value at an element offset from the start of the data, widened for float32 assets
+    inline double data_value(size_t offset) const
+    {
+        return this->precision == AssetPrecision::Float64 ? this->data[offset] : this->data_f32[offset];
+    }
+
+    /// value of a column at a row offset from the current row (0 is current), divided by the scaler if passed
+    double read_feature(size_t column_index, int index, optional<AssetTracerType> query_scaler) const;
+
+    /// point the row pointer of the asset's precision at a row index, streaming assets move their window
+    void set_row(size_t row_index);
+
+    shared_ptr<AssetChunkSource> stream_source = nullptr;  ///< row source of a streaming asset
+    size_t window_start = 0;        ///< row index of the first row held in data
+    size_t window_rows = 0;         ///< rows held in the window of a streaming asset
+    size_t window_capacity = 0;     ///< rows the window of a streaming asset has room for
+    size_t stream_position = 0;     ///< row index of the next row the source delivers
+    size_t stream_chunk_rows = 0;   ///< rows read from the source per refill
+    size_t stream_lookback = 0;     ///< rows behind the current row a caller may read
+
+    /// rows kept behind a row when the window of a streaming asset moves
+    size_t get_stream_retain() const;
+
+    /// move the window of a streaming asset so the row and the rows retained behind it are held, and
+    /// point the row pointer at it
+    void stream_to(size_t row_index);
+
+    /// allocate the data array of the asset's precision and layout
+    void allocate_storage();
+
+    /// copy a strided array of values (column major if the strides are 1 and rows) into newly allocated
+    /// storage of the given layout and precision
+    template <typename T>
+    void load_columns(
+        const T *data,
+        const long long *datetime_index,
+        size_t rows,
+        size_t cols,
+        AssetLayout layout,
+        AssetPrecision precision,
+        size_t data_row_stride,
+        size_t data_col_stride);
+
+    /// set the datetime index, shape and strides of a view once its data pointer is set
+    void attach_view(
+        long long *datetime_index,
+        size_t rows,
+        size_t cols,
+        size_t row_stride,
+        size_t col_stride,
+        shared_ptr<void> owner);
 
     size_t rows = 0;        ///< number of rows in the asset data
     size_t cols = 0;        ///< number of columns in the asset data
+    size_t row_stride = 0;  ///< number of elements between consecutive rows of a column
+    size_t col_stride = 0;  ///< number of elements between consecutive columns of a row
+
+    AssetLayout layout = AssetLayout::RowMajor; ///< memory layout of the asset data
+
+    /// set the layout and strides for the current rows and cols, column major columns are padded to
+    /// the data alignment if pad_columns is true
+    void set_layout(AssetLayout layout, bool pad_columns);
+
+    /// number of elements in the asset's data including any column padding
+    size_t get_data_size() const;
     size_t warmup = 0;      ///< warmup period, i.e. number of rows to skip
 
+    shared_ptr<void> storage_owner = nullptr;   ///< keeps externally owned data alive for zero copy views
+
     optional<double*> volatility = nullopt; ///< optional pointer to a voltaility tracer's value
     optional<double*> beta       = nullopt; ///< optional pointer to a beta tracer's value
 };
@@ -328,9 +749,50 @@ std::shared_ptr<Asset> new_asset(
     size_t warmup = 0    
 );
 
+class ThreadPool;
+
+/**
+ * @brief create and load many assets from python buffers. The assets are created and the buffers
+ *  requested while holding the gil, then the values are copied into each asset across the pool with
+ *  the gil released.
+ *
+ * @param asset_ids         unique id of each asset
+ * @param exchange_id       id of the exchange every asset is listed on
+ * @param broker_id         id of the broker every asset is traded on
+ * @param headers           column names of each asset
+ * @param data              (rows, cols) float64 or float32 values of each asset, any strides
+ * @param datetime_indexes  int64 ns epoch datetime index of each asset
+ * @param warmup            warmup of each asset
+ * @param layout            memory layout to store the values in
+ * @param precision         element type to store the values as
+ * @param thread_pool       pool the values are copied on, nullptr copies them on the calling thread
+ * @return vector of the loaded assets in the order of the ids
+ */
+vector<std::shared_ptr<Asset>> py_load_assets(
+    const vector<string>& asset_ids,
+    const string& exchange_id,
+    const string& broker_id,
+    const vector<vector<string>>& headers,
+    const vector<py::buffer>& data,
+    const vector<py::buffer>& datetime_indexes,
+    size_t warmup,
+    AssetLayout layout,
+    AssetPrecision precision,
+    ThreadPool* thread_pool);
+
 /// function for identifying index locations of open and close column
 tuple<size_t, size_t> parse_headers(const vector<std::string> &columns);
 
+/**
+ * @brief window into an asset's close column of lookback rows behind its current row, or starting
+ *  at the current row with the rows still needed set if the asset has not passed the lookback
+ *
+ * @param asset     asset to read the close column of
+ * @param lookback  number of rows in the window
+ * @return Argus::ArrayWindow<double> window into the close column
+ */
+Argus::ArrayWindow<double> init_array_window(Asset* asset, size_t lookback);
+
 class AssetTracer
 {
 public:
@@ -359,9 +821,33 @@ public:
     // pure virtual function to reset the tracer
     virtual void reset() = 0;
 
+    /// pure virtual function called when a streaming parent moves rows held at old_base to new_base
+    virtual void rebase(double* old_base, double* new_base) = 0;
+
+    /// current value of the tracer
+    virtual double get_value() const = 0;
+
+    /// has the tracer seen enough rows for its value to be read
+    virtual bool get_is_warm() const = 0;
+
+    /// is the tracer's state kept in an exchange's tracer bank, banked tracers are stepped by the
+    /// exchange and not by their parent asset
+    virtual bool get_is_banked() const {return false;}
+
+    /// can the tracer be stepped over several rows at once when read, false if a step reads state
+    /// of another asset that has moved on since
+    virtual bool get_is_deferrable() const {return true;}
+
+    /// number of rows behind the current row read when the tracer is built, streaming parents
+    /// hold at least this many
+    virtual size_t get_history() const {return this->lookback;}
+
     // is the tracer ready to be accessed
     bool is_built(){return this->parent_asset->current_index >= this->lookback;};
 
+    /// name the tracer is read by as a feature
+    string name;
+
 protected:
     /// @brief pointer to the parent asset of the tracer
     Asset* parent_asset;
@@ -385,6 +871,12 @@ public:
     // pure virtual function to reset the tracer
     void reset() override;
 
+    void rebase(double* old_base, double* new_base) override {this->asset_window.rebase(old_base, new_base);}
+
+    double get_value() const override {return this->volatility;}
+
+    bool get_is_warm() const override {return this->asset_window.rows_needed == 0;}
+
     double* get_volatility(){return &this->volatility;}
 
     double volatility = 0;
@@ -413,6 +905,16 @@ public:
     // pure virtual function to reset the tracer
     void reset() override;
 
+    /// only the parent window moves, index assets can not be streamed
+    void rebase(double* old_base, double* new_base) override {this->asset_window.rebase(old_base, new_base);}
+
+    /// each step divides by the index volatility of that step
+    bool get_is_deferrable() const override {return false;}
+
+    double get_value() const override {return this->beta;}
+
+    bool get_is_warm() const override {return this->asset_window.rows_needed == 0;}
+
 private:
     /// pointer to the index asset
     Asset* index_asset;
@@ -0,0 +1,151 @@
+//
+// native binary asset file format, files are memory mapped read only so assets read straight from
+// the page cache and concurrent runs on the same host share physical pages
+//
+
+#ifndef ARGUS_ASSET_FILE_H
+#define ARGUS_ASSET_FILE_H
+
+#include "pch.h"
+#include <cstdint>
+
+#include "asset.h"
+
+using namespace std;
+
+/// extension of binary asset files
+static auto constexpr ASSET_FILE_EXTENSION = ".argus";
+
+/**
+ * @brief fixed size header at the start of a binary asset file. The header is followed by the asset
+ *  id and column names (each a uint32 length followed by the characters), then the datetime index
+ *  and value block, both starting on an ASSET_DATA_ALIGNMENT boundary. Values are stored in the
+ *  native byte order using the asset's layout and precision, column major files keep the column
+ *  padding.
+ *
+ */
+struct AssetFileHeader
+{
+    char magic[8];              ///< file signature, "ARGUSAF\0"
+    uint32_t version;           ///< format version
+    uint32_t layout;            ///< AssetLayout of the value block
+    uint32_t precision;         ///< AssetPrecision of the value block
+    uint32_t reserved;          ///< unused, zero
+    uint64_t rows;              ///< number of rows
+    uint64_t cols;              ///< number of columns
+    uint64_t row_stride;        ///< elements between consecutive rows of a column
+    uint64_t col_stride;        ///< elements between consecutive columns of a row
+    int64_t start_time;         ///< first datetime of the index
+    int64_t end_time;           ///< last datetime of the index
+    uint64_t datetime_offset;   ///< byte offset of the datetime index
+    uint64_t data_offset;       ///< byte offset of the value block
+    uint64_t file_size;         ///< total size of the file in bytes
+};
+
+/// description of a binary asset file read from its header
+struct AssetFileInfo
+{
+    string asset_id;            ///< unique id of the asset
+    vector<string> columns;     ///< ordered column names
+    size_t rows = 0;            ///< number of rows
+    size_t cols = 0;            ///< number of columns
+    size_t row_stride = 0;      ///< elements between consecutive rows of a column
+    size_t col_stride = 0;      ///< elements between consecutive columns of a row
+    AssetLayout layout = AssetLayout::RowMajor; ///< layout of the value block
+    AssetPrecision precision = AssetPrecision::Float64; ///< element type of the value block
+    long long start_time = 0;   ///< first datetime of the index
+    long long end_time = 0;     ///< last datetime of the index
+    size_t datetime_offset = 0; ///< byte offset of the datetime index
+    size_t data_offset = 0;     ///< byte offset of the value block
+};
+
+/**
+ * @brief read only memory mapping of an entire file, unmapped on destruction
+ *
+ */
+class MappedFile
+{
+public:
+    /// map the file at path, throws if it can not be opened or mapped
+    explicit MappedFile(const string& path);
+
+    /// unmap the file
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// pointer to the first byte of the mapping
+    [[nodiscard]] const char* get_data() const {return this->data;}
+
+    /// size of the mapping in bytes
+    [[nodiscard]] size_t get_size() const {return this->size;}
+
+private:
+    const char* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    void* file_handle = nullptr;
+    void* mapping_handle = nullptr;
+#endif
+};
+
+/**
+ * @brief write a loaded asset to a binary asset file
+ *
+ * @param asset     asset to write, must be loaded
+ * @param path      path of the file to create or overwrite
+ */
+void save_asset_file(Asset& asset, const string& path);
+
+/**
+ * @brief read and validate the header of a binary asset file
+ *
+ * @param path              path of the file
+ * @return AssetFileInfo    description of the file
+ */
+AssetFileInfo read_asset_file_info(const string& path);
+
+/**
+ * @brief map a binary asset file and load the asset as a view into the mapping. The headers are
+ *  loaded from the file if the asset has none, otherwise they must match the file's columns. The
+ *  asset id stored in the file is not checked against the asset's.
+ *
+ * @param asset     asset to load, must not be loaded
+ * @param path      path of the file
+ */
+void load_asset_file(Asset& asset, const string& path);
+
+/**
+ * @brief create a new asset from a binary asset file using the asset id stored in the file
+ *
+ * @param path          path of the file
+ * @param exchange_id   unique id of the exchange the asset is on
+ * @param broker_id     unique id of the broker the asset is on
+ * @param warmup        warmup of the asset
+ * @return asset_sp_t   loaded asset
+ */
+Asset::asset_sp_t load_asset_file(
+    const string& path,
+    const string& exchange_id,
+    const string& broker_id,
+    size_t warmup = 0
+);
+
+/**
+ * @brief load every binary asset file in a directory, sorted by file name
+ *
+ * @param path                  directory to load
+ * @param exchange_id           unique id of the exchange the assets are on
+ * @param broker_id             unique id of the broker the assets are on
+ * @param warmup                warmup of each asset
+ * @return vector<asset_sp_t>   loaded assets, ready to be registered
+ */
+vector<Asset::asset_sp_t> load_asset_directory(
+    const string& path,
+    const string& exchange_id,
+    const string& broker_id,
+    size_t warmup = 0
+);
+
+#endif // ARGUS_ASSET_FILE_H
@@ -0,0 +1,230 @@
+//
+// indicator tracers of an asset updated in constant time each step from windows into its columns
+//
+
+#ifndef ARGUS_ASSET_INDICATORS_H
+#define ARGUS_ASSET_INDICATORS_H
+
+#include "pch.h"
+#include <limits>
+
+#include "asset.h"
+#include "containers.h"
+#include "settings.h"
+
+using namespace std;
+
+/// value of an indicator tracer that is not warm or not defined
+static double constexpr INDICATOR_NAN = std::numeric_limits<double>::quiet_NaN();
+
+/**
+ * @brief base of the tracers that read a column of their parent asset. The window's start pointer
+ *  is the oldest row still in the lookback and its end pointer the row entering on the next step.
+ *  Building replays step() over the rows held behind the current row, so a rebuilt tracer follows
+ *  the same arithmetic as one stepped from the start.
+ *
+ */
+class IndicatorTracer : public AssetTracer
+{
+public:
+    IndicatorTracer(Asset* parent_asset_, size_t lookback_, size_t column_index_);
+
+    double get_value() const override {return this->value;}
+
+    bool get_is_warm() const override {return this->count >= this->lookback;}
+
+    void build() override;
+
+    void reset() override {this->build();}
+
+    void rebase(double* old_base, double* new_base) override {this->window.rebase(old_base, new_base);}
+
+protected:
+    /// index of the column read by the tracer
+    size_t column_index;
+
+    /// window into the column
+    Argus::ArrayWindow<double> window;
+
+    /// number of rows stepped since the tracer was built
+    size_t count = 0;
+
+    /// current value of the tracer
+    double value = INDICATOR_NAN;
+
+    /// clear the running state before the rows are replayed
+    virtual void clear() = 0;
+
+    /// point the windows at a row, the first row replayed on build
+    virtual void init_windows(size_t row) {this->window = this->column_window(this->column_index, row);}
+
+    /// empty window into a column of the parent asset starting at a row
+    Argus::ArrayWindow<double> column_window(size_t column, size_t row) const;
+
+    /**
+     * @brief move the window forward one row
+     *
+     * @param in    value of the row entering the window
+     * @param out   value of the row leaving the window if one left
+     * @return true a row left the window
+     */
+    inline bool slide(double& in, double& out)
+    {
+        in = *this->window.end_ptr;
+        this->window.end_ptr += this->window.stride;
+        this->count++;
+        if(this->count <= this->lookback)
+        {
+            return false;
+        }
+        out = *this->window.start_ptr;
+        this->window.start_ptr += this->window.stride;
+        return true;
+    }
+};
+
+/// mean of a column over the lookback from a running sum
+class MovingAverageTracer : public IndicatorTracer
+{
+public:
+    MovingAverageTracer(Asset* parent_asset_, size_t lookback_, size_t column_index_)
+        : IndicatorTracer(parent_asset_, lookback_, column_index_) {}
+
+    AssetTracerType tracer_type() const override {return AssetTracerType::MovingAverage;}
+
+    void step() override;
+
+private:
+    double sum = 0;
+
+    void clear() override {this->sum = 0;}
+};
+
+/**
+ * @brief exponential moving average of a column with smoothing 2 / (lookback + 1), seeded with the
+ *  mean of its first lookback values. It is rebuilt from ARGUS_EMA_HISTORY_LOOKBACKS lookbacks behind
+ *  the current row, so the value after a seek does not depend on where the asset's data starts.
+ *
+ */
+class ExponentialMovingAverageTracer : public IndicatorTracer
+{
+public:
+    ExponentialMovingAverageTracer(Asset* parent_asset_, size_t lookback_, size_t column_index_)
+        : IndicatorTracer(parent_asset_, lookback_, column_index_),
+          alpha(2.0 / (static_cast<double>(lookback_) + 1)) {}
+
+    AssetTracerType tracer_type() const override {return AssetTracerType::ExponentialMovingAverage;}
+
+    void step() override;
+
+private:
+    double alpha;
+    double sum = 0;
+
+    void clear() override {this->sum = 0;}
+
+    size_t get_history() const override {return this->lookback * ARGUS_EMA_HISTORY_LOOKBACKS;}
+};
+
+/**
+ * @brief minimum or maximum of a column over the lookback. Candidates are kept in a monotonic
+ *  queue in a ring of lookback + 1 entries, each value is pushed and popped at most once.
+ *
+ */
+class RollingExtremeTracer : public IndicatorTracer
+{
+public:
+    RollingExtremeTracer(Asset* parent_asset_, size_t lookback_, size_t column_index_, bool is_max_);
+
+    AssetTracerType tracer_type() const override
+    {
+        return this->is_max ? AssetTracerType::RollingMax : AssetTracerType::RollingMin;
+    }
+
+    void step() override;
+
+private:
+    struct Candidate
+    {
+        double value;
+        size_t row;     ///< number of rows stepped before the value entered
+    };
+
+    bool is_max;
+    vector<Candidate> queue;
+    size_t head = 0;
+    size_t size = 0;
+
+    void clear() override {this->head = 0; this->size = 0;}
+};
+
+/**
+ * @brief z-score of the current value of a column against the mean and sample deviation of the
+ *  lookback. The mean and the sum of squared deviations from it are updated with Welford's method,
+ *  which does not subtract the large sums of squares of price levels. The window is summed again
+ *  every lookback rows so rounding from the sliding updates does not build up.
+ *
+ */
+class RollingZScoreTracer : public IndicatorTracer
+{
+public:
+    RollingZScoreTracer(Asset* parent_asset_, size_t lookback_, size_t column_index_);
+
+    AssetTracerType tracer_type() const override {return AssetTracerType::RollingZScore;}
+
+    void step() override;
+
+private:
+    double mean = 0;
+    double m2 = 0;      ///< sum of squared deviations from the mean
+
+    void clear() override {this->mean = 0; this->m2 = 0;}
+
+    /// recompute the mean and squared deviations from the values in the window
+    void resum();
+};
+
+/**
+ * @brief mean true range over the lookback, the true range of a row is the largest of its high to
+ *  low range and the distance of either from the previous close. The window is over the close
+ *  column, the true ranges in it are kept in a ring.
+ *
+ */
+class AverageTrueRangeTracer : public IndicatorTracer
+{
+public:
+    AverageTrueRangeTracer(Asset* parent_asset_, size_t lookback_);
+
+    AssetTracerType tracer_type() const override {return AssetTracerType::AverageTrueRange;}
+
+    void step() override;
+
+    void rebase(double* old_base, double* new_base) override
+    {
+        this->window.rebase(old_base, new_base);
+        this->high_window.rebase(old_base, new_base);
+        this->low_window.rebase(old_base, new_base);
+    }
+
+private:
+    size_t high_column;
+    size_t low_column;
+
+    /// windows into the high and low columns, only their end pointers are read
+    Argus::ArrayWindow<double> high_window;
+    Argus::ArrayWindow<double> low_window;
+
+    vector<double> true_ranges;
+    double previous_close = INDICATOR_NAN;
+    double sum = 0;
+
+    void clear() override {this->sum = 0; this->previous_close = INDICATOR_NAN;}
+
+    /// one row more than the lookback is replayed so the first true range, which may have no
+    /// previous close, has left the ring once the tracer is warm
+    size_t get_history() const override {return this->lookback + 1;}
+
+    void init_windows(size_t row) override;
+};
+
+#endif // ARGUS_ASSET_INDICATORS_H
@@ -0,0 +1,122 @@
+//
+// chunked row sources for streaming assets, a streaming asset holds its full datetime index but only
+// a sliding window of its values
+//
+
+#ifndef ARGUS_ASSET_STREAM_H
+#define ARGUS_ASSET_STREAM_H
+
+#include "pch.h"
+#include <fstream>
+#include <pybind11/pybind11.h>
+
+#include "asset.h"
+#include "asset_file.h"
+
+using namespace std;
+namespace py = pybind11;
+
+/**
+ * @brief source of the rows of a streaming asset. Rows are delivered in order as row major
+ *  float64 values, one value per column of the asset
+ *
+ */
+class AssetChunkSource
+{
+public:
+    explicit AssetChunkSource(size_t cols_) : cols(cols_) {}
+    virtual ~AssetChunkSource() = default;
+
+    /**
+     * @brief copy the next rows of the source into a row major buffer
+     *
+     * @param values    buffer with room for max_rows rows
+     * @param max_rows  maximum number of rows to copy
+     * @return size_t   rows copied, less than max_rows only once the source is exhausted
+     */
+    virtual size_t read(double* values, size_t max_rows) = 0;
+
+    /// skip the next rows without keeping them, reads them into a scratch buffer by default
+    virtual void skip(size_t rows);
+
+    /// rewind the source to its first row
+    virtual void reset() = 0;
+
+    /// number of values in each row
+    [[nodiscard]] size_t get_cols() const {return this->cols;}
+
+    /// true if reads must hold the gil, the asset can then only be stepped on the main thread
+    [[nodiscard]] virtual bool needs_gil() const {return false;}
+
+protected:
+    size_t cols;
+};
+
+/**
+ * @brief reads the value block of a binary asset file with buffered reads instead of mapping it,
+ *  float32 files are widened and column major files are gathered into rows
+ *
+ */
+class AssetFileChunkSource : public AssetChunkSource
+{
+public:
+    /// open the asset file at path, throws if it can not be opened or is not a valid asset file
+    explicit AssetFileChunkSource(const string& path);
+
+    size_t read(double* values, size_t max_rows) override;
+    void skip(size_t rows) override {this->position = std::min(this->position + rows, this->info.rows);}
+    void reset() override {this->position = 0;}
+
+    /// description of the file read from its header
+    [[nodiscard]] AssetFileInfo const & get_info() const {return this->info;}
+
+    /// read the full datetime index of the file
+    [[nodiscard]] vector<long long> read_datetime_index();
+
+private:
+    AssetFileInfo info;
+    std::ifstream file;
+    size_t position = 0;        ///< next row to read
+    vector<char> buffer;        ///< raw bytes of the last read
+
+    /// read count elements starting at an element offset of the value block into the buffer
+    void read_elements(size_t element_offset, size_t count);
+};
+
+/**
+ * @brief rows produced by a python callable. Calling it returns an iterable of 2-D (rows, cols)
+ *  arrays, it is called again each time the source is rewound
+ *
+ */
+class PyChunkSource : public AssetChunkSource
+{
+public:
+    PyChunkSource(py::object chunks_, size_t cols_);
+
+    /// the python references are released holding the gil
+    ~PyChunkSource() override;
+
+    size_t read(double* values, size_t max_rows) override;
+    void reset() override;
+    [[nodiscard]] bool needs_gil() const override {return true;}
+
+private:
+    py::object chunks;          ///< callable returning an iterable of chunks
+    py::object iterator;        ///< iterator over the current pass, none until the first read
+    py::object chunk;           ///< chunk currently being copied out, none if exhausted
+    size_t chunk_offset = 0;    ///< rows of the current chunk already copied
+};
+
+/**
+ * @brief load an asset as a stream over a binary asset file. Only the datetime index and a window
+ *  of rows are held in memory. The headers are loaded from the file if the asset has none,
+ *  otherwise they must match the file's columns.
+ *
+ * @param asset         asset to load, must not be loaded
+ * @param path          path of the file
+ * @param chunk_rows    rows read per refill of the window
+ * @param lookback      rows behind the current row that stay readable
+ */
+void load_asset_file_stream(Asset& asset, const string& path, size_t chunk_rows, size_t lookback);
+
+#endif // ARGUS_ASSET_STREAM_H
@@ -24,9 +24,50 @@ struct CommisionScheme
 
 class Broker;
 
-typedef std::unordered_map<string, shared_ptr<Broker>> Brokers;
 typedef shared_ptr<Broker> broker_sp_t;
 
+/**
+ * @brief the brokers of a hydra keyed by broker id, with a slot per broker symbol so orders are
+ *  routed to their broker without hashing the id
+ *
+ */
+class Brokers
+{
+public:
+    typedef std::unordered_map<string, broker_sp_t> broker_map_t;
+
+    /// add a new broker, the broker id must not already exist
+    void add_broker(const broker_sp_t& broker);
+
+    /// get a broker by id, throws std::out_of_range if it does not exist
+    [[nodiscard]] broker_sp_t const & at(const string& broker_id) const { return this->broker_map.at(broker_id); }
+
+    /// get a broker by symbol, throws if no broker with the symbol was added
+    [[nodiscard]] Broker* get_broker(symbol_t broker_symbol) const
+    {
+        if(broker_symbol >= this->broker_slots.size() || !this->broker_slots[broker_symbol])
+        {
+            ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidId);
+        }
+        return this->broker_slots[broker_symbol];
+    }
+
+    /// number of brokers with the id (0 or 1)
+    [[nodiscard]] size_t count(const string& broker_id) const { return this->broker_map.count(broker_id); }
+
+    broker_map_t::iterator begin() { return this->broker_map.begin(); }
+    broker_map_t::iterator end() { return this->broker_map.end(); }
+    broker_map_t::const_iterator begin() const { return this->broker_map.begin(); }
+    broker_map_t::const_iterator end() const { return this->broker_map.end(); }
+
+private:
+    /// map between broker id and broker
+    broker_map_t broker_map;
+
+    /// brokers indexed by broker symbol
+    vector<Broker*> broker_slots;
+};
+
 class Broker
 {
 
@@ -96,6 +137,15 @@ public:
      */
     void place_order_buffer(shared_ptr<Order> order);
 
+    /// get the orders sent to the exchanges that have not been filled or canceled
+    [[nodiscard]] vector<order_sp_t> const & get_open_orders() const { return this->open_orders; }
+
+    /// get the unique id of the broker
+    [[nodiscard]] string const & get_broker_id() const { return this->broker_id; }
+
+    /// get the interned symbol of the broker id
+    [[nodiscard]] symbol_t get_broker_symbol() const { return this->broker_symbol; }
+
     // void place_limit_order();
     // void place_stop_loss_order();
     // void place_take_profit_order();
@@ -107,6 +157,9 @@ private:
     /// unique id of the broker
     string broker_id;
 
+    /// interned symbol of the broker id
+    symbol_t broker_symbol;
+
     double cash;            ///< cash held at the broker    
     double starting_cash;   ///< starting cash held at the broker
 
@@ -51,6 +51,16 @@ struct ArrayWindow
         this->end_ptr   += stride;
     }
 
+    /**
+     * @brief move the window after the elements it points into were moved from old_base to new_base
+     * 
+     */
+    inline void rebase(T* old_base, T* new_base)
+    {
+        this->start_ptr = new_base + (this->start_ptr - old_base);
+        this->end_ptr   = new_base + (this->end_ptr - old_base);
+    }
+
     /**
      * @brief get the underlying window as a numpy array to return to python wrapper
      * 
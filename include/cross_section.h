@@ -0,0 +1,101 @@
+//
+// cross sectional transforms of a feature over the assets streaming on an exchange
+//
+
+#ifndef ARGUS_CROSS_SECTION_H
+#define ARGUS_CROSS_SECTION_H
+
+#include "pch.h"
+#include <array>
+#include <cstdint>
+#include <limits>
+
+#include "symbol_table.h"
+
+using namespace std;
+
+/// market slot and value of an asset in an exchange wide query
+typedef pair<uint32_t, double> slot_value_t;
+
+/// group of a market slot that has not been assigned one
+constexpr symbol_t CROSS_SECTION_GROUP_NONE = std::numeric_limits<symbol_t>::max();
+
+enum CrossSectionTransform
+{
+    Rank,           ///< 1 based rank, ties get the average of their ranks
+    Percentile,     ///< rank divided by the number of assets ranked
+    ZScore,         ///< value less the mean over the sample standard deviation
+    Winsorize,      ///< value clipped to the lower and upper quantiles
+    GroupDemean     ///< value less the mean of the assets in its group
+};
+
+/// number of cross sectional transforms, each has its own output buffer
+constexpr size_t CROSS_SECTION_TRANSFORMS = 5;
+
+/**
+ * @brief computes cross sectional transforms of (market slot, value) pairs into buffers indexed by
+ *  market slot. Each transform writes its own buffer which is reused from bar to bar, slots that are
+ *  not passed and NaN values are NaN in the output. Groups are interned group label symbols assigned
+ *  to each slot once, slots without a group are demeaned together.
+ *
+ */
+class CrossSection
+{
+public:
+    /// size the buffers for a number of market slots, groups of slots kept are preserved
+    void resize(size_t slots);
+
+    /// number of market slots in each buffer
+    [[nodiscard]] size_t get_slots() const { return this->groups.size(); }
+
+    /// assign the group of a market slot, CROSS_SECTION_GROUP_NONE clears it
+    void set_group(size_t slot, symbol_t group) { this->groups[slot] = group; }
+
+    /// group of a market slot
+    [[nodiscard]] symbol_t get_group(size_t slot) const { return this->groups[slot]; }
+
+    /// output buffer of a transform, valid until the transform is next computed
+    [[nodiscard]] double const * get_output(CrossSectionTransform transform) const
+    {
+        return this->outputs[transform].data();
+    }
+
+    /**
+     * @brief compute a transform into its output buffer
+     *
+     * @param values    market slot and value of each asset in the cross section
+     * @param transform transform to compute
+     * @param lower     lower quantile in [0, 1] the values are clipped to by Winsorize
+     * @param upper     upper quantile in [0, 1] the values are clipped to by Winsorize
+     * @return double const* output buffer of the transform
+     */
+    double const * transform(
+        const vector<slot_value_t>& values,
+        CrossSectionTransform transform,
+        double lower = 0.01,
+        double upper = 0.99);
+
+private:
+    /// output buffer of each transform by market slot
+    std::array<vector<double>, CROSS_SECTION_TRANSFORMS> outputs;
+
+    /// interned group label symbol of each market slot
+    vector<symbol_t> groups;
+
+    /// non NaN values of the current transform
+    vector<slot_value_t> scratch;
+
+    /// sum and count of each group symbol, indexed by symbol with the last entry for slots without one
+    vector<double> group_sums;
+    vector<size_t> group_counts;
+
+    void rank(double* output, bool percentile);
+    void zscore(double* output);
+    void winsorize(double* output, double lower, double upper);
+    void group_demean(double* output);
+
+    /// value at a quantile of the scratch values with linear interpolation, reorders the scratch
+    double quantile(double q);
+};
+
+#endif // ARGUS_CROSS_SECTION_H
@@ -6,11 +6,18 @@
 #define ARGUS_EXCHANGE_H
 #include "pch.h"
 
+#include <bit>
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
 
 #include "asset.h"
+#include "cross_section.h"
 #include "order.h"
+#include "panel.h"
+#include "settings.h"
+#include "thread_pool.h"
+#include "tracer_bank.h"
+#include "trigger_book.h"
 
 #include "pybind11/pytypes.h"
 #include "utils_array.h"
@@ -28,6 +35,54 @@ enum ExchangeQueryType
 
 class ExchangeMap;
 
+/**
+ * @brief market slots keyed by exchange time in compressed rows, the slots at time i are
+ *  slots[offsets[i]] up to slots[offsets[i+1]]
+ *
+ */
+struct SlotSchedule
+{
+    vector<uint32_t> slots;
+    vector<size_t> offsets;
+
+    uint32_t const * begin(size_t time) const { return this->slots.data() + this->offsets[time]; }
+    uint32_t const * end(size_t time) const { return this->slots.data() + this->offsets[time + 1]; }
+};
+
+/// market slot of an asset symbol that is not listed on the exchange
+constexpr uint32_t EXCHANGE_SLOT_NONE = std::numeric_limits<uint32_t>::max();
+
+/**
+ * @brief values of a column read from every streaming asset at one market view, kept so repeated
+ *  exchange wide queries of the same column, scaler and row within a bar skip the reads. The
+ *  selections made from the values are kept as well.
+ *
+ */
+struct ExchangeFeatureCache
+{
+    /// market view step the values were read at, stale once the exchange steps or is reset
+    size_t view_step = 0;
+
+    string column;
+    optional<AssetTracerType> query_scaler;
+    int row = 0;
+
+    /// slot and value of each streaming asset in market slot order
+    vector<slot_value_t> values;
+
+    /// a selection made from the values
+    struct Selection
+    {
+        ExchangeQueryType query_type = ExchangeQueryType::Default;
+        size_t number_assets = 0;
+        vector<slot_value_t> values;    ///< selected slots and values in query order
+    };
+
+    /// selections made from the values, only the first selection_count are live so buffers are reused
+    vector<Selection> selections;
+    size_t selection_count = 0;
+};
+
 class Exchange
 {
 friend class ExchangeMap;  
@@ -66,6 +121,9 @@ public:
     /// build the market view, return false if all assets listed are done streaming
     bool get_market_view();
 
+    /// step the assets of a bar on a thread pool, nullptr steps them on the calling thread
+    void set_thread_pool(shared_ptr<ThreadPool> thread_pool_) { this->thread_pool = std::move(thread_pool_); }
+
     /**
      * @brief register a new index asset to the exchange. Index asset must have the same datetime
      *  index as the exchange and is used to set the beta of indivual asset's listed on the exchange.
@@ -84,13 +142,29 @@ public:
     void move_expired_assets();
 
     /**
-     * @brief add a new tracer to all assets listed on the exchange
+     * @brief add a new tracer to all assets listed on the exchange. Volatility tracers are kept in
+     *  the exchange's volatility bank and stepped together, every asset's volatility has the same lookback.
      * 
      * @param tracer_type       type of tracer to add
      * @param lookback          lookback of the tracer
      * @param adjust_warmup     wether to adjust the asset's warmup
+     * @param column            column the tracer reads, the close if empty (see Asset::add_tracer)
+     * @param name              name the tracer is read by as a feature, generated if empty
      */
-    void add_tracer(AssetTracerType tracer_type, size_t lookback, bool adjust_warmup);
+    void add_tracer(
+        AssetTracerType tracer_type,
+        size_t lookback,
+        bool adjust_warmup,
+        const string& column = "",
+        const string& name = "");
+
+    /**
+     * @brief step the tracers of the listed assets only when they are read (see Asset::set_lazy_tracers).
+     *  The volatility bank is then stepped slot by slot by the assets that are read.
+     *
+     * @param lazy_tracers_ step the tracers only when they are read
+     */
+    void set_lazy_tracers(bool lazy_tracers_);
 
     /**
      * @brief get a list of asset's that have expired in the current time step
@@ -105,6 +179,12 @@ public:
     /// place order to the exchange
     void place_order(shared_ptr<Order> &order);
 
+    /// remove an open order from the orders resting on the exchange
+    void cancel_order(const shared_ptr<Order> &order);
+
+    /// number of open orders resting on the exchange
+    [[nodiscard]] size_t get_open_order_count() const { return this->trigger_book.get_orders(); }
+
     /// set wether or not currently at close or open of time step
     void set_on_close(bool on_close_) { this->on_close = on_close_; }
 
@@ -120,6 +200,56 @@ public:
     /// get read only pointer to datetime index
     long long const * get_datetime_index() { return this->datetime_index; }
 
+    /// get read only reference to the current market view by market slot (asset pointer is nullptr if not streaming)
+    vector<Asset *> const & get_market_view_slots() const { return this->market_view; }
+
+    /// get the asset streaming at the current time by symbol, nullptr if it is not streaming or not listed
+    [[nodiscard]] Asset* get_market_view_asset(symbol_t asset_symbol) const
+    {
+        if(asset_symbol >= this->symbol_slots.size() || this->symbol_slots[asset_symbol] == EXCHANGE_SLOT_NONE)
+        {
+            return nullptr;
+        }
+        return this->market_view[this->symbol_slots[asset_symbol]];
+    }
+
+    /// get the asset streaming at the current time by id, nullptr if it is not streaming or not listed
+    [[nodiscard]] Asset* get_market_view_asset(const string& asset_id) const
+    {
+        auto asset_symbol = SymbolTable::get(SymbolType::Asset).find(asset_id);
+        return asset_symbol.has_value() ? this->get_market_view_asset(asset_symbol.value()) : nullptr;
+    }
+
+    /**
+     * @brief call func(asset) for each asset streaming at the current time in market slot order,
+     *  iteration stops early if func returns false
+     * 
+     */
+    template<typename Func>
+    void for_each_streaming(Func&& func) const
+    {
+        this->for_each_streaming_slot([&](uint32_t, Asset* asset) { return func(asset); });
+    }
+
+    /// for_each_streaming calling func(slot, asset) with the market slot of each asset
+    template<typename Func>
+    void for_each_streaming_slot(Func&& func) const
+    {
+        for(size_t word = 0; word < this->market_view_bits.size(); word++)
+        {
+            auto bits = this->market_view_bits[word];
+            while(bits)
+            {
+                auto slot = static_cast<uint32_t>(word * 64 + std::countr_zero(bits));
+                if(!func(slot, this->market_view[slot]))
+                {
+                    return;
+                }
+                bits &= bits - 1;
+            }
+        }
+    }
+
     /// move exchange to specific point in time
     void goto_datetime(long long datetime);
 
@@ -132,9 +262,29 @@ public:
     /// return the number of rows in the asset
     [[nodiscard]] size_t get_rows() const { return this->datetime_index_length; }
 
+    /// does any asset on the exchange have its last row at an exchange time
+    [[nodiscard]] bool has_expirations(size_t time) const
+    {
+        return this->expire_schedule.offsets[time + 1] != this->expire_schedule.offsets[time];
+    }
+
     /// get a values from asset data by column and row, (index 0 is current, row -1 is previous row)
     optional<double> get_asset_feature(const string& asset_id, const string& column, int index = 0);
 
+    /// get a values from asset data by feature handle and row, (index 0 is current, row -1 is previous row)
+    optional<double> get_asset_feature(const string& asset_id, const FeatureHandle& handle, int index = 0);
+
+    /**
+     * @brief resolve a column for repeated exchange wide queries. If every listed asset has the column
+     *  at the same index the handle holds that index, if the exchange's panel holds the column the handle
+     *  holds its panel index (resolve after the exchange is built to pick it up).
+     * 
+     * @param column the name of the column, every asset on the exchange must have it
+     * @param query_scaler optional tracer to divide values read through the handle by
+     * @return FeatureHandle 
+     */
+    FeatureHandle get_feature_handle(const string& column, optional<AssetTracerType> query_scaler = nullopt) const;
+
     /**
      * @brief Get asset feature for every asset listed on the exchange. 
      *  - Every asset on the exchange must have the passed column
@@ -154,10 +304,138 @@ public:
         int N = -1
     );
 
-    inline double get_market_price(const string &asset_id)
+    /// get asset feature for every asset listed on the exchange through a resolved feature handle
+    py::dict get_exchange_feature(
+        const FeatureHandle& handle, 
+        int row = 0, 
+        ExchangeQueryType query_type   =  ExchangeQueryType::Default,
+        int N = -1
+    );
+
+    /**
+     * @brief same query as get_exchange_feature returned as a pair of arrays instead of a dict, the
+     *  market slot of each selected asset (see get_slot_asset_ids) and its value, in query order.
+     * 
+     * @param handle resolved feature handle of the column to query
+     * @param row the index of the row to get, 0 is current, -1 is previous, etc.
+     * @param query_type the type of the query
+     * @param N number of assets to query, defaults to -1 which returns all
+     * @return py::tuple (uint32 slot array, float64 value array)
+     */
+    py::tuple get_exchange_feature_array(
+        const FeatureHandle& handle, 
+        int row = 0, 
+        ExchangeQueryType query_type   =  ExchangeQueryType::Default,
+        int N = -1
+    );
+
+    /// get_exchange_feature_array by column name
+    py::tuple get_exchange_feature_array(
+        const string& column, 
+        int row = 0, 
+        ExchangeQueryType query_type   =  ExchangeQueryType::Default,
+        optional<AssetTracerType> query_scaler = nullopt,
+        int N = -1
+    );
+
+    /**
+     * @brief select assets streaming at the current time by the value of a feature. The values read
+     *  and the selection are cached until the market view next changes, so repeating a query within a
+     *  bar does no work.
+     * 
+     * @return vector<slot_value_t> const& slots and values in query order, valid until the next query
+     */
+    vector<slot_value_t> const & select_exchange_feature(
+        const FeatureHandle& handle, 
+        int row = 0, 
+        ExchangeQueryType query_type   =  ExchangeQueryType::Default,
+        int N = -1
+    );
+
+    /// ids of the listed assets by market slot, valid once the exchange is built
+    [[nodiscard]] vector<string> get_slot_asset_ids() const;
+
+    /**
+     * @brief assign an asset listed on the exchange to a group used by GroupDemean cross sections.
+     *  Labels are interned once, assets without a group are demeaned together.
+     * 
+     * @param asset_id id of the listed asset
+     * @param group group label, e.g. the asset's sector
+     */
+    void set_asset_group(const string& asset_id, const string& group);
+
+    /**
+     * @brief compute a cross sectional transform of a feature over the assets streaming at the current
+     *  time. The result is written into a buffer indexed by market slot (see get_slot_asset_ids) that
+     *  is reused every time the transform is computed, slots not streaming are NaN.
+     * 
+     * @param handle resolved feature handle of the column to transform
+     * @param transform the transform to compute
+     * @param row the index of the row to read, 0 is current, -1 is previous, etc.
+     * @param lower lower quantile values are clipped to by Winsorize
+     * @param upper upper quantile values are clipped to by Winsorize
+     * @return double const* the transform's buffer, valid until the transform is next computed
+     */
+    double const * transform_cross_section(
+        const FeatureHandle& handle,
+        CrossSectionTransform transform,
+        int row = 0,
+        double lower = 0.01,
+        double upper = 0.99
+    );
+
+    /// (slots,) copy of a cross sectional transform's buffer, use transform_cross_section to read
+    /// the buffer without copying
+    py::array_t<double> get_cross_section(
+        const FeatureHandle& handle,
+        CrossSectionTransform transform,
+        int row = 0,
+        double lower = 0.01,
+        double upper = 0.99
+    );
+
+    /// get_cross_section by column name
+    py::array_t<double> get_cross_section(
+        const string& column,
+        CrossSectionTransform transform,
+        int row = 0,
+        optional<AssetTracerType> query_scaler = nullopt,
+        double lower = 0.01,
+        double upper = 0.99
+    );
+
+    /**
+     * @brief pack every asset listed on the exchange into a contiguous panel on the next build
+     *  (see ExchangePanel). Cross sectional queries of packed columns then scan a single row
+     * 
+     * @param columns columns to pack, empty packs the columns shared by every asset
+     */
+    void enable_panel(vector<string> columns = {});
+
+    /// get read only reference to the exchange's panel
+    [[nodiscard]] ExchangePanel const & get_panel() const { return this->panel; }
+
+    /// get the panel row of the current exchange time offset by row (0 is current, -1 is previous, ...)
+    [[nodiscard]] size_t get_panel_time(int row = 0) const;
+
+    /// read only zero copy (times, assets) view of a packed column, the view outlives the exchange
+    /// (see ExchangePanel for how views behave across rebuilds)
+    py::array_t<double> get_panel_view(const string& column) const
+    {
+        return this->panel.get_column_view(column);
+    }
+
+    /// read only zero copy (assets,) view of a packed column at the current time offset by row, the
+    /// view outlives the exchange
+    py::array_t<double> get_panel_row_view(const string& column, int row = 0) const
+    {
+        return this->panel.get_row_view(column, this->get_panel_time(row));
+    }
+
+    inline double get_market_price(symbol_t asset_symbol)
     {
         // get pointer to asset, nullptr if asset is not currently streaming
-        auto asset_raw_pointer = this->market_view.at(asset_id);
+        auto asset_raw_pointer = this->get_market_view_asset(asset_symbol);
         if (asset_raw_pointer)
         {
             return asset_raw_pointer->get_market_price(this->on_close);
@@ -177,6 +455,9 @@ private:
     /// unique id of the exchange
     string exchange_id;
 
+    /// interned symbol of the exchange id
+    symbol_t exchange_symbol;
+
     /**
      * @brief a smart pointer to a asset representing the index of the exchange
      *  - index asset must have a datetime index equivalent to the exchange and can 
@@ -184,14 +465,63 @@ private:
      */
     optional<asset_sp_t> index_asset = nullopt;
 
-    /// mapping for asset's available at the current moment;
-    std::unordered_map<string, Asset *> market_view;
+    /// listed assets by market slot, slots are assigned on build in asset id order
+    vector<asset_sp_t> market_slots;
+
+    /// market slot of each asset symbol listed on the exchange, EXCHANGE_SLOT_NONE for the others
+    vector<uint32_t> symbol_slots;
+
+    /// asset in each market slot if it is streaming at the current time, else nullptr
+    vector<Asset *> market_view;
+
+    /// bitset over the market slots of the assets streaming at the current time
+    vector<uint64_t> market_view_bits;
+
+    /// incremented every time the market view changes, exchange feature caches of older steps are stale
+    size_t view_step = 1;
+
+    /// per bar caches of exchange wide queries, replaced round robin once full
+    vector<ExchangeFeatureCache> feature_caches;
+    size_t feature_cache_next = 0;
+
+    /// buffers of the cross sectional transforms and the group of each market slot
+    CrossSection cross_section;
+
+    /// interned group label of the assets assigned one, applied to the market slots on build
+    unordered_map<symbol_t, symbol_t> asset_groups;
+
+    /// slots of the assets that step at each exchange time
+    SlotSchedule step_schedule;
+
+    /// slots of the assets that come into view at each exchange time, they did not step at the previous time
+    SlotSchedule enter_schedule;
+
+    /// slots of the assets that leave the view at each exchange time, they stepped at the previous time only
+    SlotSchedule leave_schedule;
+
+    /// slots of the assets whose last row is at each exchange time
+    SlotSchedule expire_schedule;
+
+    /// false after the market view is reset until every asset stepping at the next time is set in view
+    bool view_synced = false;
+
+    /// optional pool the assets of a bar are stepped on
+    shared_ptr<ThreadPool> thread_pool = nullptr;
+
+    /// true if every listed asset can be stepped off the main thread, set on build
+    bool parallel_step = false;
 
     /// container for storing asset_id's that have finished streaming
     vector<asset_sp_t> expired_assets;
 
-    /// open orders on the exchange
-    vector<shared_ptr<Order>> open_orders;
+    /// open orders resting on the exchange by market slot and trigger price
+    TriggerBook trigger_book;
+
+    /// volatility tracers of the listed assets by market slot, set by add_tracer
+    shared_ptr<VolatilityBank> volatility_bank = nullptr;
+
+    /// are the tracers of the listed assets stepped only when read
+    bool lazy_tracers = false;
 
     /// current exchange time
     long long exchange_time;
@@ -205,6 +535,30 @@ private:
     /// current position in datetime index
     size_t current_index;
 
+    /// pack the assets into the panel on build
+    bool panel_enabled = false;
+
+    /// columns to pack into the panel, empty for the columns shared by every asset
+    vector<string> panel_columns;
+
+    /// panel of the assets listed on the exchange, built if enabled
+    ExchangePanel panel;
+
+    /// assign market slots to the listed assets and build the step and expire schedules
+    void build_schedule();
+
+    /// clear the market view, assets alligned with the exchange stay in view
+    void reset_market_view();
+
+    /// fill the exchange feature query values from the panel, false if the panel can not answer the query
+    bool get_panel_feature(
+        const FeatureHandle& handle,
+        int row,
+        vector<slot_value_t>& values) const;
+
+    /// find the cache holding a handle's values at the current market view, reading them if there is none
+    ExchangeFeatureCache& get_feature_cache(const FeatureHandle& handle, int row);
+
     /**
      * @brief register a new asset on the exchange, only to be called through the friend ExchangeMap class
      * 
@@ -242,6 +596,12 @@ public:
     /// mapping between asset id and asset pointer
     std::unordered_map<string, asset_sp_t> asset_map;
 
+    /// exchanges indexed by exchange symbol, nullptr for symbols not on this map
+    vector<Exchange*> exchange_slots;
+
+    /// assets indexed by asset symbol, nullptr for symbols not on this map
+    vector<Asset*> asset_slots;
+
     /// wether the exchanges are on the close step or open
     bool on_close = false;
 
@@ -253,6 +613,13 @@ public:
      */
     void register_asset(const shared_ptr<Asset>& asset_, const string& exchange_id_);
 
+    /**
+     * @brief register a new exchange to the exchange map
+     * 
+     * @param exchange_  shared pointer to the new exchange
+     */
+    void register_exchange(const exchange_sp_t& exchange_);
+
     /**
      * @brief get an existing asset on the exchange map
      * 
@@ -269,6 +636,26 @@ public:
      */
     optional<exchange_sp_t> get_exchange(const string& exchange_id_);
 
+    /// get an asset on the exchange map by symbol, throws if it is not on the map
+    [[nodiscard]] Asset* get_asset(symbol_t asset_symbol) const
+    {
+        if(asset_symbol >= this->asset_slots.size() || !this->asset_slots[asset_symbol])
+        {
+            ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidId);
+        }
+        return this->asset_slots[asset_symbol];
+    }
+
+    /// get an exchange on the exchange map by symbol, throws if it is not on the map
+    [[nodiscard]] Exchange* get_exchange(symbol_t exchange_symbol) const
+    {
+        if(exchange_symbol >= this->exchange_slots.size() || !this->exchange_slots[exchange_symbol])
+        {
+            ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidId);
+        }
+        return this->exchange_slots[exchange_symbol];
+    }
+
     /// get market price of asset
     double get_market_price(const string& asset_id);
 
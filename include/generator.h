@@ -0,0 +1,74 @@
+//
+// synthetic market data generator used for scale testing and benchmarks
+//
+
+#ifndef ARGUS_GENERATOR_H
+#define ARGUS_GENERATOR_H
+
+#include "pch.h"
+
+#include "asset.h"
+
+using namespace std;
+
+/**
+ * @brief parameters of a synthetic universe of assets. Every asset follows an independent seeded
+ *  random walk, open and close columns are required and any column other than open, high, low,
+ *  close and volume is filled with standard normal noise
+ *
+ */
+struct UniverseConfig
+{
+    size_t assets = 100;                                    ///< number of assets in the universe
+    size_t rows = 1000;                                     ///< number of rows spanned by the universe
+    vector<string> columns = {"open", "close"};             ///< columns of each asset
+    double gap = 0.0;                                       ///< max fraction of rows an asset can list late and delist early by
+    unsigned long long seed = 0;                            ///< seed of the universe, asset i is seeded from seed and i
+    long long start_time = 946684800000000000LL;            ///< epoch time of the first row (2000-01-01)
+    long long spacing = 86400000000000LL;                   ///< ns between rows (1 day)
+    double drift = 0.0002;                                  ///< mean return per row
+    double volatility = 0.01;                               ///< standard deviation of the return per row
+    string prefix = "ASSET";                                ///< asset ids are prefix followed by the asset number
+    size_t warmup = 0;                                      ///< warmup of each asset
+    AssetLayout layout = AssetLayout::RowMajor;             ///< memory layout of each asset's data
+    AssetPrecision precision = AssetPrecision::Float64;     ///< element type of each asset's data
+};
+
+/**
+ * @brief generate a single synthetic asset, values are written directly into the asset's storage
+ *
+ * @param asset_id      unique id of the asset
+ * @param exchange_id   unique id of the exchange the asset is on
+ * @param broker_id     unique id of the broker the asset is on
+ * @param rows          number of rows in the asset
+ * @param start_row     offset of the first row from the config start time
+ * @param seed          seed of the random walk
+ * @param config        universe config holding the columns, timing and walk parameters
+ * @return asset_sp_t   loaded asset
+ */
+Asset::asset_sp_t generate_asset(
+    const string& asset_id,
+    const string& exchange_id,
+    const string& broker_id,
+    size_t rows,
+    size_t start_row,
+    unsigned long long seed,
+    const UniverseConfig& config
+);
+
+/**
+ * @brief generate a universe of synthetic assets. If the config gap is non zero each asset lists
+ *  and delists at a random row so the assets' datetime indexes are unaligned with the universe
+ *
+ * @param exchange_id           unique id of the exchange the assets are on
+ * @param broker_id             unique id of the broker the assets are on
+ * @param config                parameters of the universe
+ * @return vector<asset_sp_t>   loaded assets, ready to be registered
+ */
+vector<Asset::asset_sp_t> generate_universe(
+    const string& exchange_id,
+    const string& broker_id,
+    const UniverseConfig& config
+);
+
+#endif // ARGUS_GENERATOR_H
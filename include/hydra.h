@@ -14,6 +14,7 @@
 #include "portfolio.h"
 #include "broker.h"
 #include "strategy.h"
+#include "profiler.h"
 
 using namespace std;
 
@@ -52,6 +53,37 @@ private:
     // function calls on open
     vector<shared_ptr<Strategy>> strategies;
 
+    /// phase timers of the event loop
+    Profiler profiler;
+
+    /// pool the exchanges step their assets on, nullptr if the assets are stepped on the main thread
+    shared_ptr<ThreadPool> thread_pool = nullptr;
+
+    /// build every exchange, across the thread pool if there is one
+    void build_exchanges();
+
+    /// exchanges in exchange map order, the schedules below hold positions into it
+    vector<Exchange*> step_exchanges;
+
+    /// positions of the exchanges with a row at each hydra time
+    SlotSchedule tick_schedule;
+
+    /// positions of the exchanges with assets on their last row at each hydra time
+    SlotSchedule expire_schedule;
+
+    /// map every exchange row onto the hydra datetime index and build the schedules
+    void build_schedules();
+
+    /// flag allocations in the forward and backward pass as violations
+    bool alloc_strict = false;
+
+    /// number of steps before strict allocation checks begin
+    size_t alloc_strict_warmup = 1;
+
+    /// number of allocations and bytes allocated in each step of a run (ARGUS_ALLOC_TRACKING only)
+    vector<size_t> step_allocations;
+    vector<size_t> step_bytes;
+
     void log(const string& msg);
 
 public:
@@ -69,7 +101,7 @@ public:
     /// mapping between broker id and smart pointer to a broker
     brokers_sp_t brokers{};
     
-    /// build all members
+    /// build all members, called from python with the gil released
     void build();
 
     /// reset all members
@@ -168,6 +200,55 @@ public:
     /// @brief total number of rows loaded
     size_t get_candles(){return this->candles;}
 
+    /**
+     * @brief set the number of threads the assets of each bar are stepped on. The main thread is
+     *  one of them, 1 steps the assets on the main thread only.
+     *
+     * @param threads number of threads, 0 uses the hardware concurrency
+     */
+    void set_threads(size_t threads);
+
+    /// @brief number of threads the assets of each bar are stepped on
+    size_t get_threads() const {return this->thread_pool ? this->thread_pool->get_workers() : 1;}
+
+    /**
+     * @brief get the event loop profile. Returns a dict with "phases" mapping phase name to its counters
+     *  (calls, total_ns, mean_ns, max_ns, histogram), "strategies" mapping strategy id to its on_open and
+     *  on_close counters, and "bucket_edges_ns" holding the upper bound of each histogram bucket.
+     *  Passes include the time of the phases nested inside of them.
+     *
+     * @return py::dict profile of all runs since the last reset
+     */
+    py::dict get_profile();
+
+    /// @brief clear the event loop profile
+    void reset_profile();
+
+    /// @brief get the counter of a single event loop phase
+    PhaseCounter const & get_phase_profile(ProfilePhase phase) {return this->profiler.get_phase(phase);}
+
+    /**
+     * @brief enable strict allocation checks, any allocation made in the forward or backward pass
+     *  once the warmup steps have passed is counted as a violation (ARGUS_ALLOC_TRACKING only)
+     *
+     * @param strict        enable strict mode
+     * @param warmup_steps  number of steps to run before allocations are flagged
+     */
+    void set_alloc_strict(bool strict, size_t warmup_steps = 1);
+
+    /**
+     * @brief get the allocation profile. Returns a dict with "enabled", "phases" mapping phase name to
+     *  allocations, bytes, frees and violations, "total", "violations" and numpy arrays "step_allocations"
+     *  and "step_bytes" holding the allocations made in each step of the run. The tracker is shared by
+     *  every hydra in the process.
+     *
+     * @return py::dict allocation profile since the last reset
+     */
+    py::dict get_alloc_profile();
+
+    /// @brief clear the allocation profile
+    void reset_alloc_profile();
+
     /// @brief get numpy array read only view into the simulations's datetime index
     py::array_t<long long> get_datetime_index_view();
     
@@ -185,6 +266,32 @@ public:
      */
     void register_asset(const asset_sp_t &asset, const string & exchange_id);
 
+    /**
+     * @brief load many assets from python buffers and register them to an exchange. The values are
+     *  copied on the hydra's thread pool with the gil released, registration is serial.
+     * 
+     * @param asset_ids         unique id of each asset
+     * @param exchange_id       the unique id of the exchange to register them to
+     * @param broker_id         the unique id of the broker the assets are traded on
+     * @param headers           column names of each asset
+     * @param data              (rows, cols) float64 or float32 values of each asset
+     * @param datetime_indexes  int64 ns epoch datetime index of each asset
+     * @param warmup            warmup of each asset
+     * @param layout            memory layout to store the values in
+     * @param precision         element type to store the values as
+     * @return vector of the registered assets
+     */
+    vector<asset_sp_t> register_assets(
+        const vector<string>& asset_ids,
+        const string& exchange_id,
+        const string& broker_id,
+        const vector<vector<string>>& headers,
+        const vector<py::buffer>& data,
+        const vector<py::buffer>& datetime_indexes,
+        size_t warmup = 0,
+        AssetLayout layout = AssetLayout::RowMajor,
+        AssetPrecision precision = AssetPrecision::Float64);
+
     /**
      * @brief register a new index asset to an exhcnage or all exchanges
      * 
@@ -9,6 +9,7 @@ class Trade;
 class Portfolio;
 
 #include "pch.h"
+#include "symbol_table.h"
 
 using namespace std;
 
@@ -155,24 +156,28 @@ private:
     /// limit use for stop loss and take profit orders
     double limit;
 
-    /// unique id of the underlying asset of the order
-    string asset_id;
+    /// symbol of the underlying asset of the order
+    symbol_t asset_symbol;
 
-    /// unique id of the exchange that the asset is on
-    string exchange_id;
+    /// symbol of the exchange that the asset is on
+    symbol_t exchange_symbol;
 
-    /// unique id of the broker to place the order to
-    string broker_id;
+    /// symbol of the broker to place the order to
+    symbol_t broker_symbol;
 
-    /// unique id of the strategy the order was placed by
-    string strategy_id;
+    /// symbol of the strategy the order was placed by
+    symbol_t strategy_symbol;
 
 public:
     typedef shared_ptr<Order> order_sp_t;
 
-    /// order constructor
-    Order(OrderType order_type_, string asset_id_, double units_, string exchange_id_,
-          string broker_id_, Portfolio* source_portfolio, string strategy_id_, int trade_id_);
+    /// order constructor, interns the ids of the order
+    Order(OrderType order_type_, const string& asset_id_, double units_, const string& exchange_id_,
+          const string& broker_id_, Portfolio* source_portfolio, const string& strategy_id_, int trade_id_);
+
+    /// order constructor from already interned symbols
+    Order(OrderType order_type_, symbol_t asset_symbol_, double units_, symbol_t exchange_symbol_,
+          symbol_t broker_symbol_, Portfolio* source_portfolio, symbol_t strategy_symbol_, int trade_id_);
 
     void cancel_child_order(size_t order_id);
 
@@ -180,16 +185,28 @@ public:
     [[nodiscard]] size_t get_order_id() const { return this->order_id; }
 
     /// get the unique id of the exchange the order was placed to
-    [[nodiscard]] string get_exchange_id() const { return this->exchange_id; }
+    [[nodiscard]] string const & get_exchange_id() const { return get_symbol_id(SymbolType::Exchange, this->exchange_symbol); }
 
     /// get the unique asset id of the order
-    [[nodiscard]] string const & get_asset_id() const { return this->asset_id; }
+    [[nodiscard]] string const & get_asset_id() const { return get_symbol_id(SymbolType::Asset, this->asset_symbol); }
 
     /// get the unique broker id of the broker the order was placed to
-    [[nodiscard]] string const & get_broker_id() const { return this->broker_id; }
+    [[nodiscard]] string const & get_broker_id() const { return get_symbol_id(SymbolType::Broker, this->broker_symbol); }
 
     /// get the unique strategy id of the strategy that placed the order
-    [[nodiscard]] string const & get_strategy_id() const { return this->strategy_id; }
+    [[nodiscard]] string const & get_strategy_id() const { return get_symbol_id(SymbolType::Strategy, this->strategy_symbol); }
+
+    /// get the symbol of the exchange the order was placed to
+    [[nodiscard]] symbol_t get_exchange_symbol() const { return this->exchange_symbol; }
+
+    /// get the symbol of the asset of the order
+    [[nodiscard]] symbol_t get_asset_symbol() const { return this->asset_symbol; }
+
+    /// get the symbol of the broker the order was placed to
+    [[nodiscard]] symbol_t get_broker_symbol() const { return this->broker_symbol; }
+
+    /// get the symbol of the strategy that placed the order
+    [[nodiscard]] symbol_t get_strategy_symbol() const { return this->strategy_symbol; }
 
     /// get the unique portfolio id of the portfolio the order was placed to
     [[nodiscard]] Portfolio* get_source_portfolio() const { return this->source_portfolio; }
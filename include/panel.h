@@ -0,0 +1,106 @@
+//
+// exchange wide panel of asset values packed against the exchange datetime index
+//
+
+#ifndef ARGUS_PANEL_H
+#define ARGUS_PANEL_H
+
+#include "pch.h"
+#include <cstdint>
+#include <pybind11/numpy.h>
+
+#include "asset.h"
+
+using namespace std;
+namespace py = pybind11;
+
+/**
+ * @brief contiguous copy of the columns of every asset listed on an exchange. Each column is a
+ *  [time][asset] matrix over the exchange datetime index, so a cross section is a single contiguous
+ *  row. Rows are padded to a cache line, bars an asset does not have are NaN and cleared in the
+ *  validity bitmap. Values of float32 assets are widened.
+ *
+ *  Views share ownership of the value block. A rebuild that keeps the number of columns, rows and
+ *  asset slots refills the block in place so views read the rebuilt values, a rebuild that changes
+ *  the shape allocates a new block and views taken before it keep the old values.
+ *
+ */
+class ExchangePanel
+{
+public:
+    ExchangePanel() = default;
+
+    ExchangePanel(const ExchangePanel&) = delete;
+    ExchangePanel& operator=(const ExchangePanel&) = delete;
+
+    /**
+     * @brief pack the assets against a datetime index, replaces any previous contents. The value
+     *  block is reused if its shape is unchanged
+     *
+     * @param assets            assets to pack, slots are assigned in the passed order
+     * @param datetime_index    sorted datetime index every asset's rows (after warmup) are in
+     * @param times             length of the datetime index
+     * @param columns           columns to pack, empty packs the columns shared by every asset
+     */
+    void build(
+        const vector<Asset*>& assets,
+        long long const * datetime_index,
+        size_t times,
+        vector<string> columns = {});
+
+    [[nodiscard]] size_t get_assets() const {return this->asset_ids.size();}   ///< number of asset slots
+    [[nodiscard]] size_t get_times() const {return this->times;}               ///< number of rows in each column
+    [[nodiscard]] size_t get_asset_stride() const {return this->asset_stride;} ///< elements between consecutive rows
+    [[nodiscard]] bool get_is_built() const {return this->values != nullptr;}  ///< has the panel been built
+
+    /// ids of the asset in each slot
+    [[nodiscard]] vector<string> const & get_asset_ids() const {return this->asset_ids;}
+
+    /// names of the packed columns
+    [[nodiscard]] vector<string> const & get_columns() const {return this->columns;}
+
+    /// index of a packed column, nullopt if the column was not packed
+    [[nodiscard]] optional<size_t> get_column_index(const string& column) const;
+
+    /// pointer to the cross section of a column at a row of the datetime index
+    [[nodiscard]] double const * get_row(size_t column_index, size_t time) const
+    {
+        return this->values.get() + (column_index * this->times + time) * this->asset_stride;
+    }
+
+    /// does the asset in a slot have a bar at a row of the datetime index
+    [[nodiscard]] bool is_valid(size_t time, size_t slot) const
+    {
+        return (this->valid[time * this->valid_words + slot / 64] >> (slot % 64)) & 1;
+    }
+
+    /// read only zero copy (times, assets) view of a column, the view keeps the value block alive
+    py::array_t<double> get_column_view(const string& column) const;
+
+    /// read only zero copy (assets,) view of a column at a row of the datetime index, the view keeps
+    /// the value block alive
+    py::array_t<double> get_row_view(const string& column, size_t time) const;
+
+    /// (times, assets) boolean copy of the validity bitmap
+    py::array_t<bool> get_valid_view() const;
+
+private:
+    shared_ptr<double> values;              ///< [column][time][asset] values, cache line aligned
+    size_t values_size = 0;                 ///< number of elements in the value block
+    vector<uint64_t> valid;                 ///< [time][asset] validity bits
+    size_t valid_words = 0;                 ///< 64 bit words per row of the bitmap
+    size_t times = 0;                       ///< rows in each column
+    size_t asset_stride = 0;                ///< asset slots per row including padding
+
+    vector<string> asset_ids;               ///< id of the asset in each slot
+    vector<string> columns;                 ///< packed columns
+    unordered_map<string, size_t> column_indices;   ///< map between column name and column index
+
+    /// python object holding a reference to the value block, the base of every view
+    py::object values_owner() const;
+
+    /// index of a packed column, throws if the column was not packed
+    size_t require_column(const string& column) const;
+};
+
+#endif // ARGUS_PANEL_H
@@ -6,6 +6,7 @@
 #include <mutex>
 
 class Broker;
+class Brokers;
 #include "order.h"
 #include "trade.h"
 #include "position.h"
@@ -34,9 +35,9 @@ public:
     using order_sp_t = Order::order_sp_t;
 
     typedef shared_ptr<Portfolio> portfolio_sp_t;
-    typedef std::unordered_map<std::string, position_sp_t> positions_map_t;
+    typedef std::unordered_map<symbol_t, position_sp_t> positions_map_t;
     typedef std::unordered_map<std::string, portfolio_sp_t> portfolios_map_t;
-    typedef shared_ptr<std::unordered_map<string, shared_ptr<Broker>>> brokers_sp_t;
+    typedef shared_ptr<Brokers> brokers_sp_t;
 
     /// portfolio constructor
     /// @param logging logging level
@@ -84,7 +85,10 @@ public:
     /// does the portfolio contain a position with the given asset id
     /// @param asset_id unique id of the asset
     /// \return does the position exist
-    [[nodiscard]] bool position_exists(const string &asset_id) const { return this->positions_map.count(asset_id); };
+    [[nodiscard]] bool position_exists(const string &asset_id) const;
+
+    /// does the portfolio contain a position with the given asset symbol
+    [[nodiscard]] bool position_exists(symbol_t asset_symbol) const { return this->positions_map.count(asset_symbol); };
 
     /// @brief get sp to portfolio history object
     shared_ptr<PortfolioHistory> get_portfolio_history(){return this->portfolio_history;};
@@ -94,6 +98,9 @@ public:
     /// \return smart pointer to the existing position
     std::optional<position_sp_t> get_position(const string &asset_id);
 
+    /// get smart pointer to existing position by the symbol of its asset
+    std::optional<position_sp_t> get_position(symbol_t asset_symbol);
+
     /// get the parent portfolio pointer
     Portfolio* get_parent_portfolio(){return this->parent_portfolio;}
 
@@ -114,7 +121,7 @@ public:
 
     /// @brief recursively search through sub portfolios to find by portfolio id
     /// @param portfolio_id unique id of the portfolio
-    /// @return sp to portfolio if exists
+    /// @return sp to portfolio if exists, nullptr otherwise
     shared_ptr<Portfolio> find_portfolio(const string &portfolio_id);
 
     /// @brief evaluate the portfolio on open or close
@@ -196,7 +203,7 @@ public:
      * @brief place a new limit order
      * 
      * @param asset_id unique id of the underlying asset
-     * @param units number of units to buy/sell
+     * @param units number of units to buy/sell, must not be zero
      * @param limit the limit price of the new order
      * @param strategy_id unique id of the strategy
      * @param order_execution_type execution type of the order
@@ -207,6 +214,38 @@ public:
                            OrderExecutionType order_execution_type = LAZY,
                            int tade_id = -1);
 
+    /**
+     * @brief place a new stop loss order, a sell fills once the price falls to the limit and a buy
+     *  once it rises to it
+     * 
+     * @param asset_id unique id of the underlying asset
+     * @param units number of units to buy/sell, must not be zero
+     * @param limit the stop price of the new order
+     * @param strategy_id unique id of the strategy
+     * @param order_execution_type execution type of the order
+     * @param trade_id unique id of the trade (-1 defaults to new trade)
+     */
+    void place_stop_loss_order(const string &asset_id, double units, double limit,
+                               const string &strategy_id,
+                               OrderExecutionType order_execution_type = LAZY,
+                               int trade_id = -1);
+
+    /**
+     * @brief place a new take profit order, a sell fills once the price rises to the limit and a buy
+     *  once it falls to it
+     * 
+     * @param asset_id unique id of the underlying asset
+     * @param units number of units to buy/sell, must not be zero
+     * @param limit the take profit price of the new order
+     * @param strategy_id unique id of the strategy
+     * @param order_execution_type execution type of the order
+     * @param trade_id unique id of the trade (-1 defaults to new trade)
+     */
+    void place_take_profit_order(const string &asset_id, double units, double limit,
+                                 const string &strategy_id,
+                                 OrderExecutionType order_execution_type = LAZY,
+                                 int trade_id = -1);
+
     /**
      * @brief close position by asset id, if no id is passed all positions are closed
      * 
@@ -314,6 +353,13 @@ private:
     /// unrealized_pl of the portfolio
     double unrealized_pl = 0;
 
+    /// @brief place a new order that rests on the exchange until its limit is crossed, throws if
+    /// units is zero as the order could never fill
+    void place_resting_order(OrderType order_type, const string &asset_id, double units, double limit,
+                             const string &strategy_id,
+                             OrderExecutionType order_execution_type,
+                             int trade_id);
+
     /// @brief modify an existing postion based on a filled order
     /// @param filled_order ref to a sp to a filled order
     void modify_position(order_sp_t filled_order);
@@ -358,7 +404,7 @@ void Portfolio::open_position(T open_obj, bool adjust_cash)
     auto position = make_shared<Position>(open_obj);
 
     // insert the new position into the portfolio object
-    this->positions_map.insert({open_obj->get_asset_id(), position});
+    this->positions_map.insert({open_obj->get_asset_symbol(), position});
 
     //propgate the new trade up portfolio tree
     auto trade_sp = position->get_trades().begin()->second;
@@ -16,6 +16,7 @@ class Position;
 class Portfolio;
 
 #include "trade.h"
+#include "symbol_table.h"
 #include "utils_gmp.h"
 
 using namespace std;
@@ -28,11 +29,11 @@ private:
     /// unique id of the position
     size_t position_id;
 
-    /// unique id of the underlying asset of the position
-    string asset_id;
+    /// symbol of the underlying asset of the position
+    symbol_t asset_symbol;
 
-    /// unique id of the exchange the underlying asset is on
-    string exchange_id;
+    /// symbol of the exchange the underlying asset is on
+    symbol_t exchange_symbol;
 
     /// net liquidation value of the position as a fixed point floating number
     double nlv = 0; 
@@ -134,11 +135,14 @@ public:
 
     /// get the id of the exchange the position's underlying asset is on
     /// \return id of the exchange the position's underlying asset is on
-    string const & get_exchange_id() { return this->exchange_id; }
+    string const & get_exchange_id() { return get_symbol_id(SymbolType::Exchange, this->exchange_symbol); }
 
     /// get the id of the position's underlying asset
     /// \return position's asset id
-    [[nodiscard]] string get_asset_id() const { return this->asset_id; };
+    [[nodiscard]] string const & get_asset_id() const { return get_symbol_id(SymbolType::Asset, this->asset_symbol); };
+
+    /// get the symbol of the position's underlying asset
+    [[nodiscard]] symbol_t get_asset_symbol() const { return this->asset_symbol; };
 
     /// get total number of units in the position
     /// \return number of units in the position
@@ -0,0 +1,245 @@
+//
+// low overhead phase timers used to profile the hydra event loop
+//
+
+#ifndef ARGUS_PROFILER_H
+#define ARGUS_PROFILER_H
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <string>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "settings.h"
+
+namespace py = pybind11;
+
+/// number of log2 latency buckets, bucket i counts calls taking [2^(i-1), 2^i) ticks
+static size_t constexpr ARGUS_PROFILE_BUCKETS = 48;
+
+/// ns the profiling clock is calibrated over against the steady clock before its rate is trusted
+static long long constexpr ARGUS_PROFILE_CALIBRATION_NS = 20000000;
+
+/**
+ * @brief An enumeration representing the phases of the hydra event loop that are timed
+ *
+ */
+enum ProfilePhase
+{
+    ForwardPass,            /**< hydra forward pass */
+    StrategyOnOpen,         /**< all strategies cxx_handler_on_open */
+    OnOpen,                 /**< hydra on open */
+    StrategyOnClose,        /**< all strategies cxx_handler_on_close */
+    BackwardPass,           /**< hydra backward pass */
+    ExchangeProcessOrders,  /**< exchange process_orders */
+    BrokerSendOrders,       /**< broker send_orders */
+    BrokerProcessOrders,    /**< broker process_orders */
+    PortfolioEvaluate,      /**< master portfolio evaluate */
+    PortfolioUpdate,        /**< master portfolio update */
+    PhaseCount
+};
+
+static const std::string ProfilePhaseStrings[] =
+{
+    "forward_pass",
+    "strategy_on_open",
+    "on_open",
+    "strategy_on_close",
+    "backward_pass",
+    "exchange_process_orders",
+    "broker_send_orders",
+    "broker_process_orders",
+    "portfolio_evaluate",
+    "portfolio_update"
+};
+
+/// read the profiling clock, the time stamp counter on x86 and steady clock ns elsewhere
+inline unsigned long long profile_ticks()
+{
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<unsigned long long>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+/**
+ * @brief number of ns in a single profiling clock tick, measured once per process by spinning over a
+ *  fixed calibration interval the first time it is requested
+ *
+ * @return double ns per tick
+ */
+inline double profile_calibrated_ns_per_tick()
+{
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+    static double const ns_per_tick = []()
+    {
+        auto origin_time = std::chrono::steady_clock::now();
+        auto origin_ticks = profile_ticks();
+        double ns = 0;
+        while(ns < ARGUS_PROFILE_CALIBRATION_NS)
+        {
+            ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - origin_time).count();
+        }
+        auto ticks = profile_ticks() - origin_ticks;
+        return ticks ? ns / ticks : 1.0;
+    }();
+    return ns_per_tick;
+#else
+    return 1.0;
+#endif
+}
+
+/**
+ * @brief total time, call count and latency histogram of a single timed phase, all values are
+ *  in profiling clock ticks and converted to ns when read
+ *
+ */
+struct PhaseCounter
+{
+    unsigned long long total_ticks = 0;     ///< total ticks spent in the phase
+    unsigned long long max_ticks = 0;       ///< slowest single call
+    size_t calls = 0;                       ///< number of calls
+
+    /// log2 latency histogram
+    std::array<size_t, ARGUS_PROFILE_BUCKETS> histogram{};
+
+    /// record a single call
+    inline void record(unsigned long long ticks)
+    {
+        this->total_ticks += ticks;
+        this->calls++;
+        if(ticks > this->max_ticks) this->max_ticks = ticks;
+        auto bucket = static_cast<size_t>(std::bit_width(ticks));
+        this->histogram[bucket < ARGUS_PROFILE_BUCKETS ? bucket : ARGUS_PROFILE_BUCKETS - 1]++;
+    }
+
+    /// clear the counter
+    void reset()
+    {
+        this->total_ticks = 0;
+        this->max_ticks = 0;
+        this->calls = 0;
+        this->histogram.fill(0);
+    }
+
+    /// convert to a python dict, histogram is returned as a numpy array
+    py::dict to_dict(double ns_per_tick) const
+    {
+        py::dict result;
+        result["calls"] = this->calls;
+        result["total_ns"] = this->total_ticks * ns_per_tick;
+        result["mean_ns"] = this->calls ? this->total_ticks * ns_per_tick / this->calls : 0.0;
+        result["max_ns"] = this->max_ticks * ns_per_tick;
+        py::array_t<size_t> histogram(ARGUS_PROFILE_BUCKETS);
+        std::copy(this->histogram.begin(), this->histogram.end(), histogram.mutable_data());
+        result["histogram"] = histogram;
+        return result;
+    }
+};
+
+/**
+ * @brief times a scope and records it to a phase counter on destruction
+ *
+ */
+class ScopedPhaseTimer
+{
+public:
+    explicit ScopedPhaseTimer(PhaseCounter& counter_) :
+        counter(counter_),
+        start(profile_ticks())
+    {}
+
+    ~ScopedPhaseTimer()
+    {
+        this->counter.record(profile_ticks() - this->start);
+    }
+
+    ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+    ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+
+private:
+    PhaseCounter& counter;
+    unsigned long long start;
+};
+
+/**
+ * @brief collection of phase counters for the hydra event loop. The tick rate of the profiling
+ *  clock is calibrated against the steady clock over the lifetime of the profiler, which reset does
+ *  not restart, and falls back to a fixed interval calibration while that lifetime is still short
+ *
+ */
+class Profiler
+{
+public:
+    Profiler() :
+        origin_ticks(profile_ticks()),
+        origin_time(std::chrono::steady_clock::now())
+    {
+        this->reset();
+    }
+
+    /// get the counter of a phase
+    PhaseCounter& get_phase(ProfilePhase phase) {return this->phases[phase];}
+
+    /// clear all counters
+    void reset()
+    {
+        for(auto& phase : this->phases)
+        {
+            phase.reset();
+        }
+    }
+
+    /// number of ns in a single profiling clock tick
+    double get_ns_per_tick() const
+    {
+        auto ticks = profile_ticks() - this->origin_ticks;
+        auto ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - this->origin_time).count();
+        if(ns < ARGUS_PROFILE_CALIBRATION_NS || !ticks)
+        {
+            return profile_calibrated_ns_per_tick();
+        }
+        return ns / ticks;
+    }
+
+    /// get the upper bound in ns of each histogram bucket
+    py::array_t<double> get_bucket_edges(double ns_per_tick) const
+    {
+        py::array_t<double> edges(ARGUS_PROFILE_BUCKETS);
+        auto ptr = edges.mutable_data();
+        for(size_t i = 0; i < ARGUS_PROFILE_BUCKETS; i++)
+        {
+            ptr[i] = static_cast<double>(1ULL << i) * ns_per_tick;
+        }
+        return edges;
+    }
+
+private:
+    std::array<PhaseCounter, ProfilePhase::PhaseCount> phases;
+
+    unsigned long long origin_ticks;                        ///< clock ticks when the profiler was created
+    std::chrono::steady_clock::time_point origin_time;      ///< steady clock time when the profiler was created
+};
+
+#define ARGUS_PROFILE_CONCAT_INNER(a, b) a##b
+#define ARGUS_PROFILE_CONCAT(a, b) ARGUS_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef ARGUS_PROFILE
+/// time the remainder of the current scope into a phase counter
+#define ARGUS_PROFILE_SCOPE(counter) ScopedPhaseTimer ARGUS_PROFILE_CONCAT(argus_phase_timer_, __LINE__)(counter)
+#else
+#define ARGUS_PROFILE_SCOPE(counter)
+#endif
+
+#endif // ARGUS_PROFILER_H
@@ -0,0 +1,179 @@
+//
+// headless backtest runner, builds and runs a hydra from a run description file
+//
+
+#ifndef ARGUS_RUNNER_H
+#define ARGUS_RUNNER_H
+
+#include "pch.h"
+#include <functional>
+#include <istream>
+
+#include "asset.h"
+#include "hydra.h"
+#include "portfolio.h"
+
+using namespace std;
+
+/**
+ * @brief a single [type id] section of a run description with its key = value pairs
+ *
+ */
+struct RunSection
+{
+    string type;                            ///< section type, i.e. exchange, broker, asset, ...
+    string id;                              ///< unique id following the section type (may be empty)
+    size_t line = 0;                        ///< line the section starts on (used in error messages)
+    unordered_map<string, string> values;   ///< mapping between key and raw string value
+
+    /// does the section contain the key
+    bool has(const string& key) const {return this->values.count(key);}
+
+    /// get a required string value, throws if missing
+    const string& get(const string& key) const;
+
+    /// get a string value or the default if missing
+    string get(const string& key, const string& default_value) const;
+
+    /// get a double value or the default if missing
+    double get_double(const string& key, double default_value) const;
+
+    /// get an unsigned integer value or the default if missing
+    size_t get_size(const string& key, size_t default_value) const;
+
+    /// get a boolean value (true/false/1/0/yes/no) or the default if missing
+    bool get_bool(const string& key, bool default_value) const;
+
+    /// get a comma seperated list of values, empty if missing
+    vector<string> get_list(const string& key) const;
+};
+
+/**
+ * @brief parsed run description. The format is ini-like, sections are written as [type id]
+ *  followed by key = value lines, '#' and ';' start comments. Relative paths are resolved against
+ *  the directory of the description file.
+ *
+ *  [hydra]                 logging, cash, threads (default 1, 0 uses every core)
+ *  [exchange <id>]         tracers (volatility:<lookback>, beta:<lookback>, atr:<lookback> and
+ *                          sma, ema, min, max or zscore as <type>:<lookback>[:<column>]), panel
+ *                          (pack the assets into an aligned panel), panel_columns (default the
+ *                          columns shared by all), lazy_tracers (step tracers only when read)
+ *  [broker <id>]           cash
+ *  [asset <id>]            path (csv or .argus file, or a directory of them), exchange, broker,
+ *                          warmup, layout (row or column), precision (float64 or float32),
+ *                          .argus files keep their own layout and precision, stream (read .argus
+ *                          files through a window of rows), chunk_rows, lookback (rows kept behind)
+ *  [index <id>]            path, exchange (registered to all exchanges if missing), broker
+ *  [portfolio <id>]        parent (default master), cash, tracers (value, event, beta)
+ *  [strategy <id>]         type (native strategy registry name), portfolio, strategy specific keys
+ *  [output]                directory
+ */
+class RunDescription
+{
+public:
+    /// directory relative paths are resolved against
+    string base_directory = ".";
+
+    /// ordered sections of the description
+    vector<RunSection> sections;
+
+    /**
+     * @brief parse a run description from a stream
+     *
+     * @param stream            stream to read from
+     * @param base_directory    directory relative paths are resolved against
+     * @return RunDescription   parsed description
+     */
+    static RunDescription parse(std::istream& stream, const string& base_directory = ".");
+
+    /// parse a run description file
+    static RunDescription parse_file(const string& path);
+
+    /// get all sections of a given type in the order they were defined
+    vector<const RunSection*> get_sections(const string& type) const;
+
+    /// resolve a path relative to the description base directory
+    string resolve_path(const string& path) const;
+};
+
+/**
+ * @brief factory used to attach a native strategy. Called once while the hydra is being set up with the
+ *  strategy object whose cxx handlers should be set, the portfolio orders are placed from and the
+ *  strategy's section of the run description
+ */
+typedef std::function<void(Hydra*, Portfolio*, Strategy*, const RunSection&)> native_strategy_factory_t;
+
+/**
+ * @brief register a native strategy under a type name so it can be referenced from a run description
+ *
+ * @param type      name of the strategy type
+ * @param factory   factory used to attach the strategy
+ */
+void register_native_strategy(const string& type, native_strategy_factory_t factory);
+
+/// get a native strategy factory by type name, nullopt if not registered
+optional<native_strategy_factory_t> get_native_strategy(const string& type);
+
+/**
+ * @brief load an asset from a csv file. The first column is the datetime (ns epoch or YYYY-MM-DD[ HH:MM:SS]),
+ *  the header row gives the remaining column names and all other values are parsed as doubles
+ *
+ * @param path          path to the csv file
+ * @param asset_id      unique id of the new asset
+ * @param exchange_id   unique id of the exchange the asset is on
+ * @param broker_id     unique id of the broker the asset is on
+ * @param warmup        warmup period of the asset
+ * @param layout        memory layout of the asset's data
+ * @param precision     element type to store the asset's data as
+ * @return asset_sp_t   loaded asset
+ */
+Asset::asset_sp_t load_asset_csv(
+    const string& path,
+    const string& asset_id,
+    const string& exchange_id,
+    const string& broker_id,
+    size_t warmup = 0,
+    AssetLayout layout = AssetLayout::RowMajor,
+    AssetPrecision precision = AssetPrecision::Float64
+);
+
+class Runner
+{
+public:
+    /// runner constructor
+    Runner(RunDescription description_);
+
+    /// create and build the hydra described by the run description
+    void build();
+
+    /// run the simulation to the end
+    void run();
+
+    /**
+     * @brief write value and event tracer output of every portfolio with tracers registered. Files are
+     *  written as <portfolio_id>_value.csv, <portfolio_id>_orders.csv, <portfolio_id>_trades.csv and
+     *  <portfolio_id>_positions.csv
+     *
+     * @param directory output directory, if empty uses the [output] section (default current directory)
+     */
+    void write_output(string directory = "");
+
+    /// get the hydra built by the runner
+    shared_ptr<Hydra> get_hydra() {return this->hydra;}
+
+private:
+    /// parsed run description
+    RunDescription description;
+
+    /// hydra built from the description
+    shared_ptr<Hydra> hydra;
+
+    /// portfolios that have tracers registered
+    vector<shared_ptr<Portfolio>> traced_portfolios;
+
+    void build_assets(const RunSection& section, bool is_index);
+    void build_portfolio(const RunSection& section);
+    void build_strategy(const RunSection& section);
+};
+
+#endif // ARGUS_RUNNER_H
@@ -9,12 +9,34 @@
 #define ARGUS_HIGH_PRECISION
 #define ARGUS_RUNTIME_ASSERT
 #define ARGUS_STRIP
+#define ARGUS_PROFILE
 //#define ARGUS_BROKER_ACCOUNT_TRACKING
 //#define ARGUS_HISTORY
 
 static double constexpr ARGUS_PORTFOLIO_MAX_LEVERAGE  = 2;
 static double constexpr ARGUS_MP_PORTFOLIO_MAX_LEVERAGE = 1.75;
 
+#include <cstddef>
+
+/// minimum number of assets stepping in a bar before the step is split across the thread pool
+static size_t constexpr ARGUS_PARALLEL_STEP_MIN = 256;
+
+/// number of assets a thread pool participant claims at a time when stepping a bar
+static size_t constexpr ARGUS_PARALLEL_STEP_GRAIN = 32;
+
+/// number of assets a thread pool participant builds at a time when building an exchange
+static size_t constexpr ARGUS_PARALLEL_BUILD_GRAIN = 8;
+
+/// rows an exponential moving average replays when built, as a multiple of its lookback. The weight
+/// left on the rows before the horizon is (1 - 2 / (lookback + 1))^(10 lookback), below e^-20
+static size_t constexpr ARGUS_EMA_HISTORY_LOOKBACKS = 10;
+
+/// number of exchange wide queries with distinct column, scaler and row cached per bar
+static size_t constexpr ARGUS_FEATURE_CACHE_SIZE = 8;
+
+/// ranked exchange queries selecting fewer than 1 / ratio of the streaming assets partially sort them
+static size_t constexpr ARGUS_PARTIAL_SORT_RATIO = 8;
+
 #include <stdexcept>
 #include <string>
 
@@ -35,7 +57,8 @@ enum ArgusErrorCode {
   InvalidDatetime,
   InvalidId,
   InvalidArrayLength,
-  InvalidArrayValues
+  InvalidArrayValues,
+  InvalidArrayType
 };
 
 static const std::string EnumStrings[] = 
@@ -56,7 +79,8 @@ static const std::string EnumStrings[] =
   "Invalid datetime passed",
   "Invalid id passed",
   "Invalid array length",
-  "Invalid array values"
+  "Invalid array values",
+  "Invalid array type"
 };
 
 class RuntimeError : public std::runtime_error {
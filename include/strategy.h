@@ -1,7 +1,12 @@
 
+#ifndef ARGUS_STRATEGY_H
+#define ARGUS_STRATEGY_H
+
 #include <functional>
 #include <string>
 
+#include "profiler.h"
+
 using namespace std;
 
 class Strategy
@@ -16,6 +21,9 @@ public:
     std::function<void()> python_handler_on_close;
     std::function<void()> cxx_handler_on_close;
 
+    PhaseCounter on_open_profile;   ///< time spent in the strategy's on open handler
+    PhaseCounter on_close_profile;  ///< time spent in the strategy's on close handler
+
     Strategy(string strategy_id_)
     {
         // assign strategy id
@@ -39,4 +47,6 @@ private:
     ///unique id of the strategy
     string strategy_id;
 
-};
\ No newline at end of file
+};
+
+#endif // ARGUS_STRATEGY_H
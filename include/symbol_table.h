@@ -0,0 +1,76 @@
+//
+// interning of the string ids of assets, exchanges, brokers, strategies and asset groups into dense integer symbols
+//
+
+#ifndef ARGUS_SYMBOL_TABLE_H
+#define ARGUS_SYMBOL_TABLE_H
+
+#include "pch.h"
+#include <cstdint>
+#include <deque>
+
+using namespace std;
+
+/// dense integer id of an interned string id
+typedef uint32_t symbol_t;
+
+/// kinds of ids that are interned, each kind has its own dense range of symbols starting at 0
+enum class SymbolType
+{
+    Asset,
+    Exchange,
+    Broker,
+    Strategy,
+    Group       ///< group labels of assets used by cross sectional transforms
+};
+
+/// number of kinds of ids, new kinds are added before Group so it stays the last
+constexpr size_t SYMBOL_TYPE_COUNT = 5;
+static_assert(static_cast<size_t>(SymbolType::Group) + 1 == SYMBOL_TYPE_COUNT, "SYMBOL_TYPE_COUNT must count every SymbolType");
+
+/**
+ * @brief assigns dense integer symbols to string ids. Ids are interned when the object carrying them is
+ *  created, after that orders, trades and positions are routed by symbol and the string is only read
+ *  back at the python boundary and in logs. The tables are global so an id has the same symbol in every
+ *  hydra. Interning is not thread safe, ids are interned on the main thread.
+ *
+ */
+class SymbolTable
+{
+public:
+    /// get the symbol of an id, assigning the next symbol if the id is new
+    symbol_t intern(const string& id);
+
+    /// get the symbol of an id if it has been interned
+    [[nodiscard]] optional<symbol_t> find(const string& id) const;
+
+    /// get the id of a symbol
+    [[nodiscard]] string const & get_id(symbol_t symbol) const { return this->ids[symbol]; }
+
+    /// number of symbols assigned
+    [[nodiscard]] size_t size() const { return this->ids.size(); }
+
+    /// get the global table of a kind of id
+    static SymbolTable& get(SymbolType symbol_type);
+
+private:
+    /// map between id and its symbol
+    unordered_map<string, symbol_t> symbols;
+
+    /// id of each symbol, a deque so references to ids stay valid as new ids are interned
+    deque<string> ids;
+};
+
+/// intern an id in the global table of its kind
+inline symbol_t intern_symbol(SymbolType symbol_type, const string& id)
+{
+    return SymbolTable::get(symbol_type).intern(id);
+}
+
+/// get the id of a symbol from the global table of its kind
+inline string const & get_symbol_id(SymbolType symbol_type, symbol_t symbol)
+{
+    return SymbolTable::get(symbol_type).get_id(symbol);
+}
+
+#endif // ARGUS_SYMBOL_TABLE_H
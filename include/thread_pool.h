@@ -0,0 +1,115 @@
+//
+// work stealing thread pool used to step the assets of a bar in parallel
+//
+
+#ifndef ARGUS_THREAD_POOL_H
+#define ARGUS_THREAD_POOL_H
+
+#include "pch.h"
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+
+/**
+ * @brief a fixed set of worker threads that split a range of indexes between themselves and the
+ *  calling thread. Each participant starts on its own contiguous share of the range and claims it
+ *  a grain at a time, once its share is done it steals grains from the shares of the others. Idle
+ *  workers spin briefly then sleep on an epoch counter so a pool can be woken every bar without
+ *  allocating.
+ *
+ */
+class ThreadPool
+{
+public:
+    /// start a pool with workers participants, the calling thread is one of them
+    explicit ThreadPool(size_t workers_);
+
+    /// stop and join the worker threads
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// number of participants including the calling thread
+    [[nodiscard]] size_t get_workers() const { return this->participants; }
+
+    /**
+     * @brief call func(begin, end) over sub ranges covering [0, n) and return once every sub range
+     *  has been processed. Sub ranges are at most grain long and are disjoint, the first exception
+     *  thrown by func is rethrown on the calling thread.
+     *
+     * @param n     length of the range
+     * @param grain number of indexes claimed at a time
+     * @param func  callable taking (size_t begin, size_t end)
+     */
+    template<typename Func>
+    void parallel_for(size_t n, size_t grain, Func& func)
+    {
+        if(this->threads.empty() || n <= grain)
+        {
+            func(0, n);
+            return;
+        }
+        this->run(n, grain, [](void* context, size_t begin, size_t end)
+        {
+            (*static_cast<Func*>(context))(begin, end);
+        }, &func);
+    }
+
+private:
+    typedef void (*task_t)(void*, size_t, size_t);
+
+    /// share of the range owned by a participant, padded so participants do not share cache lines
+    struct alignas(64) WorkRange
+    {
+        atomic<size_t> next{0};
+        size_t end = 0;
+    };
+
+    /// number of participants including the calling thread
+    size_t participants;
+
+    /// worker threads, participant i + 1 runs on threads[i]
+    vector<std::thread> threads;
+
+    /// share of each participant in the current range
+    unique_ptr<WorkRange[]> ranges;
+
+    /// task of the current range
+    task_t task = nullptr;
+    void* context = nullptr;
+    size_t grain = 1;
+
+    /// incremented to wake the workers for a new range
+    atomic<uint64_t> epoch{0};
+
+    /// number of workers still processing the current range
+    atomic<size_t> pending{0};
+
+    /// set to stop the workers
+    atomic<bool> stopping{false};
+
+    /// allocation phase and strict mode of the calling thread, taken by the workers for the current
+    /// range (ARGUS_ALLOC_TRACKING only)
+    int alloc_phase = -1;
+    bool alloc_strict = false;
+
+    /// first exception thrown by the task of the current range
+    std::mutex error_mutex;
+    std::exception_ptr error = nullptr;
+
+    /// split a range between the participants, wake the workers and work on it until done
+    void run(size_t n, size_t grain_, task_t task_, void* context_);
+
+    /// work on a participant's share then steal from the others until the range is exhausted
+    void work(size_t participant);
+
+    /// main loop of a worker thread
+    void worker_loop(size_t participant);
+};
+
+#endif // ARGUS_THREAD_POOL_H
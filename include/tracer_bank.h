@@ -0,0 +1,155 @@
+//
+// volatility tracers of every asset on an exchange kept as arrays indexed by market slot
+//
+
+#ifndef ARGUS_TRACER_BANK_H
+#define ARGUS_TRACER_BANK_H
+
+#include "pch.h"
+#include <cstdint>
+#include <limits>
+
+#include "asset.h"
+
+using namespace std;
+
+/**
+ * @brief state of the volatility tracers of an exchange's assets stored as one array per field,
+ *  indexed by market slot. The assets stepped at an exchange time are updated together: the
+ *  percent changes entering and leaving each window are gathered first, then the running sums
+ *  are updated in a branch free loop over contiguous arrays. The arithmetic is that of
+ *  VolatilityTracer, each asset's volatility pointer points into the bank.
+ *
+ */
+class VolatilityBank
+{
+public:
+    explicit VolatilityBank(size_t lookback_) : lookback(lookback_) {}
+
+    /// lookback of every tracer in the bank
+    [[nodiscard]] size_t get_lookback() const { return this->lookback; }
+
+    /// size the bank for a number of market slots, every slot starts without an asset
+    void resize(size_t slots);
+
+    /// place an asset's tracer at a market slot
+    void assign(uint32_t slot, Asset* asset);
+
+    /// rebuild the tracer at a slot from the window behind its asset's current row
+    void build(uint32_t slot);
+
+    /**
+     * @brief step the tracers of the assets at a sorted list of market slots, the assets must have
+     *  stepped already. Slots without an asset are skipped.
+     *
+     * @param slots     sorted market slots that stepped
+     * @param count     number of slots
+     */
+    void step(uint32_t const * slots, size_t count);
+
+    /// move a slot's window after its asset moved the rows it points into
+    void rebase(uint32_t slot, double* old_base, double* new_base);
+
+    [[nodiscard]] double get_volatility(uint32_t slot) const { return this->volatilities[slot]; }
+
+    [[nodiscard]] bool get_is_warm(uint32_t slot) const { return this->rows_needed[slot] == 0; }
+
+private:
+    size_t lookback;
+
+    /// asset of each slot, nullptr for slots without a tracer
+    vector<Asset*> assets;
+
+    /// number of slots with an asset, when every slot has one contiguous runs of slots are
+    /// stepped without reading the slot list
+    size_t assigned = 0;
+
+    /// window into each asset's close series, the start is the oldest row and the end the newest
+    vector<double*> start_ptrs;
+    vector<double*> end_ptrs;
+    vector<size_t> strides;
+
+    vector<double> sums;
+    vector<double> sum_squares;
+    vector<double> volatilities;
+    vector<int64_t> rows_needed;
+
+    /// percent changes leaving and entering each window in the current step
+    vector<double> old_pcts;
+    vector<double> new_pcts;
+
+    /// gather the percent changes of slot and advance its window
+    inline void gather(uint32_t slot)
+    {
+        auto stride = this->strides[slot];
+        auto start = this->start_ptrs[slot];
+        auto end = this->end_ptrs[slot];
+        this->old_pcts[slot] = (start[stride] - start[0]) / start[0];
+        this->new_pcts[slot] = (*end - *(end - stride)) / *(end - stride);
+        this->start_ptrs[slot] = start + stride;
+        this->end_ptrs[slot] = end + stride;
+    }
+
+    /// update the sums of a slot, slots that are not warm keep accumulating and their volatility
+    /// is left as is
+    inline void accumulate(uint32_t slot)
+    {
+        auto warm = this->rows_needed[slot] == 0;
+        auto old_pct = warm ? this->old_pcts[slot] : 0.0;
+        auto new_pct = this->new_pcts[slot];
+        this->sums[slot] += new_pct;
+        this->sum_squares[slot] += new_pct * new_pct;
+        this->sums[slot] -= old_pct;
+        this->sum_squares[slot] -= old_pct * old_pct;
+        auto n = static_cast<double>(this->lookback);
+        auto volatility = (this->sum_squares[slot] - (this->sums[slot] * this->sums[slot]) / n) / (n - 1);
+        this->volatilities[slot] = warm ? volatility : this->volatilities[slot];
+    }
+
+    /// count down the rows a slot that is not warm needs, point its asset at the bank once it is
+    inline void warm_up(uint32_t slot)
+    {
+        if(this->rows_needed[slot] != 0 && --this->rows_needed[slot] == 0)
+        {
+            this->assets[slot]->set_volatility(&this->volatilities[slot]);
+        }
+    }
+};
+
+/**
+ * @brief volatility tracer of an asset whose state is kept in its exchange's VolatilityBank. The
+ *  exchange steps the bank, the asset does not step the tracer itself.
+ *
+ */
+class BankedVolatilityTracer : public AssetTracer
+{
+public:
+    BankedVolatilityTracer(Asset* parent_asset_, shared_ptr<VolatilityBank> bank_);
+
+    AssetTracerType tracer_type() const override {return AssetTracerType::Volatility;}
+
+    bool get_is_banked() const override {return true;}
+
+    void step() override;
+
+    void build() override;
+
+    void reset() override {this->build();}
+
+    void rebase(double* old_base, double* new_base) override;
+
+    double get_value() const override;
+
+    bool get_is_warm() const override;
+
+    /// market slot of the parent asset in the bank
+    void set_slot(uint32_t slot_) {this->slot = slot_;}
+
+    [[nodiscard]] VolatilityBank* get_bank() const {return this->bank.get();}
+
+private:
+    shared_ptr<VolatilityBank> bank;
+    uint32_t slot = std::numeric_limits<uint32_t>::max();
+};
+
+#endif // ARGUS_TRACER_BANK_H
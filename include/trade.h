@@ -85,7 +85,10 @@ public:
 
     /// get the id of the underlying asset of the trade
     /// @return underlying asset of the trade
-    [[nodiscard]] string const & get_asset_id() const { return this->asset_id; }
+    [[nodiscard]] string const & get_asset_id() const { return get_symbol_id(SymbolType::Asset, this->asset_symbol); }
+
+    /// get the symbol of the underlying asset of the trade
+    [[nodiscard]] symbol_t get_asset_symbol() const { return this->asset_symbol; }
 
     /// get the id of the trade 
     /// @return id of the trade
@@ -93,7 +96,10 @@ public:
 
     /// get the id of the underlying exchange of the trade
     /// @return ref to string of underlying exchange id 
-    [[nodiscard]] string const & get_exchange_id() const { return this->exchange_id; }
+    [[nodiscard]] string const & get_exchange_id() const { return get_symbol_id(SymbolType::Exchange, this->exchange_symbol); }
+
+    /// get the symbol of the underlying exchange of the trade
+    [[nodiscard]] symbol_t get_exchange_symbol() const { return this->exchange_symbol; }
 
     /// get the average price of the trade
     /// @return average price of the trade
@@ -146,17 +152,17 @@ private:
     /// unique id of the trade
     size_t trade_id;
 
-    /// unique id of the underlying asset of the trade
-    string asset_id;
+    /// symbol of the underlying asset of the trade
+    symbol_t asset_symbol;
 
-    /// unique id of the exchange the underlying asset is on
-    string exchange_id;
+    /// symbol of the exchange the underlying asset is on
+    symbol_t exchange_symbol;
 
-    /// unique id of the broker the trade was placed on
-    string broker_id;
+    /// symbol of the broker the trade was placed on
+    symbol_t broker_symbol;
 
-    /// unique id of the strategy that placed the order
-    string strategy_id;
+    /// symbol of the strategy that placed the order
+    symbol_t strategy_symbol;
 
     /// net liquidation value of the trade represented as a fixed point floating number
     double nlv;
@@ -0,0 +1,134 @@
+//
+// resting limit, stop loss and take profit orders of an exchange indexed by market slot and trigger price
+//
+
+#ifndef ARGUS_TRIGGER_BOOK_H
+#define ARGUS_TRIGGER_BOOK_H
+
+#include "pch.h"
+#include <cstdint>
+
+#include "order.h"
+
+using namespace std;
+
+/**
+ * @brief resting orders of each market slot split by the direction of the price move that fills them.
+ *  Orders filled once the market price is at or below their limit (buy limits, sell stop losses and
+ *  buy take profits) are kept in a heap with the highest limit on top, orders filled at or above their
+ *  limit in a heap with the lowest limit on top. Triggering a slot only pops the orders that cross,
+ *  ties are popped in order id order. Limits are read once when an order rests and must not change.
+ *  Orders with zero units never fill and are not rested.
+ *
+ */
+class TriggerBook
+{
+public:
+    /// size the book for a number of market slots and drop every resting order
+    void resize(size_t slots);
+
+    /// drop every resting order
+    void clear();
+
+    /// number of resting orders
+    [[nodiscard]] size_t get_orders() const { return this->orders; }
+
+    /// market slots with at least one resting order
+    [[nodiscard]] vector<uint32_t> const & get_active_slots() const { return this->active_slots; }
+
+    /// rest an open order on a market slot
+    void insert(uint32_t slot, const shared_ptr<Order>& order);
+
+    /// remove a resting order from a market slot, returns false if the order is not resting there
+    bool remove(uint32_t slot, size_t order_id);
+
+    /**
+     * @brief pop the orders of a market slot triggered by a market price and call func(order) for
+     *  each of them.
+     *
+     * @param slot          market slot of the asset that printed
+     * @param market_price  price the asset printed at
+     * @param func          callable taking shared_ptr<Order>&
+     */
+    template<typename Func>
+    void trigger(uint32_t slot, double market_price, Func&& func)
+    {
+        auto& book = this->books[slot];
+        this->pop_while(book.below, TriggerBook::below_order,
+            [market_price](const Entry& entry) { return market_price <= entry.limit; }, func);
+        this->pop_while(book.above, TriggerBook::above_order,
+            [market_price](const Entry& entry) { return market_price >= entry.limit; }, func);
+        if(book.below.empty() && book.above.empty())
+        {
+            this->deactivate(slot);
+        }
+    }
+
+private:
+    struct Entry
+    {
+        double limit;
+        size_t order_id;
+        shared_ptr<Order> order;
+    };
+
+    struct SlotBook
+    {
+        vector<Entry> below;    ///< filled at or below the limit, max heap on the limit
+        vector<Entry> above;    ///< filled at or above the limit, min heap on the limit
+    };
+
+    /// heap orders, the entry that compares greatest is on top
+    static bool below_order(const Entry& a, const Entry& b)
+    {
+        return a.limit < b.limit || (a.limit == b.limit && a.order_id > b.order_id);
+    }
+    static bool above_order(const Entry& a, const Entry& b)
+    {
+        return a.limit > b.limit || (a.limit == b.limit && a.order_id > b.order_id);
+    }
+
+    /// book of each market slot
+    vector<SlotBook> books;
+
+    /// market slots with resting orders and the position of each slot in it
+    vector<uint32_t> active_slots;
+    vector<uint32_t> active_positions;
+
+    /// number of resting orders
+    size_t orders = 0;
+
+    /// remove a slot from the active slots
+    void deactivate(uint32_t slot);
+
+    /// remove an order from a heap and restore the heap, returns false if it is not in the heap
+    template<typename Compare>
+    bool remove_from(vector<Entry>& heap, Compare compare, size_t order_id)
+    {
+        auto it = std::find_if(heap.begin(), heap.end(),
+            [order_id](const Entry& entry) { return entry.order_id == order_id; });
+        if(it == heap.end())
+        {
+            return false;
+        }
+        *it = std::move(heap.back());
+        heap.pop_back();
+        std::make_heap(heap.begin(), heap.end(), compare);
+        return true;
+    }
+
+    template<typename Compare, typename Crossed, typename Func>
+    void pop_while(vector<Entry>& heap, Compare compare, Crossed crossed, Func& func)
+    {
+        while(!heap.empty() && crossed(heap.front()))
+        {
+            std::pop_heap(heap.begin(), heap.end(), compare);
+            auto order = std::move(heap.back().order);
+            heap.pop_back();
+            this->orders--;
+            func(order);
+        }
+    }
+};
+
+#endif // ARGUS_TRIGGER_BOOK_H
@@ -6,6 +6,7 @@
 #define ARGUS_UTILS_ARRAY_H
 
 #include "pch.h"
+#include <functional>
 #include <queue>
 #include <span>
 #include <type_traits>
@@ -70,14 +71,64 @@ inline optional<T> sorted_vector_remove(vector<T> &vec, Func func)
 }
 
 
+/// object a view into data keeps alive, the owner of the data if passed else an empty capsule
 template<typename T>
-inline py::array_t<T> to_py_array(T const * data, long length, bool read_only)
+inline py::object view_base(T const * data, py::handle owner)
+{
+    if(owner)
+    {
+        return py::reinterpret_borrow<py::object>(owner);
+    }
+    return py::capsule(data, [](void *data) {});
+}
+
+/// copy strided data into a new numpy array, the stride is given in elements
+template<typename T>
+inline py::array_t<T> to_py_array_copy(T const * data, py::ssize_t length, py::ssize_t stride)
+{
+    py::array_t<T> array(length);
+    auto values = array.mutable_data();
+    for(py::ssize_t i = 0; i < length; i++)
+    {
+        values[i] = data[i * stride];
+    }
+    return array;
+}
+
+/// wrap data in a numpy array without copying, the array keeps owner alive if passed
+template<typename T>
+inline py::array_t<T> to_py_array(T const * data, long length, bool read_only, py::handle owner = py::handle())
 {
-    auto capsule = py::capsule(data, [](void *data) {});
     auto array =  py::array_t<T> {
         length,
         data,
-        capsule
+        view_base(data, owner)
+    };
+    if(read_only) {
+        reinterpret_cast<py::detail::PyArray_Proxy *>(array.ptr())->flags &= ~py::detail::npy_api::NPY_ARRAY_WRITEABLE_;
+    }
+    return array;
+}
+
+/// wrap strided data in a numpy array without copying, strides are given in elements. The array
+/// keeps owner alive if passed
+template<typename T>
+inline py::array_t<T> to_py_array_strided(
+    T const * data,
+    std::vector<py::ssize_t> shape,
+    std::vector<py::ssize_t> strides,
+    bool read_only,
+    py::handle owner = py::handle())
+{
+    for(auto& stride : strides)
+    {
+        stride *= sizeof(T);
+    }
+    auto array = py::array_t<T> {
+        shape,
+        strides,
+        data,
+        view_base(data, owner)
     };
     if(read_only) {
         reinterpret_cast<py::detail::PyArray_Proxy *>(array.ptr())->flags &= ~py::detail::npy_api::NPY_ARRAY_WRITEABLE_;
@@ -97,53 +148,35 @@ bool array_eq(T const * a, T const * b, size_t length){
 
 template<class T>
 tuple<T* , int> sorted_union(T const * p1, T const* p2, size_t n, size_t m) {
-    int i = 0, j = 0, k = 0;
-    auto* result = new T[n + m];
-    priority_queue<T, vector<T>, greater<>> pq;
-
+    // merge the two sorted arrays dropping duplicates, then copy into a block of the exact size
+    vector<T> merged;
+    merged.reserve(n + m);
+    size_t i = 0, j = 0;
     while (i < n && j < m) {
         if (p1[i] < p2[j]) {
-            pq.push(p1[i]);
-            i++;
+            merged.push_back(p1[i++]);
         } else if (p2[j] < p1[i]) {
-            pq.push(p2[j]);
-            j++;
+            merged.push_back(p2[j++]);
         } else {
-            pq.push(p1[i]);
+            merged.push_back(p1[i]);
             i++;
             j++;
         }
     }
+    merged.insert(merged.end(), p1 + i, p1 + n);
+    merged.insert(merged.end(), p2 + j, p2 + m);
 
-    while (i < n) {
-        pq.push(p1[i]);
-        i++;
-    }
-
-    while (j < m) {
-        pq.push(p2[j]);
-        j++;
-    }
-
-    while (!pq.empty()) {
-        result[k] = pq.top();
-        pq.pop();
-        k++;
-    }
-
-    // Shrink the memory block to the actual size needed
-    auto* temp = (T*)realloc(result, k * sizeof(T));
-    if (temp != nullptr) {
-        result = temp;
-    } else{
-        throw std::runtime_error("failed to realloc array");
-    }
-    return std::make_tuple(result, k);
+    auto* result = new T[merged.size()];
+    std::copy(merged.begin(), merged.end(), result);
+    return std::make_tuple(result, static_cast<int>(merged.size()));
 }
 
 /**
  * Returns a sorted array of each each element's child array
  *
+ * The child arrays are merged in a single pass with a heap over the head of each array, runs that are
+ * identical to an earlier run (common when assets share a calendar) are merged once.
+ *
  * @param hash_map the container holding the elements to iterate over
  * @return pointer to dynamically allocated array
  *
@@ -156,33 +189,72 @@ tuple<long long* , int> inline container_sorted_union(
         Container& hash_map,
         IndexLoc index_loc,
         IndexLen index_len) {
-    //allocate location for new sorted array
-    auto* sorted_array = new long long[0];
-    size_t length = 0;
-
+    // collect the non empty runs, sorting by length and end points puts identical runs next to each other
+    vector<pair<long long const *, size_t>> candidates;
     for(const auto & it : hash_map) {
         auto element = it.second;
-
-        if(length == index_len(element)){
-            if(array_eq( sorted_array,index_loc(element),length)){
-                continue;
+        size_t run_length = index_len(element);
+        if(run_length != 0){
+            candidates.emplace_back(index_loc(element), run_length);
+        }
+    }
+    auto run_key = [](const pair<long long const *, size_t>& run) {
+        return std::make_tuple(run.second, run.first[0], run.first[run.second - 1]);
+    };
+    std::sort(candidates.begin(), candidates.end(), [&](const auto& a, const auto& b) {
+        return run_key(a) < run_key(b);
+    });
+
+    // keep one run of each distinct index
+    vector<pair<long long const *, size_t>> runs;
+    size_t group_start = 0;
+    size_t total = 0;
+    for(auto const & candidate : candidates) {
+        if(!runs.empty() && run_key(runs.back()) != run_key(candidate)){
+            group_start = runs.size();
+        }
+        bool duplicate = false;
+        for(size_t i = group_start; i < runs.size(); i++) {
+            if(runs[i].first == candidate.first || array_eq(runs[i].first, candidate.first, candidate.second)){
+                duplicate = true;
+                break;
             }
         }
-        //get sorted union of the two datetime indecies
-        auto sorted_index_tuple = sorted_union(
-                sorted_array, index_loc(element),
-                length,       index_len(element));
-
-        auto sorted_index = get<0>(sorted_index_tuple);
-        auto sorted_index_size = get<1>(sorted_index_tuple);
-
-        //swap pointers between the new sorted union and the existing one
-        std::swap(sorted_array , sorted_index);
-        length = sorted_index_size;
+        if(!duplicate){
+            runs.push_back(candidate);
+            total += candidate.second;
+        }
+    }
 
-        delete [] sorted_index;
+    // k-way merge, the heap holds the next value of each run that is not exhausted
+    vector<long long> merged;
+    merged.reserve(total);
+    vector<pair<long long, size_t>> heap;
+    heap.reserve(runs.size());
+    vector<size_t> positions(runs.size(), 0);
+    for(size_t run = 0; run < runs.size(); run++) {
+        heap.emplace_back(runs[run].first[0], run);
+    }
+    auto greater_head = std::greater<pair<long long, size_t>>();
+    std::make_heap(heap.begin(), heap.end(), greater_head);
+    while(!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), greater_head);
+        auto [value, run] = heap.back();
+        if(merged.empty() || merged.back() != value){
+            merged.push_back(value);
+        }
+        if(++positions[run] < runs[run].second){
+            heap.back().first = runs[run].first[positions[run]];
+            std::push_heap(heap.begin(), heap.end(), greater_head);
+        }
+        else{
+            heap.pop_back();
+        }
     }
-    return std::make_tuple(sorted_array, length);
+
+    auto* sorted_array = new long long[merged.size()];
+    std::copy(merged.begin(), merged.end(), sorted_array);
+    return std::make_tuple(sorted_array, static_cast<int>(merged.size()));
 }
 
 /**
@@ -255,6 +327,46 @@ optional<size_t> array_find(T* p1, size_t l1, T element)
     return nullopt;
 }
 
+/**
+ * @brief binary search a sorted array for the first element not less than the one given
+ *
+ * @tparam T type of array to search
+ * @param p1 pointer to first element in the array
+ * @param first index to start the search at
+ * @param l1 length of the array
+ * @param element element to search for
+ * @return size_t index of the first element >= element at or after first, l1 if there is none
+ */
+template<typename T>
+size_t sorted_array_lower_bound(const T* p1, size_t first, size_t l1, T element)
+{
+    if(first >= l1)
+    {
+        return l1;
+    }
+    return static_cast<size_t>(std::lower_bound(p1 + first, p1 + l1, element) - p1);
+}
+
+/**
+ * @brief binary search a sorted array for an element and return it's index if found
+ *
+ * @tparam T type of array to search
+ * @param p1 pointer to first element in the array
+ * @param l1 length of the array
+ * @param element element to search for
+ * @return optional<size_t> nullopt if not found, else the index it is at
+ */
+template<typename T>
+optional<size_t> sorted_array_find(const T* p1, size_t l1, T element)
+{
+    auto i = sorted_array_lower_bound(p1, 0, l1, element);
+    if(i == l1 || p1[i] != element)
+    {
+        return nullopt;
+    }
+    return i;
+}
+
 template<typename T, typename Func>
 optional<T> vector_get(const vector<T> &vec, Func func)
 {
@@ -9,14 +9,21 @@
 #include <iterator>
 #include <tuple>
 #include <cstring>
+#ifndef _WIN32
+#include <strings.h>
+#endif
 
 using namespace std;
 
-bool case_ins_str_compare(const std::string& str1, const std::string& str2) {
+inline bool case_ins_str_compare(const std::string& str1, const std::string& str2) {
+#ifdef _WIN32
     return _stricmp(str1.c_str(), str2.c_str()) == 0;
+#else
+    return strcasecmp(str1.c_str(), str2.c_str()) == 0;
+#endif
 }
 
-size_t case_ins_str_index(const std::vector<std::string>& columns, const std::string& column) {
+inline size_t case_ins_str_index(const std::vector<std::string>& columns, const std::string& column) {
     auto it = std::find_if(columns.begin(), columns.end(), [&column](const std::string& s) {
         return case_ins_str_compare(s, column);
     });
@@ -29,7 +36,7 @@ size_t case_ins_str_index(const std::vector<std::string>& columns, const std::st
     }
 }
 
-std::tuple<size_t, size_t> parse_headers(const std::vector<std::string>& columns) {
+inline std::tuple<size_t, size_t> parse_headers(const std::vector<std::string>& columns) {
     size_t open_index = case_ins_str_index(columns, "open");
     size_t close_index = case_ins_str_index(columns, "close");
     return std::make_tuple(open_index, close_index);
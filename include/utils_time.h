@@ -9,5 +9,14 @@
 
 std::string nanosecond_epoch_time_to_string(long long ns_epoch_time);
 
+/**
+ * @brief parse a datetime string into a ns epoch time stamp (UTC). Accepts an integer ns epoch
+ *  time, "YYYY-MM-DD", or "YYYY-MM-DD HH:MM:SS" (a 'T' separator is also accepted)
+ *
+ * @param datetime  string to parse
+ * @return long long ns epoch time stamp
+ */
+long long string_to_nanosecond_epoch_time(const std::string& datetime);
+
 
 #endif //ARGUS_UTILS_TIME_H
@@ -0,0 +1,252 @@
+//
+// heap allocation accounting for the hydra event loop
+//
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "alloc_tracker.h"
+
+/// allocation counter written from any thread with an active phase, read as an AllocCounter
+struct AtomicAllocCounter
+{
+    std::atomic<size_t> allocations{0};
+    std::atomic<size_t> bytes{0};
+    std::atomic<size_t> frees{0};
+
+    [[nodiscard]] AllocCounter load() const
+    {
+        return AllocCounter{
+            this->allocations.load(std::memory_order_relaxed),
+            this->bytes.load(std::memory_order_relaxed),
+            this->frees.load(std::memory_order_relaxed)
+        };
+    }
+
+    void clear()
+    {
+        this->allocations.store(0, std::memory_order_relaxed);
+        this->bytes.store(0, std::memory_order_relaxed);
+        this->frees.store(0, std::memory_order_relaxed);
+    }
+};
+
+/// counters indexed by phase, written from every thread with an active phase
+static AtomicAllocCounter phase_counters[ProfilePhase::PhaseCount];
+static AtomicAllocCounter total_counter;
+static std::atomic<size_t> phase_violations[ProfilePhase::PhaseCount];
+static std::atomic<size_t> violations{0};
+
+/// innermost active phase of the current thread (-1 for none)
+static thread_local int current_phase = -1;
+
+/// is strict mode active on the current thread
+static thread_local bool current_strict = false;
+
+bool AllocTracker::is_enabled()
+{
+#ifdef ARGUS_ALLOC_TRACKING
+    return true;
+#else
+    return false;
+#endif
+}
+
+AllocCounter AllocTracker::get_phase_counter(ProfilePhase phase)
+{
+    return phase_counters[phase].load();
+}
+
+AllocCounter AllocTracker::get_total_counter()
+{
+    return total_counter.load();
+}
+
+void AllocTracker::reset()
+{
+    for(size_t i = 0; i < ProfilePhase::PhaseCount; i++)
+    {
+        phase_counters[i].clear();
+        phase_violations[i].store(0, std::memory_order_relaxed);
+    }
+    total_counter.clear();
+    violations.store(0, std::memory_order_relaxed);
+}
+
+size_t AllocTracker::get_violations()
+{
+    return violations.load(std::memory_order_relaxed);
+}
+
+size_t AllocTracker::get_phase_violations(ProfilePhase phase)
+{
+    return phase_violations[phase].load(std::memory_order_relaxed);
+}
+
+void AllocTracker::record_allocation(size_t bytes)
+{
+    if(current_phase < 0)
+    {
+        return;
+    }
+    auto& counter = phase_counters[current_phase];
+    counter.allocations.fetch_add(1, std::memory_order_relaxed);
+    counter.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    total_counter.allocations.fetch_add(1, std::memory_order_relaxed);
+    total_counter.bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+    if(current_strict)
+    {
+        violations.fetch_add(1, std::memory_order_relaxed);
+        phase_violations[current_phase].fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void AllocTracker::record_free()
+{
+    if(current_phase < 0)
+    {
+        return;
+    }
+    phase_counters[current_phase].frees.fetch_add(1, std::memory_order_relaxed);
+    total_counter.frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+int AllocTracker::set_phase(int phase)
+{
+    auto previous = current_phase;
+    current_phase = phase;
+    return previous;
+}
+
+int AllocTracker::get_phase()
+{
+    return current_phase;
+}
+
+bool AllocTracker::set_strict(bool strict)
+{
+    auto previous = current_strict;
+    current_strict = strict;
+    return previous;
+}
+
+bool AllocTracker::get_strict()
+{
+    return current_strict;
+}
+
+#ifdef ARGUS_ALLOC_TRACKING
+//============================================================================
+// replacement global allocation functions, all allocations are forwarded to malloc so memory
+// allocated here can be released by code that was compiled against the default operators
+
+static void* tracked_malloc(std::size_t size)
+{
+    AllocTracker::record_allocation(size);
+    if(size == 0)
+    {
+        size = 1;
+    }
+    return std::malloc(size);
+}
+
+static void* tracked_aligned_malloc(std::size_t size, std::align_val_t alignment)
+{
+    AllocTracker::record_allocation(size);
+    auto align = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+    return _aligned_malloc(size ? size : 1, align);
+#else
+    // aligned_alloc requires the size to be a multiple of the alignment
+    size = ((size ? size : 1) + align - 1) / align * align;
+    return std::aligned_alloc(align, size);
+#endif
+}
+
+static void tracked_free(void* ptr)
+{
+    if(!ptr)
+    {
+        return;
+    }
+    AllocTracker::record_free();
+    std::free(ptr);
+}
+
+static void tracked_aligned_free(void* ptr)
+{
+    if(!ptr)
+    {
+        return;
+    }
+    AllocTracker::record_free();
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+void* operator new(std::size_t size)
+{
+    auto ptr = tracked_malloc(size);
+    if(!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+    auto ptr = tracked_malloc(size);
+    if(!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return tracked_malloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return tracked_malloc(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    auto ptr = tracked_aligned_malloc(size, alignment);
+    if(!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    auto ptr = tracked_aligned_malloc(size, alignment);
+    if(!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return tracked_aligned_malloc(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return tracked_aligned_malloc(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept                                    { tracked_free(ptr); }
+void operator delete[](void* ptr) noexcept                                  { tracked_free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept                       { tracked_free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept                     { tracked_free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept             { tracked_free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept           { tracked_free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept                  { tracked_aligned_free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept                { tracked_aligned_free(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept     { tracked_aligned_free(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept   { tracked_aligned_free(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept   { tracked_aligned_free(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { tracked_aligned_free(ptr); }
+
+#endif
@@ -1,9 +1,14 @@
 #include "pch.h"
 
 #include <cmath>
+#include <cstring>
 #include "asset.h"
+#include "asset_file.h"
+#include "asset_indicators.h"
+#include "asset_stream.h"
 #include "containers.h"
 #include "settings.h"
+#include "thread_pool.h"
 #include "utils_array.h"
 #include "utils_string.h"
 #include "fmt/core.h"
@@ -18,11 +23,31 @@ using namespace Argus;
 
 using asset_sp_t = Asset::asset_sp_t;
 
+/// allocate cache line aligned storage for asset data
+template <typename T>
+static T* allocate_asset_data(size_t size)
+{
+    return static_cast<T*>(::operator new[](
+        (size ? size : 1) * sizeof(T), std::align_val_t{ASSET_DATA_ALIGNMENT}));
+}
+
+/// release storage allocated by allocate_asset_data
+static void free_asset_data(void* data)
+{
+    if(data)
+    {
+        ::operator delete[](data, std::align_val_t{ASSET_DATA_ALIGNMENT});
+    }
+}
+
 Asset::Asset(string asset_id_, string exchange_id_, string broker_id_, size_t warmup_,  AssetFrequency frequency_)              
 {
     this->asset_id = std::move(asset_id_);
     this->exchange_id = std::move(exchange_id_);
     this->broker_id = std::move(broker_id_);
+    this->asset_symbol = intern_symbol(SymbolType::Asset, this->asset_id);
+    this->exchange_symbol = intern_symbol(SymbolType::Exchange, this->exchange_id);
+    this->broker_symbol = intern_symbol(SymbolType::Broker, this->broker_id);
 
     this->rows = 0,
     this->cols = 0,
@@ -49,8 +74,9 @@ Asset::~Asset()
         return;
     }
 
-    // delete the underlying data
-    delete[] this->data;
+    // delete the underlying data, only the array of the asset's precision is allocated
+    free_asset_data(this->data);
+    free_asset_data(this->data_f32);
 
     // delete the datetime index
     delete[] this->datetime_index;
@@ -64,13 +90,14 @@ void Asset::reset_asset()
 {   
     // move datetime index and data pointer back to start
     this->current_index = this->warmup;
-    this->row = &this->data[this->warmup*this->cols];
+    this->set_row(this->warmup);
 
     for(auto& tracer : this->tracers)
     {   
         //TODO Not working?
         tracer->reset();
     }
+    this->tracer_index = this->current_index;
 }
 
 void Asset::build()
@@ -81,10 +108,17 @@ void Asset::build()
         ARGUS_RUNTIME_ERROR(ArgusErrorCode::NotBuilt);
     }
 
+    // tracers added since the asset was loaded may need more rows held behind the current row
+    if(this->stream_source)
+    {
+        this->stream_to(this->current_index);
+    }
+
     for(auto& tracer : this->tracers)
     {   
         tracer->build();
     }
+    this->tracer_index = this->current_index;
     this->is_built = true;
 }
 
@@ -108,10 +142,10 @@ void Asset::set_warmup(size_t warmup_)
     // move the asset forward forward #warmup rows 
     this->warmup = warmup_;
     this->current_index = warmup_;
-    this->row = &this->data[warmup * this->cols];
+    this->set_row(warmup_);
 }
 
-string Asset::get_asset_id() const
+string const & Asset::get_asset_id() const
 {
     return this->asset_id;
 }
@@ -138,6 +172,11 @@ asset_sp_t Asset::fork_view()
     {
         ARGUS_RUNTIME_ERROR(ArgusErrorCode::NotBuilt);
     }
+    // the window of a streaming asset moves, it can not be shared
+    if(this->stream_source)
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::NotImplemented);
+    }
 
     auto asset_view = std::make_shared<Asset>(
         this->asset_id, 
@@ -155,16 +194,81 @@ asset_sp_t Asset::fork_view()
         this->data, 
         this->datetime_index,
         this->rows, 
-        this->cols
+        this->cols,
+        this->layout
     );
+    // copy the strides in case the columns are padded or the data is an external view
+    asset_view->row_stride = this->row_stride;
+    asset_view->col_stride = this->col_stride;
+    asset_view->storage_owner = this->storage_owner;
     asset_view->open_column = this->open_column;
     asset_view->close_column = this->close_column;
     asset_view->current_index = this->current_index;
     asset_view->row = this->row;
+
+    // float32 storage is shared the same way
+    asset_view->precision = this->precision;
+    asset_view->data_f32 = this->data_f32;
+    asset_view->row_f32 = this->row_f32;
     return asset_view;
 }
 
-void Asset::load_view(double *data_, long long *datetime_index_, size_t rows_, size_t cols_){
+void Asset::set_layout(AssetLayout layout_, bool pad_columns)
+{
+    this->layout = layout_;
+    if(layout_ == AssetLayout::RowMajor)
+    {
+        this->row_stride = this->cols;
+        this->col_stride = 1;
+    }
+    else
+    {
+        // pad each column so the next one starts on an aligned boundary
+        size_t elements_per_line = ASSET_DATA_ALIGNMENT /
+            (this->precision == AssetPrecision::Float64 ? sizeof(double) : sizeof(float));
+        this->row_stride = 1;
+        this->col_stride = pad_columns ?
+            (this->rows + elements_per_line - 1) / elements_per_line * elements_per_line :
+            this->rows;
+    }
+}
+
+void Asset::set_row(size_t row_index)
+{
+    if(this->stream_source)
+    {
+        this->stream_to(row_index);
+    }
+    else if(this->precision == AssetPrecision::Float64)
+    {
+        this->row = &this->data[row_index * this->row_stride];
+    }
+    else
+    {
+        this->row_f32 = &this->data_f32[row_index * this->row_stride];
+    }
+}
+
+void Asset::allocate_storage()
+{
+    if(this->precision == AssetPrecision::Float64)
+    {
+        this->data = allocate_asset_data<double>(this->get_data_size());
+    }
+    else
+    {
+        this->data_f32 = allocate_asset_data<float>(this->get_data_size());
+    }
+}
+
+size_t Asset::get_data_size() const
+{
+    return this->layout == AssetLayout::RowMajor ?
+        this->rows * this->cols :
+        this->col_stride * this->cols;
+}
+
+void Asset::load_view(double *data_, long long *datetime_index_, size_t rows_, size_t cols_, AssetLayout layout_){
 #ifdef DEBUGGING
     printf("MEMORY: CALLING ASSET %s load_data() ON: %p \n", this->asset_id.c_str(), this);
 #endif  
@@ -178,6 +282,7 @@ void Asset::load_view(double *data_, long long *datetime_index_, size_t rows_, s
     // set the asset matrix size
     this->rows = rows_;
     this->cols = cols_;
+    this->set_layout(layout_, false);
 
     //is built and is a view
     this->is_view = true;
@@ -190,7 +295,16 @@ void Asset::load_view(double *data_, long long *datetime_index_, size_t rows_, s
 #endif
 }
 
-void Asset::load_data(const double *data_, const long long *datetime_index_, size_t rows_, size_t cols_)
+template <typename T>
+void Asset::load_columns(
+    const T *data_,
+    const long long *datetime_index_,
+    size_t rows_,
+    size_t cols_,
+    AssetLayout layout_,
+    AssetPrecision precision_,
+    size_t data_row_stride,
+    size_t data_col_stride)
 {
 #ifdef DEBUGGING
     printf("MEMORY: CALLING ASSET %s load_data() ON: %p \n", this->asset_id.c_str(), this);
@@ -200,33 +314,49 @@ void Asset::load_data(const double *data_, const long long *datetime_index_, siz
         throw runtime_error("asset is already built");
     }
 
+    // set the asset matrix size
+    this->rows = rows_;
+    this->cols = cols_;
+    this->precision = precision_;
+    this->set_layout(layout_, true);
+
     // allocate data array
-    this->data = new double[rows_ * cols_];
+    this->allocate_storage();
 
     // allocate datetime index
     this->datetime_index = new long long[rows_];
 
-    // set the asset matrix size
-    this->rows = rows_;
-    this->cols = cols_;
-
-    // copy the data from a column formated 1d array ([col1_0, col1_1, col2_0, col2_1])
-    for (int j = 0; j < cols_; j++) {
-        auto input_col_start = j * rows_;
-        for (int i = 0; i < rows_; i++) {
-            auto value = data_[input_col_start + i];
-            data[i * cols_ + j] = value;
+    // copy the data column by column from the strided source ([col1_0, col1_1, col2_0, col2_1] for a
+    // column formated 1d array) converting to the storage precision, column major destinations are
+    // written contiguously
+    auto copy_columns = [&](auto* dst)
+    {
+        using value_t = std::remove_pointer_t<decltype(dst)>;
+        for (size_t j = 0; j < cols_; j++) {
+            auto input_col_start = data_ + j * data_col_stride;
+            auto output_col_start = dst + j * this->col_stride;
+            for (size_t i = 0; i < rows_; i++) {
+                output_col_start[i * this->row_stride] = static_cast<value_t>(input_col_start[i * data_row_stride]);
+            }
         }
+    };
+    if(precision_ == AssetPrecision::Float64)
+    {
+        copy_columns(this->data);
+    }
+    else
+    {
+        copy_columns(this->data_f32);
     }
 
     // copy the datetime index into the asset
-    for (int i = 0; i < rows_; i++)
+    for (size_t i = 0; i < rows_; i++)
     {
         this->datetime_index[i] = datetime_index_[i];
     }
 
     //set row pointer to first row 
-    this->row = &this->data[this->warmup * this->cols];
+    this->set_row(this->warmup);
 
     // set load flag to true after copying data
     this->is_loaded = true;
@@ -237,41 +367,456 @@ void Asset::load_data(const double *data_, const long long *datetime_index_, siz
 #endif
 }
 
+void Asset::load_data(
+    const double *data_,
+    const long long *datetime_index_,
+    size_t rows_,
+    size_t cols_,
+    AssetLayout layout_,
+    AssetPrecision precision_)
+{
+    this->load_columns(data_, datetime_index_, rows_, cols_, layout_, precision_, 1, rows_);
+}
+
+void Asset::load_strided_data(
+    const double *data_,
+    const long long *datetime_index_,
+    size_t rows_,
+    size_t cols_,
+    size_t data_row_stride,
+    size_t data_col_stride,
+    AssetLayout layout_,
+    AssetPrecision precision_)
+{
+    this->load_columns(data_, datetime_index_, rows_, cols_, layout_, precision_, data_row_stride, data_col_stride);
+}
+
+void Asset::load_strided_data(
+    const float *data_,
+    const long long *datetime_index_,
+    size_t rows_,
+    size_t cols_,
+    size_t data_row_stride,
+    size_t data_col_stride,
+    AssetLayout layout_,
+    AssetPrecision precision_)
+{
+    this->load_columns(data_, datetime_index_, rows_, cols_, layout_, precision_, data_row_stride, data_col_stride);
+}
+
+void Asset::allocate_data(size_t rows_, size_t cols_, AssetLayout layout_, AssetPrecision precision_)
+{
+    if (this->is_built || this->is_loaded)
+    {
+        throw runtime_error("asset is already loaded");
+    }
+
+    // set the asset matrix size
+    this->rows = rows_;
+    this->cols = cols_;
+    this->precision = precision_;
+    this->set_layout(layout_, true);
+
+    // allocate data array and datetime index, values are written in place by the caller
+    this->allocate_storage();
+    this->datetime_index = new long long[rows_];
+
+    //set row pointer to first row
+    this->set_row(this->warmup);
+    this->is_loaded = true;
+}
+
+/// is the buffer a float64 buffer
+static bool is_double_buffer(const py::buffer_info& info)
+{
+    return info.itemsize == sizeof(double) && info.format == py::format_descriptor<double>::format();
+}
+
+/// is the buffer a float32 buffer
+static bool is_float_buffer(const py::buffer_info& info)
+{
+    return info.itemsize == sizeof(float) && info.format == py::format_descriptor<float>::format();
+}
+
+/// is the buffer a contiguous 1d int64 buffer (numpy reports int64 as 'l' or 'q' depending on the platform)
+static bool is_datetime_buffer(const py::buffer_info& info)
+{
+    return info.itemsize == sizeof(long long)
+        && !info.format.empty()
+        && (info.format.back() == 'l' || info.format.back() == 'q')
+        && info.ndim == 1
+        && info.strides[0] == sizeof(long long);
+}
+
 void Asset::py_load_data(
     const py::buffer &py_data,
     const py::buffer &py_datetime_index,
     size_t rows_,
     size_t cols_,
-    bool is_view)
+    bool is_view,
+    AssetLayout layout_,
+    AssetPrecision precision_)
 {
     if(headers.size() == 0)
     {   
         ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidArrayLength);
     }
 
+    // zero copy load holding a reference to the python buffers. A view keeps the layout of the
+    // buffer, so asking for anything but the default layout can not be honored
+    if(is_view)
+    {
+        if(layout_ != AssetLayout::RowMajor)
+        {
+            ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidDataRequest);
+        }
+        this->py_load_view(py_data, py_datetime_index);
+        if(this->rows != rows_ || this->cols != cols_)
+        {
+            ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidArrayLength);
+        }
+        return;
+    }
+
+    py::buffer_info data_info = py_data.request();
+    py::buffer_info datetime_index_info = py_datetime_index.request();
+    if(!(is_double_buffer(data_info) || is_float_buffer(data_info)) || !is_datetime_buffer(datetime_index_info))
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidArrayType);
+    }
+    if(static_cast<size_t>(data_info.size) != rows_ * cols_ 
+        || static_cast<size_t>(datetime_index_info.size) != rows_)
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidArrayLength);
+    }
+
+    // pass raw pointer to c loading function and copy data, converting to the storage precision
+    auto datetime_index_ = static_cast<long long *>(datetime_index_info.ptr);
+    if(is_double_buffer(data_info))
+    {
+        this->load_columns(static_cast<double *>(data_info.ptr), datetime_index_, rows_, cols_, layout_, precision_, 1, rows_);
+    }
+    else
+    {
+        this->load_columns(static_cast<float *>(data_info.ptr), datetime_index_, rows_, cols_, layout_, precision_, 1, rows_);
+    }
+}
+
+void Asset::py_load_view(const py::buffer &py_data, const py::buffer &py_datetime_index)
+{
+    if(this->headers.size() == 0)
+    {   
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidArrayLength);
+    }
+
     py::buffer_info data_info = py_data.request();
     py::buffer_info datetime_index_info = py_datetime_index.request();
+    if(!(is_double_buffer(data_info) || is_float_buffer(data_info)) || !is_datetime_buffer(datetime_index_info))
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidArrayType);
+    }
+
+    // derive the shape and element strides of the data, only positive strides that land on
+    // element boundaries can be viewed
+    auto itemsize = static_cast<py::ssize_t>(data_info.itemsize);
+    size_t rows_, cols_, row_stride_, col_stride_;
+    if(data_info.ndim == 2)
+    {
+        if(data_info.strides[0] <= 0 || data_info.strides[1] <= 0
+            || data_info.strides[0] % itemsize || data_info.strides[1] % itemsize)
+        {
+            ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidArrayValues);
+        }
+        rows_ = data_info.shape[0];
+        cols_ = data_info.shape[1];
+        row_stride_ = data_info.strides[0] / itemsize;
+        col_stride_ = data_info.strides[1] / itemsize;
+    }
+    else if(data_info.ndim == 1)
+    {
+        // columns back to back, the number of columns is given by the headers
+        cols_ = this->headers.size();
+        if(data_info.strides[0] != itemsize || data_info.shape[0] % cols_)
+        {
+            ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidArrayValues);
+        }
+        rows_ = data_info.shape[0] / cols_;
+        row_stride_ = 1;
+        col_stride_ = rows_;
+    }
+    else
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidArrayLength);
+    }
+
+    if(cols_ != this->headers.size() || static_cast<size_t>(datetime_index_info.shape[0]) != rows_)
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidArrayLength);
+    }
+
+    // hold a reference to both python objects. The asset can be released from native code so
+    // the gil is reacquired before the references are dropped
+    auto owner = shared_ptr<void>(
+        new std::pair<py::object, py::object>(py_data, py_datetime_index),
+        [](void* ptr)
+        {
+            py::gil_scoped_acquire gil;
+            delete static_cast<std::pair<py::object, py::object>*>(ptr);
+        });
 
-    // cast the python buffers to raw pointer
-    auto data_ = static_cast<double *>(data_info.ptr);
     auto datetime_index_ = static_cast<long long *>(datetime_index_info.ptr);
+    if(is_double_buffer(data_info))
+    {
+        this->load_owned_view(static_cast<double *>(data_info.ptr), datetime_index_,
+            rows_, cols_, row_stride_, col_stride_, std::move(owner));
+    }
+    else
+    {
+        this->load_owned_view(static_cast<float *>(data_info.ptr), datetime_index_,
+            rows_, cols_, row_stride_, col_stride_, std::move(owner));
+    }
+}
+
+void Asset::save_binary(const string& path)
+{
+    save_asset_file(*this, path);
+}
+
+void Asset::load_mmap(const string& path)
+{
+    if (this->is_built || this->is_loaded)
+    {
+        throw runtime_error("asset is already loaded");
+    }
+    load_asset_file(*this, path);
+}
+
+void Asset::load_file_stream(const string& path, size_t chunk_rows, size_t lookback)
+{
+    if (this->is_built || this->is_loaded)
+    {
+        throw runtime_error("asset is already loaded");
+    }
+    load_asset_file_stream(*this, path, chunk_rows, lookback);
+}
+
+void Asset::py_load_stream(
+    py::object chunks,
+    const py::buffer &py_datetime_index,
+    size_t chunk_rows,
+    size_t lookback)
+{
+    if(this->headers.size() == 0)
+    {   
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidArrayLength);
+    }
+    py::buffer_info datetime_index_info = py_datetime_index.request();
+    if(!is_datetime_buffer(datetime_index_info))
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidArrayType);
+    }
+
+    auto source = std::make_shared<PyChunkSource>(std::move(chunks), this->headers.size());
+    this->load_stream(
+        std::move(source),
+        static_cast<long long *>(datetime_index_info.ptr),
+        static_cast<size_t>(datetime_index_info.shape[0]),
+        chunk_rows,
+        lookback);
+}
+
+void Asset::load_stream(
+    shared_ptr<AssetChunkSource> source,
+    const long long *datetime_index_,
+    size_t rows_,
+    size_t chunk_rows,
+    size_t lookback)
+{
+    if (this->is_built || this->is_loaded)
+    {
+        throw runtime_error("asset is already loaded");
+    }
+    if(!source || source->get_cols() != this->headers.size() || rows_ == 0 || chunk_rows == 0)
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidArrayLength);
+    }
 
-    // pass raw pointer to c loading function and copy data
-    if(!is_view)
+    // streamed rows are always row major doubles, only the datetime index is held in full
+    this->rows = rows_;
+    this->cols = source->get_cols();
+    this->precision = AssetPrecision::Float64;
+    this->set_layout(AssetLayout::RowMajor, false);
+    this->datetime_index = new long long[rows_];
+    std::copy(datetime_index_, datetime_index_ + rows_, this->datetime_index);
+
+    this->stream_source = std::move(source);
+    this->stream_source->reset();
+    this->stream_position = 0;
+    this->stream_chunk_rows = chunk_rows;
+    this->stream_lookback = lookback;
+    this->window_start = 0;
+    this->window_rows = 0;
+
+    // fill the first window, set_row moves it to the warmup
+    this->set_row(this->warmup);
+    this->is_loaded = true;
+}
+
+size_t Asset::get_stream_retain() const
+{
+    // tracer windows span lookback + 1 rows ending at the current row, tracers replaying more rows
+    // when built keep those held so a rebuild reads the same rows as it would in memory
+    auto retain = this->stream_lookback;
+    for(auto const & tracer : this->tracers)
+    {
+        retain = std::max(retain, tracer->get_history());
+    }
+    return retain + 2;
+}
+
+void Asset::stream_to(size_t row_index)
+{
+    auto retain = this->get_stream_retain();
+    auto keep_start = row_index > retain ? row_index - retain : 0;
+    auto window_end = this->window_start + this->window_rows;
+
+    // the row and the rows retained behind it are already held
+    if(keep_start >= this->window_start && row_index < window_end)
+    {
+        this->row = this->data + (row_index - this->window_start) * this->row_stride;
+        return;
+    }
+
+    // moving backwards restarts the source from the first row
+    if(keep_start < this->window_start)
     {
-        this->load_data(data_, datetime_index_, rows_, cols_);
+        this->stream_source->reset();
+        this->stream_position = 0;
+        this->window_start = 0;
+        this->window_rows = 0;
+        window_end = 0;
+    }
+
+    // grow the window if tracers added since the last refill retain more rows
+    auto buffer = this->data;
+    auto capacity = std::max(this->window_capacity, retain + this->stream_chunk_rows);
+    if(capacity != this->window_capacity)
+    {
+        buffer = allocate_asset_data<double>(capacity * this->cols);
+    }
+
+    // move the rows still needed to the front of the window, tracer windows move with them
+    size_t kept = 0;
+    if(keep_start < window_end)
+    {
+        kept = window_end - keep_start;
+        auto kept_rows = this->data + (keep_start - this->window_start) * this->row_stride;
+        std::memmove(buffer, kept_rows, kept * this->row_stride * sizeof(double));
+        if(this->is_built)
+        {
+            for(auto& tracer : this->tracers)
+            {
+                tracer->rebase(kept_rows + this->close_column, buffer + this->close_column);
+            }
+        }
     }
-    // pass raw pointer and mirror the asset pointer to the data passed in the py buffers
     else
     {
-        this->load_view(data_, datetime_index_, rows_, cols_);
+        this->stream_source->skip(keep_start - this->stream_position);
+        this->stream_position = keep_start;
     }
+
+    if(buffer != this->data)
+    {
+        free_asset_data(this->data);
+        this->data = buffer;
+        this->window_capacity = capacity;
+    }
+    this->window_start = keep_start;
+    this->window_rows = kept;
+
+    // fill the rest of the window from the source
+    auto rows_wanted = std::min(this->window_capacity - kept, this->rows - this->stream_position);
+    auto rows_read = this->stream_source->read(this->data + kept * this->row_stride, rows_wanted);
+    this->window_rows += rows_read;
+    this->stream_position += rows_read;
+    if(row_index >= this->window_start + this->window_rows)
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidArrayLength);
+    }
+    this->row = this->data + (row_index - this->window_start) * this->row_stride;
+}
+
+void Asset::load_owned_view(
+    double *data_,
+    long long *datetime_index_,
+    size_t rows_,
+    size_t cols_,
+    size_t row_stride_,
+    size_t col_stride_,
+    shared_ptr<void> owner)
+{
+    if (this->is_built || this->is_loaded)
+    {
+        throw runtime_error("asset is already loaded");
+    }
+
+    // point directly at the external storage
+    this->data = data_;
+    this->precision = AssetPrecision::Float64;
+    this->attach_view(datetime_index_, rows_, cols_, row_stride_, col_stride_, std::move(owner));
+}
+
+void Asset::load_owned_view(
+    float *data_,
+    long long *datetime_index_,
+    size_t rows_,
+    size_t cols_,
+    size_t row_stride_,
+    size_t col_stride_,
+    shared_ptr<void> owner)
+{
+    if (this->is_built || this->is_loaded)
+    {
+        throw runtime_error("asset is already loaded");
+    }
+
+    // point directly at the external storage
+    this->data_f32 = data_;
+    this->precision = AssetPrecision::Float32;
+    this->attach_view(datetime_index_, rows_, cols_, row_stride_, col_stride_, std::move(owner));
+}
+
+void Asset::attach_view(
+    long long *datetime_index_,
+    size_t rows_,
+    size_t cols_,
+    size_t row_stride_,
+    size_t col_stride_,
+    shared_ptr<void> owner)
+{
+    this->datetime_index = datetime_index_;
+    this->storage_owner = std::move(owner);
+
+    // set the asset matrix size and strides
+    this->rows = rows_;
+    this->cols = cols_;
+    this->row_stride = row_stride_;
+    this->col_stride = col_stride_;
+    this->layout = row_stride_ == 1 ? AssetLayout::ColumnMajor : AssetLayout::RowMajor;
+
+    // the asset does not own the data, it is released with the owner
+    this->is_view = true;
+    this->is_loaded = true;
+
+    //set row pointer to first row
+    this->set_row(this->warmup);
 }
 
 double Asset::c_get(size_t column_index) const
 {
     // derefence data pointer at current row plus column offset
-    return *(this->row - this->cols + column_index);
+    return this->row_value(column_index * this->col_stride - this->row_stride);
 }
 
 double Asset::get_tracer_value(AssetTracerType tracer_type) const
@@ -281,6 +826,7 @@ double Asset::get_tracer_value(AssetTracerType tracer_type) const
     {
          ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidTracerType);
     }
+    this->catch_up_tracers();
     switch (tracer_type)
     {
     case AssetTracerType::Volatility:
@@ -295,7 +841,30 @@ double Asset::get_tracer_value(AssetTracerType tracer_type) const
             ARGUS_RUNTIME_ERROR(ArgusErrorCode::NotWarm);
         }
         return *this->beta.value();
+    default:
+        if(!tracer.value()->get_is_warm())
+        {
+            ARGUS_RUNTIME_ERROR(ArgusErrorCode::NotWarm);
+        }
+        return tracer.value()->get_value();
+    }
+}
+
+optional<size_t> Asset::get_feature_index(const string& name) const
+{
+    auto column_index = this->get_column_index(name);
+    if(column_index.has_value())
+    {
+        return column_index;
+    }
+    for(size_t i = 0; i < this->tracers.size(); i++)
+    {
+        if(this->tracers[i]->name == name)
+        {
+            return this->cols + i;
+        }
     }
+    return nullopt;
 }
 
 double Asset::get_volatility() const
@@ -322,12 +891,30 @@ double Asset::get(const std::string &column, size_t row_index) const
         // Catch the exception and re-raise it as a Python KeyError
         throw py::key_error(e.what());
     }
-    // make sure the row index is valid
-    if (row_index >= this->rows)
+    // make sure the row index is valid and held in the window of a streaming asset
+    if (row_index >= this->rows 
+        || row_index < this->window_start
+        || (this->stream_source && row_index >= this->window_start + this->window_rows))
     {
         ARGUS_RUNTIME_ERROR(ArgusErrorCode::IndexOutOfBounds);
     }
-    return this->data[row_index * this->cols + column_index];
+    return this->data_value((row_index - this->window_start) * this->row_stride + column_index * this->col_stride);
+}
+
+double Asset::get(const FeatureHandle& handle, size_t row_index) const
+{
+    if(handle.column_index == FEATURE_UNRESOLVED)
+    {
+        return this->get(handle.column, row_index);
+    }
+    if (handle.column_index >= this->cols 
+        || row_index >= this->rows
+        || row_index < this->window_start
+        || (this->stream_source && row_index >= this->window_start + this->window_rows))
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::IndexOutOfBounds);
+    }
+    return this->data_value((row_index - this->window_start) * this->row_stride + handle.column_index * this->col_stride);
 }
 
 double Asset::get_market_price(bool on_close) const
@@ -335,107 +922,174 @@ double Asset::get_market_price(bool on_close) const
 
     #ifdef ARGUS_RUNTIME_ASSERT
     //make sure row pointer is not out of bounds
-    ptrdiff_t index = this->row - this->data; 
-    auto size = this->rows * this->cols;
-    assert(index - this->cols  < size);
+    ptrdiff_t index = this->current_index; 
+    assert(index - 1 < this->rows);
     #endif
 
-    //subtract this->cols to move back row, then get_market_view is called, asset->step()
+    //subtract this->row_stride to move back row, then get_market_view is called, asset->step()
     //is called so we need to move back a row when accessing asset data
     if (on_close)
-        return *(this->row - this->cols + this->close_column);
+        return this->row_value(this->close_column * this->col_stride - this->row_stride);
     else
-        return *(this->row - this->cols + this->open_column);
+        return this->row_value(this->open_column * this->col_stride - this->row_stride);
 }
 
 double Asset::get_asset_feature(const string& column_name, int index, optional<AssetTracerType> query_scaler)
 {
-    #ifdef ARGUS_RUNTIME_ASSERT
-    //make sure row pointer is not out of bounds
-    ptrdiff_t ptr_index = this->row - this->data; 
-    auto size = this->rows * this->cols;
-    assert(ptr_index - this->cols < size);
-    assert(index <= 0);
-    #endif
-
-    //subtract this->cols to move back row, then get_market_view is called, asset->step()
-    //is called so we need to move back a row when accessing asset data
     auto column_offset = this->headers.find(column_name);
-    auto row_offset = static_cast<int>(this->cols) * index;
+    if(column_offset != this->headers.end())
+    {
+        return this->read_feature(column_offset->second, index, query_scaler);
+    }
 
-    #ifdef ARGUS_RUNTIME_ASSERT
-    if(column_offset == this->headers.end()){
+    // names that are not columns are read from the tracers
+    auto feature_index = this->get_feature_index(column_name);
+    if(!feature_index.has_value())
+    {
         ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidDataRequest);
     }
-    #endif
+    return this->read_feature(feature_index.value(), index, query_scaler);
+}
 
+FeatureHandle Asset::get_feature_handle(const string& column_name, optional<AssetTracerType> query_scaler) const
+{
+    auto column_index = this->get_feature_index(column_name);
+    if(!column_index.has_value())
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidDataRequest);
+    }
+    return FeatureHandle{column_name, column_index.value(), query_scaler};
+}
+
+double Asset::get_asset_feature(const FeatureHandle& handle, int index)
+{
+    // handles resolved against assets that disagree on the column index fall back to the headers
+    if(handle.column_index == FEATURE_UNRESOLVED)
+    {
+        return this->get_asset_feature(handle.column, index, handle.query_scaler);
+    }
+
+    // handles come from python and may have been resolved against an asset with more features
+    if(handle.column_index >= this->cols + this->tracers.size())
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::IndexOutOfBounds);
+    }
+
+    return this->read_feature(handle.column_index, index, handle.query_scaler);
+}
+
+double Asset::read_feature(size_t column_index, int index, optional<AssetTracerType> query_scaler) const
+{
+    #ifdef ARGUS_RUNTIME_ASSERT
+    //make sure row pointer is not out of bounds
+    ptrdiff_t ptr_index = this->current_index; 
+    assert(ptr_index - 1 < this->rows);
+    assert(index <= 0);
     //prevent acces index < 0
-    assert(row_offset + ptr_index > 0);
-    auto asset_value = *(this->row - this->cols + column_offset->second + row_offset);
+    assert(index + ptr_index > 0);
+    #endif
+
+    double asset_value;
+    if(column_index < this->cols)
+    {
+        //subtract this->row_stride to move back row, then get_market_view is called, asset->step()
+        //is called so we need to move back a row when accessing asset data
+        auto row_offset = static_cast<ptrdiff_t>(this->row_stride) * index;
+        asset_value = this->row_value(
+            static_cast<ptrdiff_t>(column_index * this->col_stride) - static_cast<ptrdiff_t>(this->row_stride) + row_offset);
+    }
+    else
+    {
+        // tracers only hold their current value
+        auto const & tracer = this->tracers[column_index - this->cols];
+        if(index != 0)
+        {
+            ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidDataRequest);
+        }
+        this->catch_up_tracers();
+        if(!tracer->get_is_warm())
+        {
+            ARGUS_RUNTIME_ERROR(ArgusErrorCode::NotWarm);
+        }
+        asset_value = tracer->get_value();
+    }
     
     if(!query_scaler.has_value())
     {
         return asset_value;
     }
-
-    switch (query_scaler.value())
-    {
-        case AssetTracerType::Volatility:
-            asset_value /= this->get_volatility();
-            break;
-        case AssetTracerType::Beta:
-            asset_value /= this->get_beta();
-            break;
-        default:
-            ARGUS_RUNTIME_ERROR(ArgusErrorCode::NotImplemented);
-    }
-    return asset_value;
+    return asset_value / this->get_tracer_value(query_scaler.value());
 }
 
-py::array_t<double> Asset::get_column(const string& column_name, size_t length)
+py::array Asset::get_column(const string& column_name, size_t length, py::handle owner)
 {
     if(length >= this->current_index)
     {
         ARGUS_RUNTIME_ERROR(ArgusErrorCode::IndexOutOfBounds);
     }
-    // if length 0 is passed return the entire column
-    else if(length == 0)
-    {
-        auto column_offset = this->headers.find(column_name);
-        auto column_start = this->data + column_offset->second;
-        return py::array( 
-        py::buffer_info
-            (
-                column_start,                           /* Pointer to buffer */
-                sizeof(double),                         /* Size of one scalar */
-                py::format_descriptor<double>::format(),/* Python struct-style format descriptor */
-                1,                                      /* Number of dimensions */
-                { this->rows },                         /* Buffer dimensions */
-                { sizeof(double) * this->cols}          /* buffer stride*/
-            )
-    );
-    }
 
     auto column_offset = this->headers.find(column_name);
-    auto row_offset = static_cast<int>(this->cols) * length;
-    
-    auto column_start = this->row - this->cols + column_offset->second - row_offset;
-    return py::array( 
-        py::buffer_info
-            (
-                column_start,                           /* Pointer to buffer */
-                sizeof(double),                         /* Size of one scalar */
-                py::format_descriptor<double>::format(),/* Python struct-style format descriptor */
-                1,                                      /* Number of dimensions */
-                { length },                             /* Buffer dimensions */
-                { sizeof(double) * this->cols}          /* buffer stride*/
-            )
-    );
+    if(column_offset == this->headers.end())
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidDataRequest);
+    }
+
+    // columns are returned as read only views into the asset's data, contiguous for column major assets.
+    // if length 0 is passed return the entire column, streaming assets only hold their window
+    auto row_stride = static_cast<py::ssize_t>(this->row_stride);
+    auto start_row = length == 0 ? 0 : this->current_index - (length + 1);
+    if(start_row < this->window_start || (length == 0 && this->stream_source))
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::IndexOutOfBounds);
+    }
+    auto shape = static_cast<py::ssize_t>(length == 0 ? this->rows : length);
+    auto offset = (start_row - this->window_start) * this->row_stride + column_offset->second * this->col_stride;
+
+    // a streaming asset's window is moved or reallocated on refill, its columns are copied
+    if(this->stream_source)
+    {
+        if(this->precision == AssetPrecision::Float32)
+        {
+            return to_py_array_copy(this->data_f32 + offset, shape, row_stride);
+        }
+        return to_py_array_copy(this->data + offset, shape, row_stride);
+    }
+    if(this->precision == AssetPrecision::Float32)
+    {
+        return to_py_array_strided(this->data_f32 + offset, {shape}, {row_stride}, true, owner);
+    }
+    return to_py_array_strided(this->data + offset, {shape}, {row_stride}, true, owner);
 }
 
 double* Asset::get_column_ptr(size_t column_index)
 {
-    return this->data + column_index;
+    return this->data ? this->data + column_index * this->col_stride : nullptr;
+}
+
+float* Asset::get_column_ptr_f32(size_t column_index)
+{
+    return this->data_f32 ? this->data_f32 + column_index * this->col_stride : nullptr;
+}
+
+double* Asset::get_column_series(size_t column_index)
+{
+    if(this->precision == AssetPrecision::Float64)
+    {
+        return this->get_column_ptr(column_index);
+    }
+
+    // widen the column once, tracers keep pointers into it
+    auto& column_f64 = this->columns_f64[column_index];
+    if(column_f64.empty())
+    {
+        auto column = this->get_column_ptr_f32(column_index);
+        column_f64.resize(this->rows);
+        for(size_t i = 0; i < this->rows; i++)
+        {
+            column_f64[i] = column[i * this->row_stride];
+        }
+    }
+    return column_f64.data();
 }
 
 long long *Asset::get_datetime_index(bool warmup_start) const
@@ -450,20 +1104,39 @@ long long *Asset::get_datetime_index(bool warmup_start) const
     }
 }
 
-py::array_t<double> Asset::get_data_view()
+py::array Asset::get_data_view(py::handle owner)
 {
     if (!this->is_loaded)
     {
         ARGUS_RUNTIME_ERROR(ArgusErrorCode::NotBuilt);
     }
-    return to_py_array(
-        this->data,
-        this->rows * this->cols,
-        true
-    );
+
+    // a streaming asset's window is moved or reallocated on refill, the rows it holds are copied.
+    // streamed rows are always row major doubles
+    if(this->stream_source)
+    {
+        py::array_t<double> window({static_cast<py::ssize_t>(this->window_rows), static_cast<py::ssize_t>(this->cols)});
+        auto values = window.mutable_data();
+        for(size_t i = 0; i < this->window_rows; i++)
+        {
+            for(size_t j = 0; j < this->cols; j++)
+            {
+                values[i * this->cols + j] = this->data[i * this->row_stride + j * this->col_stride];
+            }
+        }
+        return window;
+    }
+
+    vector<py::ssize_t> shape = {static_cast<py::ssize_t>(this->rows), static_cast<py::ssize_t>(this->cols)};
+    vector<py::ssize_t> strides = {static_cast<py::ssize_t>(this->row_stride), static_cast<py::ssize_t>(this->col_stride)};
+    if(this->precision == AssetPrecision::Float32)
+    {
+        return to_py_array_strided(this->data_f32, shape, strides, true, owner);
+    }
+    return to_py_array_strided(this->data, shape, strides, true, owner);
 }
 
-py::array_t<long long> Asset::get_datetime_index_view()
+py::array_t<long long> Asset::get_datetime_index_view(py::handle owner)
 {
     if (!this->is_loaded)
     {
@@ -473,7 +1146,8 @@ py::array_t<long long> Asset::get_datetime_index_view()
     return to_py_array(
         this->datetime_index,
         this->rows,
-        true);
+        true,
+        owner);
 };
 
 std::vector<string> Asset::get_headers()
@@ -495,23 +1169,27 @@ long long *Asset::get_asset_time() const
 
 void Asset::goto_datetime(long long datetime)
 {
+    // the next row exposed is the first at or after the datetime, never before the warmup
+    this->current_index = sorted_array_lower_bound(
+        this->datetime_index,
+        this->warmup,
+        this->rows,
+        datetime
+    );
+
     //goto date is beyond the datetime index
-   if(datetime >= this->datetime_index[this->rows-1])
+    if(this->current_index == this->rows)
     {
-        this->current_index = this->rows;
+        return;
     }
-    
-    // search for datetime in the index
-    for(int i = this->current_index; i < this->rows; i++)
+
+    // move the data pointer directly then rebuild the tracers from the window behind it
+    this->set_row(this->current_index);
+    for(auto& tracer : this->tracers)
     {   
-        this->step();
-        if(*this->get_asset_time() >= datetime)
-        {
-            return;
-        }
+        tracer->reset();
     }
-
-    throw std::runtime_error("failed to find datetime in asset goto");    
+    this->tracer_index = this->current_index;
 }
 
 std::shared_ptr<Asset> new_asset(
@@ -523,23 +1201,169 @@ std::shared_ptr<Asset> new_asset(
     return std::make_shared<Asset>(asset_id, exchange_id, broker_id,warmup);
 }
 
+vector<std::shared_ptr<Asset>> py_load_assets(
+    const vector<string>& asset_ids,
+    const string& exchange_id,
+    const string& broker_id,
+    const vector<vector<string>>& headers,
+    const vector<py::buffer>& data,
+    const vector<py::buffer>& datetime_indexes,
+    size_t warmup,
+    AssetLayout layout,
+    AssetPrecision precision,
+    ThreadPool* thread_pool)
+{
+    auto count = asset_ids.size();
+    if(headers.size() != count || data.size() != count || datetime_indexes.size() != count)
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidArrayLength);
+    }
+
+    // ids are interned and the buffers requested on the calling thread while it holds the gil
+    vector<std::shared_ptr<Asset>> assets;
+    vector<py::buffer_info> data_infos;
+    vector<py::buffer_info> index_infos;
+    assets.reserve(count);
+    data_infos.reserve(count);
+    index_infos.reserve(count);
+    for(size_t i = 0; i < count; i++)
+    {
+        auto data_info = data[i].request();
+        auto index_info = datetime_indexes[i].request();
+        if(!(is_double_buffer(data_info) || is_float_buffer(data_info)) || data_info.ndim != 2
+            || data_info.strides[0] < 0 || data_info.strides[1] < 0
+            || data_info.strides[0] % data_info.itemsize != 0 || data_info.strides[1] % data_info.itemsize != 0
+            || !is_datetime_buffer(index_info))
+        {
+            ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidArrayType);
+        }
+        if(data_info.shape[0] != index_info.size || static_cast<size_t>(data_info.shape[1]) != headers[i].size())
+        {
+            ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidArrayLength);
+        }
+        auto asset = new_asset(asset_ids[i], exchange_id, broker_id, warmup);
+        asset->load_headers(headers[i]);
+        assets.push_back(std::move(asset));
+        data_infos.push_back(std::move(data_info));
+        index_infos.push_back(std::move(index_info));
+    }
+
+    // the copies and transposes only touch the asset and the buffers
+    auto load_range = [&](size_t begin, size_t end)
+    {
+        for(size_t i = begin; i < end; i++)
+        {
+            auto const & data_info = data_infos[i];
+            auto rows = static_cast<size_t>(data_info.shape[0]);
+            auto cols = static_cast<size_t>(data_info.shape[1]);
+            auto row_stride = static_cast<size_t>(data_info.strides[0] / data_info.itemsize);
+            auto col_stride = static_cast<size_t>(data_info.strides[1] / data_info.itemsize);
+            auto datetime_index = static_cast<long long const *>(index_infos[i].ptr);
+            if(is_double_buffer(data_info))
+            {
+                assets[i]->load_strided_data(static_cast<double const *>(data_info.ptr), datetime_index,
+                    rows, cols, row_stride, col_stride, layout, precision);
+            }
+            else
+            {
+                assets[i]->load_strided_data(static_cast<float const *>(data_info.ptr), datetime_index,
+                    rows, cols, row_stride, col_stride, layout, precision);
+            }
+        }
+    };
+    {
+        py::gil_scoped_release release;
+        if(thread_pool)
+        {
+            thread_pool->parallel_for(count, 1, load_range);
+        }
+        else
+        {
+            load_range(0, count);
+        }
+    }
+    return assets;
+}
+
+bool Asset::get_is_thread_safe() const
+{
+    return !this->stream_source || !this->stream_source->needs_gil();
+}
+
 void Asset::step(){
+    // streaming assets refill their window before moving onto a row that is not held, lazy tracers
+    // catch up first as the rows they skipped may not be kept
+    if(this->stream_source && this->current_index == this->window_start + this->window_rows)
+    {
+        this->catch_up_tracers();
+        this->stream_to(this->current_index);
+    }
+
     // move the row pointer forward to the next row
-    this->row += this->cols;
+    if(this->precision == AssetPrecision::Float64)
+    {
+        this->row += this->row_stride;
+    }
+    else
+    {
+        this->row_f32 += this->row_stride;
+    }
 
     // move the current index forward
     this->current_index++; 
 
-    // move any tracers forward
-    if(this->tracers.size())
+    // move any tracers forward, banked tracers are stepped by the exchange
+    if(!this->lazy_tracers)
+    {
+        for(auto tracer : this->step_tracers)
+        {
+            tracer->step();
+        }
+        this->tracer_index = this->current_index;
+        return;
+    }
+
+    // lazy tracers are stepped when read, the others still step with the asset
+    for(auto tracer : this->step_tracers)
     {
-        for(auto& tracer : this->tracers)
+        if(!tracer->get_is_deferrable())
         {
             tracer->step();
         }
     }
 }
 
+void Asset::catch_up_tracers() const
+{
+    // tracers are built at the current index
+    if(!this->is_built)
+    {
+        return;
+    }
+
+    // each skipped row is stepped in order so the values match stepping with the asset
+    for(; this->tracer_index < this->current_index; this->tracer_index++)
+    {
+        for(auto const & tracer : this->tracers)
+        {
+            if(tracer->get_is_deferrable())
+            {
+                tracer->step();
+            }
+        }
+    }
+}
+
+void Asset::set_lazy_tracers(bool lazy_tracers_)
+{
+    // tracers are caught up before they go back to stepping with the asset
+    if(!lazy_tracers_)
+    {
+        this->catch_up_tracers();
+    }
+    this->lazy_tracers = lazy_tracers_;
+}
+
 optional<shared_ptr<AssetTracer>> Asset::get_tracer(AssetTracerType tracer_type) const{
     auto tracer = vector_get(
         this->tracers,
@@ -548,53 +1372,160 @@ optional<shared_ptr<AssetTracer>> Asset::get_tracer(AssetTracerType tracer_type)
     return tracer;
 };
 
-void Asset::add_tracer(AssetTracerType tracer_type, size_t lookback, bool adjust_warmup)
+/// prefix of the generated feature name of a tracer type
+static string tracer_name_prefix(AssetTracerType tracer_type)
+{
+    switch (tracer_type)
+    {
+        case AssetTracerType::Volatility:               return "volatility";
+        case AssetTracerType::Beta:                     return "beta";
+        case AssetTracerType::MovingAverage:            return "sma";
+        case AssetTracerType::ExponentialMovingAverage: return "ema";
+        case AssetTracerType::RollingMin:               return "min";
+        case AssetTracerType::RollingMax:               return "max";
+        case AssetTracerType::RollingZScore:            return "zscore";
+        case AssetTracerType::AverageTrueRange:         return "atr";
+    }
+    ARGUS_RUNTIME_ERROR(ArgusErrorCode::NotImplemented);
+}
+
+void Asset::add_tracer(
+    AssetTracerType tracer_type,
+    size_t lookback,
+    bool adjust_warmup,
+    const string& column,
+    const string& name)
 {
-    // as of now each tracer must have unique type
-    if(this->get_tracer(tracer_type).has_value())
+    // as of now each asset can only have one volatility and beta tracer, checked before the tracer
+    // is built as building a beta tracer adds a volatility tracer to the index asset
+    bool unique_type = tracer_type == AssetTracerType::Volatility || tracer_type == AssetTracerType::Beta;
+    bool column_tracer = !unique_type && tracer_type != AssetTracerType::AverageTrueRange;
+    if(unique_type && this->get_tracer(tracer_type).has_value())
     {
         ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidTracerType);
     }
-    switch (tracer_type)
+
+    // resolve the column read by the tracer
+    auto column_index = this->close_column;
+    if(column_tracer && !column.empty())
     {
-        case AssetTracerType::Volatility:
+        auto index = this->get_column_index(column);
+        if(!index.has_value())
         {
-            auto new_tracer = std::make_shared<VolatilityTracer>(this, lookback, adjust_warmup);
-            this->tracers.push_back(new_tracer);
-            break;
+            ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidDataRequest);
         }
-        case AssetTracerType::Beta:
+        column_index = index.value();
+    }
+
+    // tracers are read by name after the columns, a name can not be taken twice
+    auto tracer_name = name;
+    if(tracer_name.empty())
+    {
+        tracer_name = tracer_name_prefix(tracer_type) + "_" + std::to_string(lookback);
+        if(column_tracer)
         {
-            auto new_tracer = std::make_shared<BetaTracer>(this, lookback, adjust_warmup);
-            this->tracers.push_back(new_tracer);
-            break;    
+            tracer_name += "_" + this->headers_ordered[column_index];
         }
+    }
+    if(this->get_feature_index(tracer_name).has_value())
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidTracerType);
+    }
+
+    shared_ptr<AssetTracer> new_tracer;
+    switch (tracer_type)
+    {
+        case AssetTracerType::Volatility:
+            new_tracer = std::make_shared<VolatilityTracer>(this, lookback, adjust_warmup);
+            break;
+        case AssetTracerType::Beta:
+            new_tracer = std::make_shared<BetaTracer>(this, lookback, adjust_warmup);
+            break;
+        case AssetTracerType::MovingAverage:
+            new_tracer = std::make_shared<MovingAverageTracer>(this, lookback, column_index);
+            break;
+        case AssetTracerType::ExponentialMovingAverage:
+            new_tracer = std::make_shared<ExponentialMovingAverageTracer>(this, lookback, column_index);
+            break;
+        case AssetTracerType::RollingMin:
+            new_tracer = std::make_shared<RollingExtremeTracer>(this, lookback, column_index, false);
+            break;
+        case AssetTracerType::RollingMax:
+            new_tracer = std::make_shared<RollingExtremeTracer>(this, lookback, column_index, true);
+            break;
+        case AssetTracerType::RollingZScore:
+            new_tracer = std::make_shared<RollingZScoreTracer>(this, lookback, column_index);
+            break;
+        case AssetTracerType::AverageTrueRange:
+            new_tracer = std::make_shared<AverageTrueRangeTracer>(this, lookback);
+            break;
         default:
             ARGUS_RUNTIME_ERROR(ArgusErrorCode::NotImplemented);
     }
+    new_tracer->name = tracer_name;
+
+    // volatility and beta tracers adjust the warmup themselves
+    this->add_tracer(new_tracer, adjust_warmup && !unique_type);
+}
+
+void Asset::add_tracer(const shared_ptr<AssetTracer>& tracer, bool adjust_warmup)
+{
+    auto tracer_type = tracer->tracer_type();
+    if((tracer_type == AssetTracerType::Volatility || tracer_type == AssetTracerType::Beta)
+        && this->get_tracer(tracer_type).has_value())
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidTracerType);
+    }
+
+    if(tracer->name.empty())
+    {
+        tracer->name = tracer_name_prefix(tracer_type) + "_" + std::to_string(tracer->lookback);
+    }
+    if(this->get_feature_index(tracer->name).has_value())
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidTracerType);
+    }
+    this->tracers.push_back(tracer);
+    if(!tracer->get_is_banked())
+    {
+        this->step_tracers.push_back(tracer.get());
+    }
+
+    // allow for lookback to adjust the warmup needed for the asset
+    if(adjust_warmup && tracer->lookback > this->warmup)
+    {
+        this->set_warmup(tracer->lookback);
+    }
 }
 
 ArrayWindow<double> init_array_window(Asset* asset, size_t lookback)
 {
     double* start_ptr;
     size_t start_index;
+
+    // windows read the close column as doubles, float32 assets are widened once
+    auto close = asset->get_close_series();
+    auto close_stride = asset->get_close_stride();
+
+    // the close series starts at the first row held by the asset (the start of a streaming asset's window)
+    auto window_start = asset->get_window_start();
     
     // if the asset's current index is greater than the lookback we have all the data we need
     // so set the start pointer to the current row minus lookback rows.
     if(asset->current_index >= lookback)
     {   
-        start_ptr = asset->get_row() - (lookback * asset->get_cols()) + asset->close_column;
+        start_ptr = close + (asset->current_index - lookback - window_start) * close_stride;
         start_index = asset->current_index - lookback;
     }
     else
     {
-        start_ptr = asset->get_row() + asset->close_column;
+        start_ptr = close + (asset->current_index - window_start) * close_stride;
         start_index = 0;
     }
 
     auto array_window = ArrayWindow<double>(
         start_ptr,
-        asset->get_cols(),
+        close_stride,
         lookback
     );
     // set the start pointer index based on what row window start pointer is pointing to
@@ -634,6 +1565,12 @@ BetaTracer::BetaTracer(Asset* parent_asset_, size_t lookback_, bool adjust_warmu
         this->index_asset = parent_asset_->index_asset.value().get();
     }
 
+    // the index window is never rebased, the index must hold all of its rows
+    if(this->index_asset->get_is_streaming())
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidTracerAsset);
+    }
+
     // the parent asset and index asset must have the same frequencies.
     if(this->parent_asset->frequency != this->index_asset->frequency)
     {
@@ -665,9 +1602,14 @@ BetaTracer::BetaTracer(Asset* parent_asset_, size_t lookback_, bool adjust_warmu
         }
     }
         
-    // set the index volatility data pointer
+    // set the index volatility data pointer, a volatility kept in a tracer bank moves when its
+    // exchange is built so the index asset must trace its own
     shared_ptr<AssetTracer> index_tracer = this->index_asset->get_tracer(AssetTracerType::Volatility).value();
     VolatilityTracer* index_vol = dynamic_cast<VolatilityTracer*>(index_tracer.get()); 
+    if(!index_vol)
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidTracerAsset);
+    }
     this->index_volatility = index_vol->get_volatility();
 }
 
@@ -690,7 +1632,7 @@ void BetaTracer::build()
 
     // take the datetime of the starting row of the parent asset and search for it in the 
     // index asset's datetime index. Know it has value because it is contained
-    auto index_start = array_find(
+    auto index_start = sorted_array_find(
         this->index_asset->get_datetime_index(),
         this->index_asset->get_rows(),
         t0
@@ -698,14 +1640,13 @@ void BetaTracer::build()
     assert(index_start.has_value());
 
     // get pointer to the index starting position
-    double* index_start_ptr = this->index_asset->get_data() // pointer to the start
-        + (index_start.value()*index_asset->get_cols())     // move pointer to correct row
-        + index_asset->close_column;                        // move poitner to close column
+    double* index_start_ptr = this->index_asset->get_close_series()                        // pointer to the close column
+        + (index_start.value() * index_asset->get_close_stride());                          // move pointer to correct row
 
     // build the window into the index asset
     this->index_window = ArrayWindow<double>(
         index_start_ptr,
-        index_asset->get_cols(),
+        index_asset->get_close_stride(),
         this->lookback
     );
 
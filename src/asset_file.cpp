@@ -0,0 +1,430 @@
+//
+// native binary asset file format, files are memory mapped read only so assets read straight from
+// the page cache and concurrent runs on the same host share physical pages
+//
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <fmt/core.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "asset_file.h"
+#include "settings.h"
+
+namespace fs = std::filesystem;
+using namespace std;
+
+static char constexpr ASSET_FILE_MAGIC[8] = {'A', 'R', 'G', 'U', 'S', 'A', 'F', '\0'};
+static uint32_t constexpr ASSET_FILE_VERSION = 1;
+
+/// round a byte offset up to the next ASSET_DATA_ALIGNMENT boundary
+static size_t align_offset(size_t offset)
+{
+    return (offset + ASSET_DATA_ALIGNMENT - 1) / ASSET_DATA_ALIGNMENT * ASSET_DATA_ALIGNMENT;
+}
+
+//============================================================================
+MappedFile::MappedFile(const string& path)
+{
+#ifdef _WIN32
+    this->file_handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(this->file_handle == INVALID_HANDLE_VALUE)
+    {
+        throw runtime_error("failed to open asset file: " + path);
+    }
+    LARGE_INTEGER file_size;
+    if(!GetFileSizeEx(this->file_handle, &file_size) || file_size.QuadPart == 0)
+    {
+        CloseHandle(this->file_handle);
+        throw runtime_error("empty asset file: " + path);
+    }
+    this->size = static_cast<size_t>(file_size.QuadPart);
+    this->mapping_handle = CreateFileMappingA(this->file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if(!this->mapping_handle)
+    {
+        CloseHandle(this->file_handle);
+        throw runtime_error("failed to map asset file: " + path);
+    }
+    this->data = static_cast<const char*>(MapViewOfFile(this->mapping_handle, FILE_MAP_READ, 0, 0, 0));
+    if(!this->data)
+    {
+        CloseHandle(this->mapping_handle);
+        CloseHandle(this->file_handle);
+        throw runtime_error("failed to map asset file: " + path);
+    }
+#else
+    auto fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0)
+    {
+        throw runtime_error("failed to open asset file: " + path);
+    }
+    struct stat file_stat;
+    if(::fstat(fd, &file_stat) != 0 || file_stat.st_size == 0)
+    {
+        ::close(fd);
+        throw runtime_error("empty asset file: " + path);
+    }
+    this->size = static_cast<size_t>(file_stat.st_size);
+
+    // the mapping stays valid after the descriptor is closed
+    auto mapping = ::mmap(nullptr, this->size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if(mapping == MAP_FAILED)
+    {
+        throw runtime_error("failed to map asset file: " + path);
+    }
+    this->data = static_cast<const char*>(mapping);
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef _WIN32
+    UnmapViewOfFile(this->data);
+    CloseHandle(this->mapping_handle);
+    CloseHandle(this->file_handle);
+#else
+    ::munmap(const_cast<char*>(this->data), this->size);
+#endif
+}
+
+//============================================================================
+static void write_string(std::ofstream& file, const string& value)
+{
+    auto length = static_cast<uint32_t>(value.size());
+    file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+    file.write(value.data(), length);
+}
+
+static void write_padding(std::ofstream& file, size_t offset)
+{
+    static char constexpr zeros[ASSET_DATA_ALIGNMENT] = {};
+    file.write(zeros, align_offset(offset) - offset);
+}
+
+void save_asset_file(Asset& asset, const string& path)
+{
+    if(!asset.get_is_loaded())
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::NotBuilt);
+    }
+    // streaming assets only hold a window of their rows
+    if(asset.get_is_streaming())
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::NotImplemented);
+    }
+
+    auto rows = asset.get_rows();
+    auto cols = asset.get_cols();
+    auto layout = asset.get_layout();
+    auto precision = asset.get_precision();
+    size_t element_size = precision == AssetPrecision::Float64 ? sizeof(double) : sizeof(float);
+    auto columns = asset.get_headers();
+    auto datetime_index = asset.get_datetime_index();
+
+    // the value block is written in the asset's layout with the canonical strides, views loaded with
+    // arbitrary strides are compacted
+    size_t elements_per_line = ASSET_DATA_ALIGNMENT / element_size;
+    size_t row_stride = layout == AssetLayout::RowMajor ? cols : 1;
+    size_t col_stride = layout == AssetLayout::RowMajor ?
+        1 :
+        (rows + elements_per_line - 1) / elements_per_line * elements_per_line;
+    size_t data_size = layout == AssetLayout::RowMajor ? rows * cols : col_stride * cols;
+
+    size_t names_size = sizeof(uint32_t) + asset.get_asset_id().size();
+    for(auto const & column : columns)
+    {
+        names_size += sizeof(uint32_t) + column.size();
+    }
+
+    AssetFileHeader header = {};
+    std::memcpy(header.magic, ASSET_FILE_MAGIC, sizeof(header.magic));
+    header.version = ASSET_FILE_VERSION;
+    header.layout = static_cast<uint32_t>(layout);
+    header.precision = static_cast<uint32_t>(precision);
+    header.rows = rows;
+    header.cols = cols;
+    header.row_stride = row_stride;
+    header.col_stride = col_stride;
+    header.start_time = datetime_index[0];
+    header.end_time = datetime_index[rows - 1];
+    header.datetime_offset = align_offset(sizeof(AssetFileHeader) + names_size);
+    header.data_offset = align_offset(header.datetime_offset + rows * sizeof(long long));
+    header.file_size = header.data_offset + data_size * element_size;
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if(!file.is_open())
+    {
+        throw runtime_error("failed to open asset file: " + path);
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    write_string(file, asset.get_asset_id());
+    for(auto const & column : columns)
+    {
+        write_string(file, column);
+    }
+    write_padding(file, sizeof(AssetFileHeader) + names_size);
+    file.write(reinterpret_cast<const char*>(datetime_index), rows * sizeof(long long));
+    write_padding(file, header.datetime_offset + rows * sizeof(long long));
+
+    // copy through a row or column sized buffer using the asset's own strides
+    auto src_row_stride = asset.get_row_stride();
+    auto src_col_stride = asset.get_col_stride();
+    auto write_values = [&](auto* data)
+    {
+        using value_t = std::remove_pointer_t<decltype(data)>;
+        vector<value_t> buffer(layout == AssetLayout::RowMajor ? cols : col_stride, 0);
+        if(layout == AssetLayout::RowMajor)
+        {
+            for(size_t i = 0; i < rows; i++)
+            {
+                for(size_t j = 0; j < cols; j++)
+                {
+                    buffer[j] = data[i * src_row_stride + j * src_col_stride];
+                }
+                file.write(reinterpret_cast<const char*>(buffer.data()), cols * sizeof(value_t));
+            }
+        }
+        else
+        {
+            for(size_t j = 0; j < cols; j++)
+            {
+                for(size_t i = 0; i < rows; i++)
+                {
+                    buffer[i] = data[i * src_row_stride + j * src_col_stride];
+                }
+                file.write(reinterpret_cast<const char*>(buffer.data()), col_stride * sizeof(value_t));
+            }
+        }
+    };
+    if(precision == AssetPrecision::Float64)
+    {
+        write_values(asset.get_data());
+    }
+    else
+    {
+        write_values(asset.get_data_f32());
+    }
+
+    if(!file)
+    {
+        throw runtime_error("failed to write asset file: " + path);
+    }
+}
+
+//============================================================================
+/// add two sizes from a file header, false if the result does not fit in a size_t
+static bool checked_add(size_t a, size_t b, size_t& result)
+{
+    if(b > SIZE_MAX - a) return false;
+    result = a + b;
+    return true;
+}
+
+/// multiply two sizes from a file header, false if the result does not fit in a size_t
+static bool checked_mul(size_t a, size_t b, size_t& result)
+{
+    if(a != 0 && b > SIZE_MAX / a) return false;
+    result = a * b;
+    return true;
+}
+
+static string read_string(const char* data, size_t size, size_t& offset, const string& path)
+{
+    uint32_t length;
+    if(offset + sizeof(length) > size)
+    {
+        throw runtime_error("truncated asset file: " + path);
+    }
+    std::memcpy(&length, data + offset, sizeof(length));
+    offset += sizeof(length);
+    if(offset + length > size)
+    {
+        throw runtime_error("truncated asset file: " + path);
+    }
+    string value(data + offset, length);
+    offset += length;
+    return value;
+}
+
+/// parse and validate the header of a mapped asset file
+static AssetFileInfo parse_asset_file(const MappedFile& file, const string& path)
+{
+    auto data = file.get_data();
+    auto size = file.get_size();
+    if(size < sizeof(AssetFileHeader))
+    {
+        throw runtime_error("truncated asset file: " + path);
+    }
+
+    AssetFileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if(std::memcmp(header.magic, ASSET_FILE_MAGIC, sizeof(header.magic)) != 0)
+    {
+        throw runtime_error("not an asset file: " + path);
+    }
+    if(header.version != ASSET_FILE_VERSION)
+    {
+        throw runtime_error(fmt::format("unsupported asset file version {}: {}", header.version, path));
+    }
+    if(header.layout > AssetLayout::ColumnMajor
+        || header.precision > AssetPrecision::Float32
+        || header.rows == 0
+        || header.cols == 0)
+    {
+        throw runtime_error("invalid asset file header: " + path);
+    }
+
+    AssetFileInfo info;
+    info.rows = header.rows;
+    info.cols = header.cols;
+    info.row_stride = header.row_stride;
+    info.col_stride = header.col_stride;
+    info.layout = static_cast<AssetLayout>(header.layout);
+    info.precision = static_cast<AssetPrecision>(header.precision);
+    info.start_time = header.start_time;
+    info.end_time = header.end_time;
+    info.datetime_offset = header.datetime_offset;
+    info.data_offset = header.data_offset;
+
+    size_t offset = sizeof(AssetFileHeader);
+    info.asset_id = read_string(data, size, offset, path);
+
+    // every column name takes at least its length, bound the count before reserving for it
+    if(info.cols > (size - offset) / sizeof(uint32_t))
+    {
+        throw runtime_error("truncated asset file: " + path);
+    }
+    info.columns.reserve(info.cols);
+    for(size_t j = 0; j < info.cols; j++)
+    {
+        info.columns.push_back(read_string(data, size, offset, path));
+    }
+
+    // the strides must match the layout, so rows and columns never alias, and the datetime index
+    // and value block must lie inside the file. Every size is computed with overflow checks as the
+    // header is not trusted
+    auto element_size = info.precision == AssetPrecision::Float64 ? sizeof(double) : sizeof(float);
+    bool strides_valid = info.layout == AssetLayout::RowMajor ?
+        info.col_stride == 1 && info.row_stride >= info.cols :
+        info.row_stride == 1 && info.col_stride >= info.rows;
+    if(!strides_valid)
+    {
+        throw runtime_error("invalid asset file strides: " + path);
+    }
+    size_t datetime_size, datetime_end, last_row, last_col, last_element, data_size, data_end;
+    if(!checked_mul(info.rows, sizeof(long long), datetime_size)
+        || !checked_add(info.datetime_offset, datetime_size, datetime_end)
+        || !checked_mul(info.rows - 1, info.row_stride, last_row)
+        || !checked_mul(info.cols - 1, info.col_stride, last_col)
+        || !checked_add(last_row, last_col, last_element)
+        || !checked_mul(last_element + 1, element_size, data_size)
+        || !checked_add(info.data_offset, data_size, data_end))
+    {
+        throw runtime_error("invalid asset file header: " + path);
+    }
+    if(header.file_size != size
+        || info.datetime_offset < offset
+        || info.datetime_offset % ASSET_DATA_ALIGNMENT
+        || info.data_offset % ASSET_DATA_ALIGNMENT
+        || datetime_end > info.data_offset
+        || data_end > size)
+    {
+        throw runtime_error("truncated asset file: " + path);
+    }
+    return info;
+}
+
+AssetFileInfo read_asset_file_info(const string& path)
+{
+    MappedFile file(path);
+    return parse_asset_file(file, path);
+}
+
+/// load the asset as a view into an already mapped file, the asset holds on to the mapping
+static void load_mapped_file(Asset& asset, shared_ptr<MappedFile> file, const AssetFileInfo& info)
+{
+    if(asset.get_headers().empty())
+    {
+        asset.load_headers(info.columns);
+    }
+    else if(asset.get_headers() != info.columns)
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidArrayLength);
+    }
+
+    // the mapping is read only, nothing writes through an asset's data pointer after it is loaded
+    auto base = const_cast<char*>(file->get_data());
+    auto datetime_index = reinterpret_cast<long long*>(base + info.datetime_offset);
+    if(info.precision == AssetPrecision::Float64)
+    {
+        asset.load_owned_view(reinterpret_cast<double*>(base + info.data_offset), datetime_index,
+            info.rows, info.cols, info.row_stride, info.col_stride, std::move(file));
+    }
+    else
+    {
+        asset.load_owned_view(reinterpret_cast<float*>(base + info.data_offset), datetime_index,
+            info.rows, info.cols, info.row_stride, info.col_stride, std::move(file));
+    }
+}
+
+void load_asset_file(Asset& asset, const string& path)
+{
+    auto file = std::make_shared<MappedFile>(path);
+    auto info = parse_asset_file(*file, path);
+    load_mapped_file(asset, std::move(file), info);
+}
+
+Asset::asset_sp_t load_asset_file(
+    const string& path,
+    const string& exchange_id,
+    const string& broker_id,
+    size_t warmup)
+{
+    auto file = std::make_shared<MappedFile>(path);
+    auto info = parse_asset_file(*file, path);
+    auto asset = new_asset(info.asset_id, exchange_id, broker_id, warmup);
+    load_mapped_file(*asset, std::move(file), info);
+    return asset;
+}
+
+vector<Asset::asset_sp_t> load_asset_directory(
+    const string& path,
+    const string& exchange_id,
+    const string& broker_id,
+    size_t warmup)
+{
+    if(!fs::is_directory(path))
+    {
+        throw runtime_error("asset directory does not exist: " + path);
+    }
+
+    vector<string> files;
+    for(auto& entry : fs::directory_iterator(path))
+    {
+        if(entry.is_regular_file() && entry.path().extension() == ASSET_FILE_EXTENSION)
+        {
+            files.push_back(entry.path().string());
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    vector<Asset::asset_sp_t> assets;
+    assets.reserve(files.size());
+    for(auto const & file : files)
+    {
+        assets.push_back(load_asset_file(file, exchange_id, broker_id, warmup));
+    }
+    return assets;
+}
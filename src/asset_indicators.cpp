@@ -0,0 +1,226 @@
+//
+// indicator tracers of an asset updated in constant time each step from windows into its columns
+//
+#include <cmath>
+
+#include "asset_indicators.h"
+#include "settings.h"
+#include "utils_string.h"
+
+IndicatorTracer::IndicatorTracer(Asset* parent_asset_, size_t lookback_, size_t column_index_)
+    : AssetTracer(parent_asset_, lookback_), column_index(column_index_)
+{
+    if(lookback_ == 0)
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidTracerType);
+    }
+}
+
+Argus::ArrayWindow<double> IndicatorTracer::column_window(size_t column, size_t row) const
+{
+    // the series starts at the first row held by the asset (the start of a streaming asset's window)
+    auto stride = this->parent_asset->get_close_stride();
+    auto start_ptr = this->parent_asset->get_column_series(column)
+        + (row - this->parent_asset->get_window_start()) * stride;
+    return Argus::ArrayWindow<double>(start_ptr, stride, 0);
+}
+
+void IndicatorTracer::build()
+{
+    // replay the rows behind the current row that are still held by the asset
+    auto next_row = this->parent_asset->current_index;
+    auto history = this->get_history();
+    auto first_row = next_row > history ? next_row - history : 0;
+    first_row = std::max(first_row, this->parent_asset->get_window_start());
+
+    this->init_windows(first_row);
+    this->count = 0;
+    this->value = INDICATOR_NAN;
+    this->clear();
+    for(auto row = first_row; row < next_row; row++)
+    {
+        this->step();
+    }
+}
+
+void MovingAverageTracer::step()
+{
+    double in, out;
+    if(this->slide(in, out))
+    {
+        this->sum += in - out;
+    }
+    else
+    {
+        this->sum += in;
+    }
+    this->value = this->get_is_warm() ? this->sum / static_cast<double>(this->lookback) : INDICATOR_NAN;
+}
+
+void ExponentialMovingAverageTracer::step()
+{
+    // only the end of the window is read, the average is seeded with the mean of the first values
+    auto in = *this->window.end_ptr;
+    this->window.end_ptr += this->window.stride;
+    this->count++;
+    if(this->count < this->lookback)
+    {
+        this->sum += in;
+    }
+    else if(this->count == this->lookback)
+    {
+        this->sum += in;
+        this->value = this->sum / static_cast<double>(this->lookback);
+    }
+    else
+    {
+        this->value += this->alpha * (in - this->value);
+    }
+}
+
+RollingExtremeTracer::RollingExtremeTracer(Asset* parent_asset_, size_t lookback_, size_t column_index_, bool is_max_)
+    : IndicatorTracer(parent_asset_, lookback_, column_index_), is_max(is_max_)
+{
+    this->queue.resize(lookback_ + 1);
+}
+
+void RollingExtremeTracer::step()
+{
+    double in, out;
+    this->slide(in, out);
+    auto row = this->count - 1;
+    auto capacity = this->queue.size();
+
+    // candidates dominated by the new value can never be the extreme again
+    while(this->size > 0)
+    {
+        auto const & back = this->queue[(this->head + this->size - 1) % capacity];
+        if(this->is_max ? back.value > in : back.value < in)
+        {
+            break;
+        }
+        this->size--;
+    }
+    this->queue[(this->head + this->size) % capacity] = {in, row};
+    this->size++;
+
+    // drop the candidates that have left the window
+    while(this->queue[this->head].row + this->lookback <= row)
+    {
+        this->head = (this->head + 1) % capacity;
+        this->size--;
+    }
+    this->value = this->get_is_warm() ? this->queue[this->head].value : INDICATOR_NAN;
+}
+
+RollingZScoreTracer::RollingZScoreTracer(Asset* parent_asset_, size_t lookback_, size_t column_index_)
+    : IndicatorTracer(parent_asset_, lookback_, column_index_)
+{
+    // a sample deviation needs at least two values
+    if(lookback_ < 2)
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidTracerType);
+    }
+}
+
+void RollingZScoreTracer::resum()
+{
+    this->mean = 0;
+    this->m2 = 0;
+    size_t k = 0;
+    for(auto ptr = this->window.start_ptr; ptr != this->window.end_ptr; ptr += this->window.stride)
+    {
+        auto delta = *ptr - this->mean;
+        this->mean += delta / static_cast<double>(++k);
+        this->m2 += delta * (*ptr - this->mean);
+    }
+}
+
+void RollingZScoreTracer::step()
+{
+    double in, out;
+    if(this->slide(in, out))
+    {
+        // replace the value leaving the window, the count stays at the lookback
+        if(this->count % this->lookback == 0)
+        {
+            this->resum();
+        }
+        else
+        {
+            auto previous_mean = this->mean;
+            this->mean += (in - out) / static_cast<double>(this->lookback);
+            this->m2 += (in - out) * (in - this->mean + out - previous_mean);
+        }
+    }
+    else
+    {
+        auto delta = in - this->mean;
+        this->mean += delta / static_cast<double>(this->count);
+        this->m2 += delta * (in - this->mean);
+    }
+    if(!this->get_is_warm())
+    {
+        return;
+    }
+
+    // a constant window has no z-score
+    auto variance = this->m2 / static_cast<double>(this->lookback - 1);
+    this->value = variance > 0 ? (in - this->mean) / std::sqrt(variance) : INDICATOR_NAN;
+}
+
+AverageTrueRangeTracer::AverageTrueRangeTracer(Asset* parent_asset_, size_t lookback_)
+    : IndicatorTracer(parent_asset_, lookback_, parent_asset_->close_column)
+{
+    // the high and low columns are found like the open and close, ignoring case
+    auto headers = parent_asset_->get_headers();
+    auto find_column = [&headers](const string& column)
+    {
+        for(size_t i = 0; i < headers.size(); i++)
+        {
+            if(case_ins_str_compare(headers[i], column))
+            {
+                return i;
+            }
+        }
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidDataRequest);
+    };
+    this->high_column = find_column("high");
+    this->low_column = find_column("low");
+    this->true_ranges.resize(lookback_);
+}
+
+void AverageTrueRangeTracer::init_windows(size_t row)
+{
+    this->window = this->column_window(this->column_index, row);
+    this->high_window = this->column_window(this->high_column, row);
+    this->low_window = this->column_window(this->low_column, row);
+}
+
+void AverageTrueRangeTracer::step()
+{
+    auto high = *this->high_window.end_ptr;
+    auto low = *this->low_window.end_ptr;
+    auto close = *this->window.end_ptr;
+    this->high_window.end_ptr += this->high_window.stride;
+    this->low_window.end_ptr += this->low_window.stride;
+    this->window.end_ptr += this->window.stride;
+
+    auto true_range = high - low;
+    if(!std::isnan(this->previous_close))
+    {
+        true_range = std::max({true_range, std::abs(high - this->previous_close), std::abs(low - this->previous_close)});
+    }
+    this->previous_close = close;
+
+    // the ring slot of the new true range holds the one leaving the window
+    auto& slot = this->true_ranges[this->count % this->lookback];
+    if(this->count >= this->lookback)
+    {
+        this->sum -= slot;
+    }
+    slot = true_range;
+    this->sum += true_range;
+    this->count++;
+    this->value = this->get_is_warm() ? this->sum / static_cast<double>(this->lookback) : INDICATOR_NAN;
+}
@@ -0,0 +1,201 @@
+//
+// chunked row sources for streaming assets, a streaming asset holds its full datetime index but only
+// a sliding window of its values
+//
+#include <cstring>
+#include <pybind11/numpy.h>
+
+#include "asset_stream.h"
+#include "settings.h"
+
+using namespace std;
+
+//============================================================================
+void AssetChunkSource::skip(size_t rows)
+{
+    // skip in bounded pieces so large seeks do not allocate the skipped rows
+    size_t constexpr skip_rows = 1024;
+    vector<double> scratch(std::min(rows, skip_rows) * this->cols);
+    while(rows)
+    {
+        auto rows_read = this->read(scratch.data(), std::min(rows, skip_rows));
+        if(!rows_read)
+        {
+            return;
+        }
+        rows -= rows_read;
+    }
+}
+
+//============================================================================
+AssetFileChunkSource::AssetFileChunkSource(const string& path) :
+    AssetChunkSource(0),
+    info(read_asset_file_info(path)),
+    file(path, std::ios::binary)
+{
+    if(!this->file.is_open())
+    {
+        throw runtime_error("failed to open asset file: " + path);
+    }
+    this->cols = this->info.cols;
+}
+
+vector<long long> AssetFileChunkSource::read_datetime_index()
+{
+    vector<long long> datetime_index(this->info.rows);
+    this->file.clear();
+    this->file.seekg(static_cast<std::streamoff>(this->info.datetime_offset));
+    this->file.read(reinterpret_cast<char*>(datetime_index.data()), this->info.rows * sizeof(long long));
+    if(!this->file)
+    {
+        throw runtime_error("truncated asset file");
+    }
+    return datetime_index;
+}
+
+void AssetFileChunkSource::read_elements(size_t element_offset, size_t count)
+{
+    auto element_size = this->info.precision == AssetPrecision::Float64 ? sizeof(double) : sizeof(float);
+    this->buffer.resize(count * element_size);
+    this->file.clear();
+    this->file.seekg(static_cast<std::streamoff>(this->info.data_offset + element_offset * element_size));
+    this->file.read(this->buffer.data(), static_cast<std::streamsize>(this->buffer.size()));
+    if(!this->file)
+    {
+        throw runtime_error("truncated asset file");
+    }
+}
+
+size_t AssetFileChunkSource::read(double* values, size_t max_rows)
+{
+    auto rows = std::min(max_rows, this->info.rows - this->position);
+    if(!rows)
+    {
+        return 0;
+    }
+
+    // widen a run of count elements spaced stride apart in the destination
+    auto copy_out = [&](double* dst, size_t count, size_t stride)
+    {
+        if(this->info.precision == AssetPrecision::Float64)
+        {
+            auto src = reinterpret_cast<const double*>(this->buffer.data());
+            for(size_t i = 0; i < count; i++) dst[i * stride] = src[i];
+        }
+        else
+        {
+            auto src = reinterpret_cast<const float*>(this->buffer.data());
+            for(size_t i = 0; i < count; i++) dst[i * stride] = src[i];
+        }
+    };
+
+    if(this->info.layout == AssetLayout::RowMajor)
+    {
+        // consecutive rows are contiguous in the file
+        this->read_elements(this->position * this->info.row_stride, rows * this->cols);
+        copy_out(values, rows * this->cols, 1);
+    }
+    else
+    {
+        // gather one run per column into the rows
+        for(size_t j = 0; j < this->cols; j++)
+        {
+            this->read_elements(j * this->info.col_stride + this->position, rows);
+            copy_out(values + j, rows, this->cols);
+        }
+    }
+    this->position += rows;
+    return rows;
+}
+
+//============================================================================
+PyChunkSource::PyChunkSource(py::object chunks_, size_t cols_) :
+    AssetChunkSource(cols_),
+    chunks(std::move(chunks_))
+{
+}
+
+PyChunkSource::~PyChunkSource()
+{
+    // the asset can be released from native code, drop the python references holding the gil
+    py::gil_scoped_acquire gil;
+    this->chunk = py::object();
+    this->iterator = py::object();
+    this->chunks = py::object();
+}
+
+void PyChunkSource::reset()
+{
+    py::gil_scoped_acquire gil;
+    this->iterator = py::object();
+    this->chunk = py::object();
+    this->chunk_offset = 0;
+}
+
+size_t PyChunkSource::read(double* values, size_t max_rows)
+{
+    py::gil_scoped_acquire gil;
+    if(!this->iterator)
+    {
+        this->iterator = py::iter(this->chunks());
+    }
+
+    size_t rows_read = 0;
+    while(rows_read < max_rows)
+    {
+        // pull the next chunk once the current one is used up
+        if(!this->chunk)
+        {
+            auto next = PyIter_Next(this->iterator.ptr());
+            if(!next)
+            {
+                if(PyErr_Occurred())
+                {
+                    throw py::error_already_set();
+                }
+                break;
+            }
+            auto array = py::array_t<double, py::array::c_style | py::array::forcecast>::ensure(
+                py::reinterpret_steal<py::object>(next));
+            if(!array || array.ndim() != 2 || static_cast<size_t>(array.shape(1)) != this->cols)
+            {
+                ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidArrayLength);
+            }
+            this->chunk = array;
+            this->chunk_offset = 0;
+        }
+
+        auto array = py::reinterpret_borrow<py::array_t<double>>(this->chunk);
+        auto chunk_rows = static_cast<size_t>(array.shape(0));
+        auto rows = std::min(max_rows - rows_read, chunk_rows - this->chunk_offset);
+        std::memcpy(
+            values + rows_read * this->cols,
+            array.data() + this->chunk_offset * this->cols,
+            rows * this->cols * sizeof(double));
+        rows_read += rows;
+        this->chunk_offset += rows;
+        if(this->chunk_offset == chunk_rows)
+        {
+            this->chunk = py::object();
+        }
+    }
+    return rows_read;
+}
+
+//============================================================================
+void load_asset_file_stream(Asset& asset, const string& path, size_t chunk_rows, size_t lookback)
+{
+    auto source = std::make_shared<AssetFileChunkSource>(path);
+    auto const & info = source->get_info();
+    if(asset.get_headers().empty())
+    {
+        asset.load_headers(info.columns);
+    }
+    else if(asset.get_headers() != info.columns)
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidArrayLength);
+    }
+
+    auto datetime_index = source->read_datetime_index();
+    asset.load_stream(source, datetime_index.data(), info.rows, chunk_rows, lookback);
+}
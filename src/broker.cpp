@@ -20,11 +20,23 @@ using namespace std;
 Broker::Broker(string broker_id_, double cash_, int logging_) : broker_account(broker_id_, cash_)
 {
     this->broker_id = std::move(broker_id_);
+    this->broker_symbol = intern_symbol(SymbolType::Broker, this->broker_id);
     this->cash = cash_;
     this->logging = logging_;
     this->com_scheme = nullopt;
 }
 
+void Brokers::add_broker(const broker_sp_t& broker)
+{
+    this->broker_map.emplace(broker->get_broker_id(), broker);
+    auto broker_symbol = broker->get_broker_symbol();
+    if(broker_symbol >= this->broker_slots.size())
+    {
+        this->broker_slots.resize(broker_symbol + 1, nullptr);
+    }
+    this->broker_slots[broker_symbol] = broker.get();
+}
+
 void Broker::build(
     exchanges_sp_t exchange_map_)
 {
@@ -61,7 +73,10 @@ void Broker::cancel_order(size_t order_id)
 
     //unwrap optional we know has value
     auto order = order_opt.value();
-    
+
+    // stop the order resting on its exchange
+    this->exchange_map->get_exchange(order->get_exchange_symbol())->cancel_order(order);
+
     // set the order state to cancel
     order->set_order_state(CANCELED);
 
@@ -119,7 +134,7 @@ void Broker::log_order_place(shared_ptr<Order> &filled_order)
 void Broker::place_order(shared_ptr<Order> order, bool process_fill)
 {
     // get smart pointer to the right exchange
-    auto exchange = this->exchange_map->exchanges.at(order->get_exchange_id());
+    auto exchange = this->exchange_map->get_exchange(order->get_exchange_symbol());
 
     // set wether the ored was placed on the close or open
     order->set_placed_on_close(exchange->on_close);
@@ -153,7 +168,7 @@ void Broker::send_orders()
     for (auto &order : this->open_orders_buffer)
     {
         // get the exchange the order was placed to
-        auto exchange = exchange_map->exchanges.at(order->get_exchange_id());
+        auto exchange = this->exchange_map->get_exchange(order->get_exchange_symbol());
 
         // send order to rest on the exchange
         exchange->place_order(order);
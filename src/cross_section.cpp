@@ -0,0 +1,189 @@
+//
+// cross sectional transforms of a feature over the assets streaming on an exchange
+//
+#include <cmath>
+
+#include "cross_section.h"
+#include "settings.h"
+
+static double constexpr CROSS_SECTION_NAN = std::numeric_limits<double>::quiet_NaN();
+
+void CrossSection::resize(size_t slots)
+{
+    for(auto& output : this->outputs)
+    {
+        output.assign(slots, CROSS_SECTION_NAN);
+    }
+    this->groups.resize(slots, CROSS_SECTION_GROUP_NONE);
+    this->scratch.reserve(slots);
+}
+
+double const * CrossSection::transform(
+    const vector<slot_value_t>& values,
+    CrossSectionTransform transform,
+    double lower,
+    double upper)
+{
+    if(transform == CrossSectionTransform::Winsorize && !(0 <= lower && lower <= upper && upper <= 1))
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidDataRequest);
+    }
+
+    // slots not in the cross section and NaN values stay NaN
+    auto& output = this->outputs[transform];
+    std::fill(output.begin(), output.end(), CROSS_SECTION_NAN);
+    this->scratch.clear();
+    for(auto const & pair : values)
+    {
+        if(!std::isnan(pair.second))
+        {
+            this->scratch.push_back(pair);
+        }
+    }
+    if(this->scratch.empty())
+    {
+        return output.data();
+    }
+
+    switch (transform) {
+        case CrossSectionTransform::Rank:
+            this->rank(output.data(), false);
+            break;
+        case CrossSectionTransform::Percentile:
+            this->rank(output.data(), true);
+            break;
+        case CrossSectionTransform::ZScore:
+            this->zscore(output.data());
+            break;
+        case CrossSectionTransform::Winsorize:
+            this->winsorize(output.data(), lower, upper);
+            break;
+        case CrossSectionTransform::GroupDemean:
+            this->group_demean(output.data());
+            break;
+    }
+    return output.data();
+}
+
+void CrossSection::rank(double* output, bool percentile)
+{
+    auto& values = this->scratch;
+    std::sort(values.begin(), values.end(), [](const slot_value_t& a, const slot_value_t& b)
+    {
+        return a.second < b.second;
+    });
+
+    // every value in a run of ties gets the average of the 1 based ranks of the run
+    auto n = static_cast<double>(values.size());
+    size_t begin = 0;
+    while(begin < values.size())
+    {
+        auto end = begin + 1;
+        while(end < values.size() && values[end].second == values[begin].second)
+        {
+            end++;
+        }
+        auto rank = (static_cast<double>(begin + 1) + static_cast<double>(end)) / 2;
+        for(size_t i = begin; i < end; i++)
+        {
+            output[values[i].first] = percentile ? rank / n : rank;
+        }
+        begin = end;
+    }
+}
+
+void CrossSection::zscore(double* output)
+{
+    auto const & values = this->scratch;
+    if(values.size() < 2)
+    {
+        return;
+    }
+    double sum = 0;
+    for(auto const & pair : values)
+    {
+        sum += pair.second;
+    }
+    auto n = static_cast<double>(values.size());
+    auto mean = sum / n;
+    double squares = 0;
+    for(auto const & pair : values)
+    {
+        squares += (pair.second - mean) * (pair.second - mean);
+    }
+
+    // a constant cross section has no z-score, leave it NaN
+    auto std_dev = std::sqrt(squares / (n - 1));
+    if(std_dev == 0)
+    {
+        return;
+    }
+    for(auto const & pair : values)
+    {
+        output[pair.first] = (pair.second - mean) / std_dev;
+    }
+}
+
+double CrossSection::quantile(double q)
+{
+    auto& values = this->scratch;
+    auto position = q * static_cast<double>(values.size() - 1);
+    auto index = static_cast<size_t>(std::floor(position));
+    auto by_value = [](const slot_value_t& a, const slot_value_t& b) { return a.second < b.second; };
+    std::nth_element(values.begin(), values.begin() + index, values.end(), by_value);
+    auto value = values[index].second;
+    auto fraction = position - static_cast<double>(index);
+    if(fraction == 0)
+    {
+        return value;
+    }
+
+    // the values after the nth element are not less than it, the next order statistic is their minimum
+    auto next = std::min_element(values.begin() + index + 1, values.end(), by_value)->second;
+    return value + fraction * (next - value);
+}
+
+void CrossSection::winsorize(double* output, double lower, double upper)
+{
+    auto low = this->quantile(lower);
+    auto high = this->quantile(upper);
+    for(auto const & pair : this->scratch)
+    {
+        output[pair.first] = std::clamp(pair.second, low, high);
+    }
+}
+
+void CrossSection::group_demean(double* output)
+{
+    // slots without a group are accumulated in the last entry
+    auto groups = SymbolTable::get(SymbolType::Group).size();
+    if(this->group_sums.size() < groups + 1)
+    {
+        this->group_sums.resize(groups + 1);
+        this->group_counts.resize(groups + 1);
+    }
+    auto group_index = [this, groups](uint32_t slot)
+    {
+        auto group = this->groups[slot];
+        return group == CROSS_SECTION_GROUP_NONE ? groups : static_cast<size_t>(group);
+    };
+
+    // only the groups present in the cross section are cleared and summed
+    for(auto const & pair : this->scratch)
+    {
+        auto group = group_index(pair.first);
+        this->group_sums[group] = 0;
+        this->group_counts[group] = 0;
+    }
+    for(auto const & pair : this->scratch)
+    {
+        auto group = group_index(pair.first);
+        this->group_sums[group] += pair.second;
+        this->group_counts[group]++;
+    }
+    for(auto const & pair : this->scratch)
+    {
+        auto group = group_index(pair.first);
+        output[pair.first] = pair.second - this->group_sums[group] / static_cast<double>(this->group_counts[group]);
+    }
+}
@@ -11,6 +11,7 @@
 #include "pybind11/pytypes.h"
 
 #include "exchange.h"
+#include "panel.h"
 #include "asset.h"
 #include "utils_array.h"
 #include "settings.h"
@@ -30,6 +31,7 @@ Exchange::Exchange(std::string exchange_id_, int logging_) : exchange_id(std::mo
     this->current_index = 0;
     this->datetime_index_length = 0;
     this->exchange_time = 0;
+    this->exchange_symbol = intern_symbol(SymbolType::Exchange, this->exchange_id);
 }
 
 void Exchange::build()
@@ -72,7 +74,6 @@ void Exchange::build()
         // makes updating market view faster
         if(asset->get_rows() == this->datetime_index_length){
             asset->is_alligned = true;
-            this->market_view[asset->get_asset_id()] = asset.get();
         }
         else{
             asset->is_alligned = false;
@@ -80,6 +81,43 @@ void Exchange::build()
 
         this->candles+= asset->get_rows();
     }
+
+    // assets streamed from python must step on the main thread
+    this->parallel_step = std::all_of(this->market.begin(), this->market.end(), [](const auto& asset_pair)
+    {
+        return asset_pair.second->get_is_thread_safe();
+    });
+
+    // every asset expires at most once per run, reserve so expirations never allocate in the hot loop
+    this->expired_assets.reserve(this->market.size());
+
+    // precompute which assets step and expire at each exchange time
+    this->build_schedule();
+    this->reset_market_view();
+
+    // resting orders are kept by market slot
+    this->trigger_book.resize(this->market_slots.size());
+
+    // cross sectional transforms are written by market slot
+    this->cross_section.resize(this->market_slots.size());
+    for(size_t slot = 0; slot < this->market_slots.size(); slot++)
+    {
+        auto group = this->asset_groups.find(this->market_slots[slot]->asset_symbol);
+        this->cross_section.set_group(slot, group == this->asset_groups.end() ? CROSS_SECTION_GROUP_NONE : group->second);
+    }
+
+    // pack the listed assets into the panel, panel slots are the market slots
+    if(this->panel_enabled)
+    {
+        if(this->logging) printf("EXCHANGE: BUILDING EXCHANGE: %s PANEL\n", this->exchange_id.c_str());
+        vector<Asset*> assets;
+        assets.reserve(this->market_slots.size());
+        for(auto& asset : this->market_slots)
+        {
+            assets.push_back(asset.get());
+        }
+        this->panel.build(assets, this->datetime_index, this->datetime_index_length, this->panel_columns);
+    }
     if(this->logging) printf("EXCHANGE: EXCHANGE: %s DATETIME INDEX BUILT\n", this->exchange_id.c_str());
 
     // if index asset is registered then make sure it is valid. It must contain the datetime
@@ -101,13 +139,57 @@ void Exchange::build()
         if(this->logging) printf("EXCHANGE: BULDING EXCHANGE: %s INDEX ASSET\n", this->exchange_id.c_str());
         this->index_asset.value()->build();
         this->index_asset.value()->goto_datetime(*this->datetime_index);
+
+        // float32 index assets widen their close column on first read, do it here so beta tracers
+        // built on the thread pool below only read the widened copy
+        this->index_asset.value()->get_close_series();
         if(this->logging) printf("EXCHANGE: EXCHANGE: %s INDEX ASSET BUILT\n", this->exchange_id.c_str());
     }   
 
+    // place the banked volatility tracers at their asset's market slot before the assets build them
+    if(this->volatility_bank)
+    {
+        this->volatility_bank->resize(this->market_slots.size());
+        for(size_t slot = 0; slot < this->market_slots.size(); slot++)
+        {
+            auto& asset = this->market_slots[slot];
+            auto tracer = asset->get_tracer(AssetTracerType::Volatility);
+            if(!tracer.has_value() || !tracer.value()->get_is_banked())
+            {
+                continue;
+            }
+            auto banked = static_cast<BankedVolatilityTracer*>(tracer.value().get());
+            if(banked->get_bank() == this->volatility_bank.get())
+            {
+                banked->set_slot(static_cast<uint32_t>(slot));
+                this->volatility_bank->assign(static_cast<uint32_t>(slot), asset.get());
+            }
+        }
+    }
+
+    // assets registered since the tracer mode was set follow it, lazy assets step their banked tracers
+    for(auto& asset : this->market_slots)
+    {
+        asset->set_lazy_tracers(this->lazy_tracers);
+    }
+
     // build the indivual assets
     if(this->logging) printf("EXCHANGE: BUILDING EXCHANGE: %s ASSETS\n", this->exchange_id.c_str());
-    for(auto& asset_pair : this->market){
-        asset_pair.second->build();
+    // assets build their own tracers, beta tracers only read the index asset built and widened above
+    auto build_range = [this](size_t begin, size_t end)
+    {
+        for(size_t slot = begin; slot < end; slot++)
+        {
+            this->market_slots[slot]->build();
+        }
+    };
+    if(this->thread_pool && this->parallel_step)
+    {
+        this->thread_pool->parallel_for(this->market_slots.size(), ARGUS_PARALLEL_BUILD_GRAIN, build_range);
+    }
+    else
+    {
+        build_range(0, this->market_slots.size());
     }
     if(this->logging) printf("EXCHANGE: EXCHANGE: %s ASSETS BUILT\n", this->exchange_id.c_str());
 
@@ -117,10 +199,127 @@ void Exchange::build()
     if(this->logging) printf("EXCHANGE: EXCHANGE: %s BUILT\n", this->exchange_id.c_str());
 }
 
+void Exchange::build_schedule()
+{
+    // slots are sorted by asset id so iteration over the market view is deterministic
+    this->market_slots.clear();
+    for(auto& asset_pair : this->market)
+    {
+        this->market_slots.push_back(asset_pair.second);
+    }
+    std::sort(this->market_slots.begin(), this->market_slots.end(), [](const asset_sp_t& a, const asset_sp_t& b)
+    {
+        return a->get_asset_id() < b->get_asset_id();
+    });
+
+    this->symbol_slots.clear();
+    for(size_t slot = 0; slot < this->market_slots.size(); slot++)
+    {
+        auto asset_symbol = this->market_slots[slot]->asset_symbol;
+        if(asset_symbol >= this->symbol_slots.size())
+        {
+            this->symbol_slots.resize(asset_symbol + 1, EXCHANGE_SLOT_NONE);
+        }
+        this->symbol_slots[asset_symbol] = static_cast<uint32_t>(slot);
+    }
+
+    // walk each asset's rows after its warmup against the exchange index, every row is in the
+    // index as it is the union of the asset indexes. The walk runs twice, first counting the
+    // events of each kind (step, enter, leave, expire) at each time then placing them.
+    auto walk_rows = [this](auto&& on_event)
+    {
+        for(size_t slot = 0; slot < this->market_slots.size(); slot++)
+        {
+            auto asset = this->market_slots[slot].get();
+            auto asset_index = asset->get_datetime_index();
+            if(asset->get_warmup() >= asset->get_rows())
+            {
+                continue;
+            }
+            auto time = sorted_array_lower_bound(
+                this->datetime_index,
+                0,
+                this->datetime_index_length,
+                asset_index[asset->get_warmup()]
+            );
+            auto previous_time = this->datetime_index_length;
+            for(size_t row = asset->get_warmup(); row < asset->get_rows(); row++)
+            {
+                while(this->datetime_index[time] < asset_index[row])
+                {
+                    time++;
+                }
+                on_event(0, slot, time);
+
+                // the asset only enters or leaves the view around a gap in its index
+                if(previous_time == this->datetime_index_length || previous_time + 1 != time)
+                {
+                    on_event(1, slot, time);
+                    if(previous_time != this->datetime_index_length)
+                    {
+                        on_event(2, slot, previous_time + 1);
+                    }
+                }
+                previous_time = time;
+            }
+            on_event(3, slot, time);
+            if(time + 1 < this->datetime_index_length)
+            {
+                on_event(2, slot, time + 1);
+            }
+        }
+    };
+
+    SlotSchedule* schedules[] = {
+        &this->step_schedule, &this->enter_schedule, &this->leave_schedule, &this->expire_schedule
+    };
+    for(auto schedule : schedules)
+    {
+        schedule->offsets.assign(this->datetime_index_length + 1, 0);
+    }
+    walk_rows([&](size_t kind, size_t, size_t time)
+    {
+        schedules[kind]->offsets[time + 1]++;
+    });
+
+    vector<size_t> fill[4];
+    for(size_t kind = 0; kind < 4; kind++)
+    {
+        auto schedule = schedules[kind];
+        for(size_t time = 0; time < this->datetime_index_length; time++)
+        {
+            schedule->offsets[time + 1] += schedule->offsets[time];
+        }
+        schedule->slots.resize(schedule->offsets.back());
+        fill[kind].assign(schedule->offsets.begin(), schedule->offsets.end() - 1);
+    }
+    walk_rows([&](size_t kind, size_t slot, size_t time)
+    {
+        schedules[kind]->slots[fill[kind][time]++] = static_cast<uint32_t>(slot);
+    });
+}
+
+void Exchange::reset_market_view()
+{
+    this->view_step++;
+    this->market_view.assign(this->market_slots.size(), nullptr);
+    this->market_view_bits.assign((this->market_slots.size() + 63) / 64, 0);
+    this->view_synced = false;
+
+    // assets alligned with the exchange are in view from the start
+    for(size_t slot = 0; slot < this->market_slots.size(); slot++)
+    {
+        if(this->market_slots[slot]->is_alligned)
+        {
+            this->market_view[slot] = this->market_slots[slot].get();
+            this->market_view_bits[slot / 64] |= uint64_t(1) << (slot % 64);
+        }
+    }
+}
+
 void Exchange::reset_exchange()
 {
     this->current_index = 0;
-    this->market_view.clear();
 
     if(this->index_asset.has_value())
     {
@@ -131,34 +330,17 @@ void Exchange::reset_exchange()
     // reset assets still in the market
     for(auto & asset_pair : this->market)
     {   
-        auto asset_sp = asset_pair.second;
-        asset_sp->reset_asset();
-        if(asset_sp->is_alligned)
-        {
-            this->market_view[asset_sp->get_asset_id()] = asset_sp.get();
-        }
+        asset_pair.second->reset_asset();
     }
-    // reset assets that were expired and bring them back in to view
+    // reset assets that were expired and bring them back in to the market
     for(auto & asset_sp : this->expired_assets)
     {   
         asset_sp->reset_asset();
         this->market.insert({asset_sp->get_asset_id(), asset_sp});
-        if(asset_sp->is_alligned)
-        {
-            this->market_view[asset_sp->get_asset_id()] = asset_sp.get();
-        }
-    }
-    // reset market allignment
-    for(auto & asset_pair : this->market)
-    {   
-        auto asset = asset_pair.second;
-        if(asset->is_alligned)
-        {
-            this->market_view[asset->get_asset_id()] = asset.get();
-        }
     }
+    this->reset_market_view();
     this->expired_assets.clear();
-    this->open_orders.clear();
+    this->trigger_book.clear();
 }
 
 Exchange::~Exchange()
@@ -193,7 +375,6 @@ shared_ptr<Asset> Exchange::new_asset(const string &asset_id_, const string &bro
     }
     auto asset = make_shared<Asset>(asset_id_, this->exchange_id, broker_id);
     this->market.emplace(asset_id_, asset);
-    this->market_view.emplace(asset_id_, nullptr);
     return asset;
 }
 
@@ -241,16 +422,52 @@ void Exchange::register_asset(const shared_ptr<Asset>& asset_)
     else
     {
         this->market.emplace(asset_id, asset_);
-        this->market_view.emplace(asset_id, nullptr);
     }
 }
 
-void Exchange::add_tracer(AssetTracerType tracer_type, size_t lookback, bool adjust_warmup)
+void Exchange::add_tracer(
+    AssetTracerType tracer_type,
+    size_t lookback,
+    bool adjust_warmup,
+    const string& column,
+    const string& name)
 {
+    if(tracer_type != AssetTracerType::Volatility)
+    {
+        for(auto& asset_pair : this->market)
+        {
+            asset_pair.second->add_tracer(tracer_type, lookback, adjust_warmup, column, name);
+        }
+        return;
+    }
+
+    // volatility tracers share the bank's lookback, slots are assigned when the exchange is built
+    if(!this->volatility_bank)
+    {
+        this->volatility_bank = std::make_shared<VolatilityBank>(lookback);
+    }
+    else if(this->volatility_bank->get_lookback() != lookback)
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidTracerType);
+    }
     for(auto& asset_pair : this->market)
     {
-        asset_pair.second->add_tracer(tracer_type, lookback, adjust_warmup);
+        auto tracer = std::make_shared<BankedVolatilityTracer>(asset_pair.second.get(), this->volatility_bank);
+        tracer->name = name;
+        asset_pair.second->add_tracer(tracer, adjust_warmup);
+    }
+}
+
+void Exchange::set_lazy_tracers(bool lazy_tracers_)
+{
+    // assets going back to eager catch up their banked tracers before the bank steps them again.
+    // expired assets keep their slot and take the mode too, build applies it to assets registered
+    // before the exchange was built
+    for(auto& asset : this->market_slots)
+    {
+        asset->set_lazy_tracers(lazy_tracers_);
     }
+    this->lazy_tracers = lazy_tracers_;
 }
 
 void ExchangeMap::register_asset(const shared_ptr<Asset> &asset_, const string& exchange_id)
@@ -258,11 +475,30 @@ void ExchangeMap::register_asset(const shared_ptr<Asset> &asset_, const string&
     string asset_id = asset_->get_asset_id();
 
     // register asset to the exchange
-    auto exchange = this->exchanges.find(exchange_id)->second;
-    exchange->register_asset(asset_);
+    auto exchange_it = this->exchanges.find(exchange_id);
+    if(exchange_it == this->exchanges.end())
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidId);
+    }
+    exchange_it->second->register_asset(asset_);
 
     // add asset to the exchange map's own map
     this->asset_map.emplace(asset_id, asset_);
+    if(asset_->asset_symbol >= this->asset_slots.size())
+    {
+        this->asset_slots.resize(asset_->asset_symbol + 1, nullptr);
+    }
+    this->asset_slots[asset_->asset_symbol] = asset_.get();
+}
+
+void ExchangeMap::register_exchange(const exchange_sp_t& exchange_)
+{
+    this->exchanges.emplace(exchange_->exchange_id, exchange_);
+    if(exchange_->exchange_symbol >= this->exchange_slots.size())
+    {
+        this->exchange_slots.resize(exchange_->exchange_symbol + 1, nullptr);
+    }
+    this->exchange_slots[exchange_->exchange_symbol] = exchange_.get();
 }
 
 
@@ -313,7 +549,7 @@ void Exchange::place_order(shared_ptr<Order> &order_)
 
 void Exchange::process_market_order(shared_ptr<Order> &open_order)
 {
-    auto market_price = this->get_market_price(open_order->get_asset_id());
+    auto market_price = this->get_market_price(open_order->get_asset_symbol());
     if (market_price == 0)
     {
         ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidId);
@@ -323,7 +559,7 @@ void Exchange::process_market_order(shared_ptr<Order> &open_order)
 
 void Exchange::process_limit_order(shared_ptr<Order> &open_order)
 {
-    auto market_price = this->get_market_price(open_order->get_asset_id()); 
+    auto market_price = this->get_market_price(open_order->get_asset_symbol()); 
     if (market_price == 0)
     {
         ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidId);
@@ -340,7 +576,7 @@ void Exchange::process_limit_order(shared_ptr<Order> &open_order)
 
 void Exchange::process_stop_loss_order(shared_ptr<Order> &open_order)
 {
-    auto market_price = this->get_market_price(open_order->get_asset_id());
+    auto market_price = this->get_market_price(open_order->get_asset_symbol());
     if (market_price == 0)
     {
         ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidId);
@@ -357,7 +593,7 @@ void Exchange::process_stop_loss_order(shared_ptr<Order> &open_order)
 
 void Exchange::process_take_profit_order(shared_ptr<Order> &open_order)
 {
-    auto market_price = this->get_market_price(open_order->get_asset_id());
+    auto market_price = this->get_market_price(open_order->get_asset_symbol());
     if (market_price == 0)
     {
         ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidId);
@@ -374,8 +610,7 @@ void Exchange::process_take_profit_order(shared_ptr<Order> &open_order)
 
 void Exchange::process_order(shared_ptr<Order> &order)
 {
-    auto asset_id = order->get_asset_id();
-    auto asset = this->market_view.at(asset_id);
+    auto asset = this->get_market_view_asset(order->get_asset_symbol());
 
     // check to see if asset is currently streaming
     if (!asset)
@@ -408,33 +643,50 @@ void Exchange::process_order(shared_ptr<Order> &order)
     }
     }
 
-    // if the order is still pending then set to open ad push to open order vector
+    // if the order is still pending then set to open and rest it in the trigger book
     if (order->get_order_state() == PENDING)
     {
         order->set_order_state(OPEN);
-        this->open_orders.push_back(order);
+        this->trigger_book.insert(this->symbol_slots[order->get_asset_symbol()], order);
     }
 }
 
-void Exchange::process_orders()
+void Exchange::cancel_order(const shared_ptr<Order> &order)
 {
-    // iterate over open order and process any filled orders
-    for (auto it = this->open_orders.begin(); it != this->open_orders.end();)
+    auto asset_symbol = order->get_asset_symbol();
+    if(asset_symbol < this->symbol_slots.size() && this->symbol_slots[asset_symbol] != EXCHANGE_SLOT_NONE)
     {
-        auto order = *it;
-
-        // process the order
-        this->process_order(order);
+        this->trigger_book.remove(this->symbol_slots[asset_symbol], order->get_order_id());
+    }
+}
 
-        // if order was filled remove from open orders, else move to next
-        if (order->get_order_state() == FILLED)
+void Exchange::process_orders()
+{
+    // only the assets with resting orders that printed at the current time are checked, and only
+    // the orders whose trigger was crossed are popped. Triggering may deactivate the slot which
+    // moves the last active slot into its place. Filling only marks the order and brokers process
+    // fills in the order of their own open orders, so the order slots are visited in does not
+    // matter. Assets out of view keep their orders until they print again.
+    auto const & active_slots = this->trigger_book.get_active_slots();
+    size_t i = 0;
+    while(i < active_slots.size())
+    {
+        auto slot = active_slots[i];
+        auto asset = this->market_view[slot];
+        if(!asset)
         {
-            it = this->open_orders.erase(it);
+            i++;
+            continue;
         }
-        else
+        auto market_price = asset->get_market_price(this->on_close);
+        this->trigger_book.trigger(slot, market_price, [this, market_price](shared_ptr<Order>& order)
         {
-            it++;
-        };
+            order->fill(market_price, this->exchange_time);
+        });
+        if(i < active_slots.size() && active_slots[i] == slot)
+        {
+            i++;
+        }
     }
 }
 
@@ -453,35 +705,34 @@ void Exchange::move_expired_assets(){
     }
     else{
         for(const auto & asset : this->expired_assets){
-            auto asset_id = asset->get_asset_id();
-            
             //remove asset from market and market view
-            this->market_view.erase(asset_id);
-            this->market.erase(asset_id);
+            auto slot = this->symbol_slots[asset->asset_symbol];
+            this->market_view[slot] = nullptr;
+            this->market_view_bits[slot / 64] &= ~(uint64_t(1) << (slot % 64));
+            this->market.erase(asset->get_asset_id());
         }
     }
 }
 
 void Exchange::goto_datetime(long long datetime)
 {
-    //goto date is beyond the datetime index
-   if(datetime >= this->datetime_index[this->datetime_index_length-1])
+    // the next market view is built at the first time at or after the datetime, if the date is
+    // beyond the datetime index the exchange is done
+    this->current_index = sorted_array_lower_bound(
+        this->datetime_index,
+        0,
+        this->datetime_index_length,
+        datetime
+    );
+
+    // the index asset is stepped by the exchange and is not in the asset map
+    if(this->index_asset.has_value())
     {
-        this->current_index = this->datetime_index_length;
-    }
-    
-    // search for datetime in the index
-    for(int i = this->current_index; i < this->datetime_index_length; i++)
-    {   
-        //is >= right?
-        if(this->datetime_index[i] >= datetime)
-        {
-            this->current_index = i;
-            return;
-        }
+        this->index_asset.value()->goto_datetime(datetime);
     }
 
-    ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidDatetime);
+    // the view is rebuilt from the schedule on the next call to get_market_view
+    this->reset_market_view();
 }
 
 bool Exchange::get_market_view()
@@ -502,43 +753,56 @@ bool Exchange::get_market_view()
         this->index_asset.value()->step();
     }
 
-    // Define a lambda function that processes each asset
-    auto process_asset = [&](auto& _asset_pair) {
-        //access raw pointer
-        auto asset_raw_pointer = _asset_pair.second.get();
+    // take the assets that stepped at the previous time but not this one out of view
+    auto time = this->current_index;
+    for(auto it = this->leave_schedule.begin(time); it != this->leave_schedule.end(time); it++)
+    {
+        this->market_view[*it] = nullptr;
+        this->market_view_bits[*it / 64] &= ~(uint64_t(1) << (*it % 64));
+    }
 
-        // if asset is alligned to exchange just step forward in time, clean up if needed 
-        if(asset_raw_pointer->is_alligned){
-            asset_raw_pointer->step();
-            if(asset_raw_pointer->is_last_view()){
-                expired_assets.push_back(_asset_pair.second);
-            }
-            return;
+    // step the assets with a row at the current time, only the ones coming out of a gap in
+    // their index change the view unless it has just been reset
+    auto const & enter = this->view_synced ? this->enter_schedule : this->step_schedule;
+    auto step_slots = this->step_schedule.begin(time);
+    auto step_count = static_cast<size_t>(this->step_schedule.end(time) - step_slots);
+    auto step_range = [this, step_slots](size_t begin, size_t end)
+    {
+        for(size_t i = begin; i < end; i++)
+        {
+            this->market_slots[step_slots[i]]->step();
         }
 
-        // get the asset's current time and id
-        long long* asset_datetime = asset_raw_pointer->get_asset_time();
-        auto asset_id = asset_raw_pointer->get_asset_id(); 
-        if (asset_datetime && *asset_datetime == this->exchange_time)
-        {   
-            // add asset to market view, step the asset forward in time
-            this->market_view[asset_id] = asset_raw_pointer;
-            asset_raw_pointer->step();
-
-            // test to see if this is the last row of data for the asset
-            if(asset_raw_pointer->is_last_view()){
-                expired_assets.push_back(_asset_pair.second);
-            } 
-        }
-        else
+        // banked tracers of the range step together once their assets have moved
+        if(this->volatility_bank && !this->lazy_tracers)
         {
-            this->market_view[asset_id] = nullptr;
+            this->volatility_bank->step(step_slots + begin, end - begin);
         }
     };
-    std::for_each(
-        this->market.begin(), 
-        this->market.end(), 
-        process_asset);
+
+    // assets only touch their own rows and tracers when stepping and the index asset has already
+    // stepped, so beta tracers read the index volatility of the current time from any thread
+    if(this->thread_pool && this->parallel_step && step_count >= ARGUS_PARALLEL_STEP_MIN)
+    {
+        this->thread_pool->parallel_for(step_count, ARGUS_PARALLEL_STEP_GRAIN, step_range);
+    }
+    else
+    {
+        step_range(0, step_count);
+    }
+    for(auto it = enter.begin(time); it != enter.end(time); it++)
+    {
+        this->market_view[*it] = this->market_slots[*it].get();
+        this->market_view_bits[*it / 64] |= uint64_t(1) << (*it % 64);
+    }
+    this->view_synced = true;
+    this->view_step++;
+
+    // assets on their last row expire
+    for(auto it = this->expire_schedule.begin(time); it != this->expire_schedule.end(time); it++)
+    {
+        this->expired_assets.push_back(this->market_slots[*it]);
+    }
 
     // move to next datetime and return true showing the market contains at least one
     // asset that is not done streaming
@@ -546,17 +810,101 @@ bool Exchange::get_market_view()
     return true;
 }
 
+void Exchange::enable_panel(vector<string> columns)
+{
+    this->panel_enabled = true;
+    this->panel_columns = std::move(columns);
+}
+
+size_t Exchange::get_panel_time(int row) const
+{
+    // the current index has already moved past the current time once the market view is built
+    if(row > 0 || static_cast<size_t>(-static_cast<long long>(row)) >= this->current_index)
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::IndexOutOfBounds);
+    }
+    return this->current_index - 1 + row;
+}
+
+bool Exchange::get_panel_feature(
+    const FeatureHandle& handle,
+    int row,
+    vector<slot_value_t>& values) const
+{
+    // a row offset is relative to each asset's own rows which the exchange index does not preserve,
+    // and scalers need the asset's tracers
+    if(!this->panel.get_is_built() || row != 0 || handle.query_scaler.has_value() || this->current_index == 0)
+    {
+        return false;
+    }
+    // handles resolved against another exchange's panel are read through the assets
+    auto column_index = handle.panel_index;
+    auto const & columns = this->panel.get_columns();
+    if(!column_index.has_value() || column_index.value() >= columns.size() || columns[column_index.value()] != handle.column)
+    {
+        return false;
+    }
+
+    // an asset is in the market view at the current time exactly when it has a bar at that time,
+    // panel slots are the market slots
+    auto time = this->current_index - 1;
+    auto row_values = this->panel.get_row(column_index.value(), time);
+    for(size_t slot = 0; slot < this->panel.get_assets(); slot++)
+    {
+        if(this->panel.is_valid(time, slot))
+        {
+            values.emplace_back(static_cast<uint32_t>(slot), row_values[slot]);
+        }
+    }
+    return true;
+}
+
 optional<double> Exchange::get_asset_feature(const string& asset_id, const string& column_name, int index){
-    auto asset_sp = this->market_view.at(asset_id);
-    
-    #ifdef ARGUS_RUNTIME_ASSERT
-    assert(asset_sp);
-    #endif
+    auto asset_sp = this->get_market_view_asset(asset_id);
+    if(!asset_sp)
+    {
+        return nullopt;
+    }
 
     auto asset_value = asset_sp->get_asset_feature(column_name, index);
     return asset_value;
 }
 
+optional<double> Exchange::get_asset_feature(const string& asset_id, const FeatureHandle& handle, int index){
+    auto asset_sp = this->get_market_view_asset(asset_id);
+    if(!asset_sp)
+    {
+        return nullopt;
+    }
+
+    return asset_sp->get_asset_feature(handle, index);
+}
+
+FeatureHandle Exchange::get_feature_handle(const string& column, optional<AssetTracerType> query_scaler) const
+{
+    FeatureHandle handle{column, FEATURE_UNRESOLVED, query_scaler, this->panel.get_column_index(column)};
+    bool first = true;
+    for(auto& asset_pair : this->market)
+    {
+        auto column_index = asset_pair.second->get_feature_index(column);
+        if(!column_index.has_value())
+        {
+            ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidDataRequest);
+        }
+        if(first)
+        {
+            handle.column_index = column_index.value();
+            first = false;
+        }
+        else if(handle.column_index != column_index.value())
+        {
+            // assets disagree on the column index, reads look the column up in each asset
+            handle.column_index = FEATURE_UNRESOLVED;
+        }
+    }
+    return handle;
+}
+
 py::dict Exchange::get_exchange_feature(
     const string& column, 
     int row,
@@ -564,111 +912,263 @@ py::dict Exchange::get_exchange_feature(
     optional<AssetTracerType> query_scaler,
     int N)
 {
-    // the row must is not allowed to look into the future. Row 0 means the current row for the asset
-    // -1 means the previous, etc. The row must be valid for all asset's passed. 
-    if(row > 0)
+    // an unresolved handle looks the column up in each asset's headers
+    FeatureHandle handle{column, FEATURE_UNRESOLVED, query_scaler, this->panel.get_column_index(column)};
+    return this->get_exchange_feature(handle, row, query_type, N);
+}
+
+ExchangeFeatureCache& Exchange::get_feature_cache(const FeatureHandle& handle, int row)
+{
+    for(auto& cache : this->feature_caches)
     {
-        ARGUS_RUNTIME_ERROR(ArgusErrorCode::IndexOutOfBounds);
+        if(cache.view_step == this->view_step && cache.row == row
+            && cache.query_scaler == handle.query_scaler && cache.column == handle.column)
+        {
+            return cache;
+        }
     }
 
-    // if N = -1 than set it equal to the market_view, i.e. all asset's streaming.
-    size_t number_assets;
-    if(N == -1)
+    // reuse a stale cache before replacing a live one so its buffers are not reallocated
+    auto stale = std::find_if(this->feature_caches.begin(), this->feature_caches.end(), [this](const auto& cache)
+    {
+        return cache.view_step != this->view_step;
+    });
+    ExchangeFeatureCache* cache;
+    if(stale != this->feature_caches.end())
     {
-        number_assets = this->market_view.size();
+        cache = &*stale;
     }
-    else 
+    else if(this->feature_caches.size() < ARGUS_FEATURE_CACHE_SIZE)
     {
-        number_assets = static_cast<size_t>(N);
+        cache = &this->feature_caches.emplace_back();
     }
-    
-    py::dict py_dict;
-    // default query type implies just find all assets with the feature
-    if(query_type == ExchangeQueryType::Default)
+    else
     {
-        int i = 0;
-        for(auto it = this->market_view.begin(); it != this->market_view.end(); it++)
+        cache = &this->feature_caches[this->feature_cache_next];
+        this->feature_cache_next = (this->feature_cache_next + 1) % ARGUS_FEATURE_CACHE_SIZE;
+    }
+
+    // read the values before claiming the cache so a failed read leaves it stale
+    cache->view_step = 0;
+    cache->values.clear();
+    if(!this->get_panel_feature(handle, row, cache->values))
+    {
+        this->for_each_streaming_slot([&](uint32_t slot, Asset* asset)
         {
-            if(i == number_assets)
-            {
-                return py_dict;
-            }
-            //check if asset is streaming
-            auto asset_sp = it->second;
-            if(asset_sp)
-            {
-                //place the value in the dict if the asset has that feature, else skip
-                auto asset_feature = asset_sp->get_asset_feature(column, row, query_scaler);
-                py_dict[it->first.c_str()] = asset_feature;
-            }
-            else
-            {
-                continue;        
-            }
-            i++;
-        }
-        return py_dict;
+            cache->values.emplace_back(slot, asset->get_asset_feature(handle, row));
+            return true;
+        });
+    }
+    cache->view_step = this->view_step;
+    cache->column = handle.column;
+    cache->query_scaler = handle.query_scaler;
+    cache->row = row;
+    cache->selection_count = 0;
+    return *cache;
+}
+
+/// order the first k of [first, last) by comp, sorting everything when k is not small next to the range
+template<typename Compare>
+static void select_first(vector<slot_value_t>::iterator first, size_t k, vector<slot_value_t>::iterator last, Compare comp)
+{
+    auto n = static_cast<size_t>(last - first);
+    if(k * ARGUS_PARTIAL_SORT_RATIO < n)
+    {
+        std::partial_sort(first, first + k, last, comp);
+    }
+    else
+    {
+        std::sort(first, last, comp);
+    }
+}
+
+vector<slot_value_t> const & Exchange::select_exchange_feature(
+    const FeatureHandle& handle, 
+    int row,
+    ExchangeQueryType query_type,
+    int N)
+{
+    // the row must is not allowed to look into the future. Row 0 means the current row for the asset
+    // -1 means the previous, etc. The row must be valid for all asset's passed. 
+    if(row > 0)
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::IndexOutOfBounds);
     }
-    // query needs to be sorted, therefore we need to look at all possible assets
-    std::vector<std::pair<std::string, double>> asset_pairs;
-    for(auto it = this->market_view.begin(); it != this->market_view.end(); it++)
+
+    auto& cache = this->get_feature_cache(handle, row);
+
+    // if N = -1 than set it equal to the market_view, i.e. all asset's streaming.
+    auto const & values = cache.values;
+    size_t number_assets = N == -1 ? values.size() : std::min(static_cast<size_t>(N), values.size());
+    for(size_t i = 0; i < cache.selection_count; i++)
     {
-        //check if asset is streaming
-        auto asset_sp = it->second;
-        if(asset_sp)
+        if(cache.selections[i].query_type == query_type && cache.selections[i].number_assets == number_assets)
         {
-            //place the value in the dict if the asset has that feature, else skip
-            auto asset_value = asset_sp->get_asset_feature(column, row, query_scaler);
-            asset_pairs.emplace_back(std::make_pair(it->first.c_str(),asset_value));
-            
+            return cache.selections[i].values;
         }
     }
-    // sort the asset feature pairs using the feature 
-    std::sort(asset_pairs.begin(), asset_pairs.end(),
-              [](const auto& a, const auto& b) { return a.second < b.second; });
-
-    if(number_assets > asset_pairs.size())
+    if(cache.selection_count == cache.selections.size())
     {
-        number_assets = asset_pairs.size();
+        cache.selections.emplace_back();
     }
+    auto& cached = cache.selections[cache.selection_count++];
+    cached.query_type = query_type;
+    cached.number_assets = number_assets;
+
+    // ties are broken by market slot so the selection does not depend on the sort
+    auto ascending = [](const slot_value_t& a, const slot_value_t& b)
+    {
+        return a.second < b.second || (a.second == b.second && a.first < b.first);
+    };
+    auto descending = [](const slot_value_t& a, const slot_value_t& b)
+    {
+        return a.second > b.second || (a.second == b.second && a.first < b.first);
+    };
 
+    auto& selection = cached.values;
+    selection.assign(values.begin(), values.end());
     switch (query_type) {
+        // default query type implies just find all assets with the feature
+        case ExchangeQueryType::Default:
+            break;
         // get the assets with the N smallest values for the given column
         case ExchangeQueryType::NSmallest:
-            for(size_t i = 0; i < number_assets; i++)
-            {
-                auto pair = asset_pairs[i];
-                py_dict[pair.first.c_str()] = pair.second;
-            }
+            select_first(selection.begin(), number_assets, selection.end(), ascending);
             break;
         // get the assets with the N largest values for the given column
         case ExchangeQueryType::NLargest:
-            for(size_t i = 0; i < number_assets; i++)
-            {
-                auto pair = asset_pairs[asset_pairs.size()-i-1];
-                py_dict[pair.first.c_str()] = pair.second;
-            }
+            select_first(selection.begin(), number_assets, selection.end(), descending);
             break;
         //get the N/2 smallest and N/2 largest values for the given column
         //skips integer reaminder (i.e. N=3 returns 2 assets)
-        case ExchangeQueryType::NExtreme: 
-            for(size_t i = 0; i < std::floor(number_assets/2); i++)
-            {
-                auto pair = asset_pairs[i];
-                py_dict[pair.first.c_str()] = pair.second;
-            }
-            for(size_t i = 0; i < std::floor(number_assets/2); i++)
-            {
-                auto pair = asset_pairs[asset_pairs.size()-i-1];
-                py_dict[pair.first.c_str()] = pair.second;
-            }
-            break;
-        case ExchangeQueryType::Default:
+        case ExchangeQueryType::NExtreme:
+        {
+            auto half = number_assets / 2;
+            select_first(selection.begin(), half, selection.end(), ascending);
+            select_first(selection.begin() + half, half, selection.end(), descending);
+            number_assets = half * 2;
             break;
+        }
+    }
+    selection.resize(number_assets);
+    return selection;
+}
+
+py::dict Exchange::get_exchange_feature(
+    const FeatureHandle& handle, 
+    int row,
+    ExchangeQueryType query_type,
+    int N)
+{
+    py::dict py_dict;
+    for(auto const & [slot, value] : this->select_exchange_feature(handle, row, query_type, N))
+    {
+        py_dict[this->market_slots[slot]->get_asset_id().c_str()] = value;
     }
     return py_dict;
 }
 
+py::tuple Exchange::get_exchange_feature_array(
+    const FeatureHandle& handle, 
+    int row,
+    ExchangeQueryType query_type,
+    int N)
+{
+    auto const & selection = this->select_exchange_feature(handle, row, query_type, N);
+    py::array_t<uint32_t> slots(static_cast<py::ssize_t>(selection.size()));
+    py::array_t<double> values(static_cast<py::ssize_t>(selection.size()));
+    auto slots_ptr = slots.mutable_data();
+    auto values_ptr = values.mutable_data();
+    for(size_t i = 0; i < selection.size(); i++)
+    {
+        slots_ptr[i] = selection[i].first;
+        values_ptr[i] = selection[i].second;
+    }
+    return py::make_tuple(slots, values);
+}
+
+py::tuple Exchange::get_exchange_feature_array(
+    const string& column, 
+    int row,
+    ExchangeQueryType query_type,
+    optional<AssetTracerType> query_scaler,
+    int N)
+{
+    FeatureHandle handle{column, FEATURE_UNRESOLVED, query_scaler, this->panel.get_column_index(column)};
+    return this->get_exchange_feature_array(handle, row, query_type, N);
+}
+
+vector<string> Exchange::get_slot_asset_ids() const
+{
+    vector<string> asset_ids;
+    asset_ids.reserve(this->market_slots.size());
+    for(auto& asset : this->market_slots)
+    {
+        asset_ids.push_back(asset->get_asset_id());
+    }
+    return asset_ids;
+}
+
+void Exchange::set_asset_group(const string& asset_id, const string& group)
+{
+    auto asset = this->market.find(asset_id);
+    if(asset == this->market.end())
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidId);
+    }
+    auto asset_symbol = asset->second->asset_symbol;
+    auto group_symbol = intern_symbol(SymbolType::Group, group);
+    this->asset_groups[asset_symbol] = group_symbol;
+
+    // once built the slot is assigned, otherwise the group is applied on build
+    if(asset_symbol < this->symbol_slots.size() && this->symbol_slots[asset_symbol] != EXCHANGE_SLOT_NONE
+        && this->symbol_slots[asset_symbol] < this->cross_section.get_slots())
+    {
+        this->cross_section.set_group(this->symbol_slots[asset_symbol], group_symbol);
+    }
+}
+
+double const * Exchange::transform_cross_section(
+    const FeatureHandle& handle,
+    CrossSectionTransform transform,
+    int row,
+    double lower,
+    double upper)
+{
+    if(!this->is_built)
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::NotBuilt);
+    }
+    auto const & values = this->select_exchange_feature(handle, row, ExchangeQueryType::Default, -1);
+    return this->cross_section.transform(values, transform, lower, upper);
+}
+
+py::array_t<double> Exchange::get_cross_section(
+    const FeatureHandle& handle,
+    CrossSectionTransform transform,
+    int row,
+    double lower,
+    double upper)
+{
+    // the transform's buffer is reused by the next transform, python gets its own copy
+    return py::array_t<double>(
+        static_cast<py::ssize_t>(this->cross_section.get_slots()),
+        this->transform_cross_section(handle, transform, row, lower, upper)
+    );
+}
+
+py::array_t<double> Exchange::get_cross_section(
+    const string& column,
+    CrossSectionTransform transform,
+    int row,
+    optional<AssetTracerType> query_scaler,
+    double lower,
+    double upper)
+{
+    FeatureHandle handle{column, FEATURE_UNRESOLVED, query_scaler, this->panel.get_column_index(column)};
+    return this->get_cross_section(handle, transform, row, lower, upper);
+}
+
 double ExchangeMap::get_market_price(const string& asset_id)
 {
     auto& asset = this->asset_map.at(asset_id);
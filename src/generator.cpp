@@ -0,0 +1,156 @@
+//
+// synthetic market data generator used for scale testing and benchmarks
+//
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <fmt/core.h>
+
+#include "generator.h"
+#include "utils_string.h"
+
+using namespace std;
+
+/// how a generated column is filled
+enum GeneratedColumn
+{
+    GeneratedOpen,
+    GeneratedHigh,
+    GeneratedLow,
+    GeneratedClose,
+    GeneratedVolume,
+    GeneratedNoise
+};
+
+/// mix a universe seed and an asset number into an independent asset seed (splitmix64)
+static unsigned long long asset_seed(unsigned long long seed, size_t asset_number)
+{
+    unsigned long long z = seed + (asset_number + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static vector<GeneratedColumn> parse_generated_columns(const vector<string>& columns)
+{
+    vector<GeneratedColumn> kinds;
+    kinds.reserve(columns.size());
+    for(auto const & column : columns)
+    {
+        if(case_ins_str_compare(column, "open"))        kinds.push_back(GeneratedOpen);
+        else if(case_ins_str_compare(column, "high"))   kinds.push_back(GeneratedHigh);
+        else if(case_ins_str_compare(column, "low"))    kinds.push_back(GeneratedLow);
+        else if(case_ins_str_compare(column, "close"))  kinds.push_back(GeneratedClose);
+        else if(case_ins_str_compare(column, "volume")) kinds.push_back(GeneratedVolume);
+        else kinds.push_back(GeneratedNoise);
+    }
+    return kinds;
+}
+
+Asset::asset_sp_t generate_asset(
+    const string& asset_id,
+    const string& exchange_id,
+    const string& broker_id,
+    size_t rows,
+    size_t start_row,
+    unsigned long long seed,
+    const UniverseConfig& config)
+{
+    if(rows == 0)
+    {
+        throw std::invalid_argument("generated asset must have at least one row");
+    }
+
+    auto kinds = parse_generated_columns(config.columns);
+    auto cols = config.columns.size();
+
+    // load headers first, throws if the open or close column is missing
+    auto asset = new_asset(asset_id, exchange_id, broker_id, config.warmup);
+    asset->load_headers(config.columns);
+    asset->allocate_data(rows, cols, config.layout, config.precision);
+
+    std::mt19937_64 rng(seed);
+    std::normal_distribution<double> returns(config.drift, config.volatility);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    std::uniform_real_distribution<double> volume(1e5, 1e6);
+
+    auto datetime_index = asset->get_datetime_index();
+    auto row_stride = asset->get_row_stride();
+    auto col_stride = asset->get_col_stride();
+
+    // the walk is always computed in double and narrowed on write for float32 assets
+    auto generate = [&](auto* data)
+    {
+        using value_t = std::remove_pointer_t<decltype(data)>;
+        double close = 100.0;
+        for(size_t i = 0; i < rows; i++)
+        {
+            // open gaps a fraction of a bar's move away from the previous close
+            double open = close * (1 + returns(rng) / 4);
+            close = open * (1 + returns(rng));
+            double high = std::max(open, close) * (1 + std::abs(noise(rng)) * config.volatility / 2);
+            double low = std::min(open, close) * (1 - std::abs(noise(rng)) * config.volatility / 2);
+
+            auto row = &data[i * row_stride];
+            for(size_t j = 0; j < cols; j++)
+            {
+                double value = 0;
+                switch(kinds[j])
+                {
+                    case GeneratedOpen:   value = open; break;
+                    case GeneratedHigh:   value = high; break;
+                    case GeneratedLow:    value = low; break;
+                    case GeneratedClose:  value = close; break;
+                    case GeneratedVolume: value = std::round(volume(rng)); break;
+                    case GeneratedNoise:  value = noise(rng); break;
+                }
+                row[j * col_stride] = static_cast<value_t>(value);
+            }
+            datetime_index[i] = config.start_time + static_cast<long long>(start_row + i) * config.spacing;
+        }
+    };
+    if(config.precision == AssetPrecision::Float64)
+    {
+        generate(asset->get_data());
+    }
+    else
+    {
+        generate(asset->get_data_f32());
+    }
+    return asset;
+}
+
+vector<Asset::asset_sp_t> generate_universe(
+    const string& exchange_id,
+    const string& broker_id,
+    const UniverseConfig& config)
+{
+    if(config.gap < 0.0 || config.gap >= 0.5)
+    {
+        throw std::invalid_argument("universe gap must be in [0, 0.5)");
+    }
+
+    // listing and delisting offsets are drawn from a universe level stream so they do not depend
+    // on the columns being generated
+    std::mt19937_64 rng(config.seed);
+    auto max_offset = static_cast<size_t>(config.gap * config.rows);
+    std::uniform_int_distribution<size_t> offsets(0, max_offset);
+
+    vector<Asset::asset_sp_t> assets;
+    assets.reserve(config.assets);
+    for(size_t i = 0; i < config.assets; i++)
+    {
+        size_t start_row = offsets(rng);
+        size_t end_offset = offsets(rng);
+        size_t rows = config.rows - start_row - end_offset;
+        assets.push_back(generate_asset(
+            fmt::format("{}{}", config.prefix, i),
+            exchange_id,
+            broker_id,
+            rows,
+            start_row,
+            asset_seed(config.seed, i),
+            config));
+    }
+    return assets;
+}
@@ -3,6 +3,7 @@
 //
 #include <cstddef>
 #include <cstdio>
+#include <set>
 #include <stdexcept>
 #include "pch.h"
 #include <fmt/core.h>
@@ -15,10 +16,14 @@
 #include "settings.h"
 #include "utils_time.h"
 #include "utils_array.h"
+#include "alloc_tracker.h"
 
 namespace py = pybind11;
 using namespace std;
 
+/// time a phase of the event loop and attribute the allocations made within it
+#define ARGUS_HYDRA_PHASE(phase) ARGUS_PROFILE_SCOPE(this->profiler.get_phase(phase)); ARGUS_ALLOC_PHASE(phase)
+
 using portfolio_sp_t = Portfolio::portfolio_sp_t;
 using exchanges_sp_t = ExchangeMap::exchanges_sp_t; 
 using asset_sp_t = Asset::asset_sp_t;
@@ -88,6 +93,13 @@ void Hydra::reset(bool clear_history, bool clear_strategies)
     //reset all portfolios
     this->master_portfolio->reset(clear_history);
 
+    // clear the profile of the previous run
+    if(clear_history)
+    {
+        this->reset_profile();
+        this->reset_alloc_profile();
+    }
+
     // remove existing strategies if needed
     if(clear_strategies)
     {
@@ -118,9 +130,9 @@ void Hydra::build()
     this->candles = 0;
 
     // build the exchanges
+    this->build_exchanges();
     for (auto it = this->exchange_map->exchanges.begin(); it != this->exchange_map->exchanges.end(); ++it)
     {
-        it->second->build();
         this->candles += it->second->candles;
     }
 
@@ -141,17 +153,173 @@ void Hydra::build()
     this->datetime_index = get<0>(datetime_index_);
     this->datetime_index_length = get<1>(datetime_index_);
 
+    // find the exchanges that step and expire assets at each hydra time
+    this->build_schedules();
+
     //build portfolios with given size
     this->master_portfolio->build(this->datetime_index_length);
 
+    #ifdef ARGUS_ALLOC_TRACKING
+    this->step_allocations.reserve(this->datetime_index_length);
+    this->step_bytes.reserve(this->datetime_index_length);
+    #endif
+
     this->is_built = true;
 };
 
+void Hydra::build_schedules()
+{
+    this->step_exchanges.clear();
+    for(auto& exchange_pair : this->exchange_map->exchanges)
+    {
+        this->step_exchanges.push_back(exchange_pair.second.get());
+    }
+
+    // every exchange time is in the hydra index, walk both indexes together and map each exchange
+    // row onto its hydra row. Rows are visited in exchange order so each hydra time lists its
+    // exchanges in exchange map order.
+    auto walk_rows = [this](auto&& on_row)
+    {
+        for(size_t position = 0; position < this->step_exchanges.size(); position++)
+        {
+            auto exchange = this->step_exchanges[position];
+            auto exchange_index = exchange->get_datetime_index();
+            size_t hydra_row = 0;
+            for(size_t row = 0; row < exchange->get_rows(); row++)
+            {
+                while(this->datetime_index[hydra_row] != exchange_index[row])
+                {
+                    hydra_row++;
+                }
+                on_row(position, exchange, row, hydra_row);
+            }
+        }
+    };
+
+    SlotSchedule* schedules[] = {&this->tick_schedule, &this->expire_schedule};
+    for(auto schedule : schedules)
+    {
+        schedule->offsets.assign(this->datetime_index_length + 1, 0);
+    }
+    walk_rows([&](size_t, Exchange* exchange, size_t row, size_t hydra_row)
+    {
+        this->tick_schedule.offsets[hydra_row + 1]++;
+        if(exchange->has_expirations(row))
+        {
+            this->expire_schedule.offsets[hydra_row + 1]++;
+        }
+    });
+
+    vector<size_t> fill[2];
+    for(size_t kind = 0; kind < 2; kind++)
+    {
+        auto schedule = schedules[kind];
+        for(size_t time = 0; time < this->datetime_index_length; time++)
+        {
+            schedule->offsets[time + 1] += schedule->offsets[time];
+        }
+        schedule->slots.resize(schedule->offsets.back());
+        fill[kind].assign(schedule->offsets.begin(), schedule->offsets.end() - 1);
+    }
+    walk_rows([&](size_t position, Exchange* exchange, size_t row, size_t hydra_row)
+    {
+        this->tick_schedule.slots[fill[0][hydra_row]++] = static_cast<uint32_t>(position);
+        if(exchange->has_expirations(row))
+        {
+            this->expire_schedule.slots[fill[1][hydra_row]++] = static_cast<uint32_t>(position);
+        }
+    });
+}
+
+void Hydra::build_exchanges()
+{
+    vector<Exchange*> exchanges;
+    for(auto& exchange_pair : this->exchange_map->exchanges)
+    {
+        exchanges.push_back(exchange_pair.second.get());
+    }
+
+    // an exchange builds its assets across the pool, with at least as many exchanges as threads
+    // the exchanges are built across the pool instead. Exchanges sharing an index asset both build
+    // it so they are built one at a time.
+    bool shared_index = false;
+    set<Asset*> index_assets;
+    for(auto exchange : exchanges)
+    {
+        auto index_asset = exchange->get_index_asset();
+        if(index_asset.has_value() && !index_assets.insert(index_asset.value().get()).second)
+        {
+            shared_index = true;
+        }
+    }
+    if(!this->thread_pool || shared_index || exchanges.size() < this->thread_pool->get_workers())
+    {
+        for(auto exchange : exchanges)
+        {
+            exchange->build();
+        }
+        return;
+    }
+
+    // the pool is not reentrant, exchanges build their assets serially while it is in use
+    auto set_exchange_pools = [&](const shared_ptr<ThreadPool>& thread_pool_)
+    {
+        for(auto exchange : exchanges)
+        {
+            exchange->set_thread_pool(thread_pool_);
+        }
+    };
+    auto build_range = [&](size_t begin, size_t end)
+    {
+        for(size_t i = begin; i < end; i++)
+        {
+            exchanges[i]->build();
+        }
+    };
+    set_exchange_pools(nullptr);
+    try
+    {
+        this->thread_pool->parallel_for(exchanges.size(), 1, build_range);
+    }
+    catch(...)
+    {
+        set_exchange_pools(this->thread_pool);
+        throw;
+    }
+    set_exchange_pools(this->thread_pool);
+}
+
 void Hydra::register_asset(const asset_sp_t &asset_, const string & exchange_id_)
 {
     this->exchange_map->register_asset(asset_, exchange_id_);
 }
 
+vector<asset_sp_t> Hydra::register_assets(
+    const vector<string>& asset_ids,
+    const string& exchange_id,
+    const string& broker_id,
+    const vector<vector<string>>& headers,
+    const vector<py::buffer>& data,
+    const vector<py::buffer>& datetime_indexes,
+    size_t warmup,
+    AssetLayout layout,
+    AssetPrecision precision)
+{
+    // fail before loading anything if the exchange does not exist
+    if(!this->exchange_map->get_exchange(exchange_id).has_value())
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidId);
+    }
+
+    auto assets = py_load_assets(asset_ids, exchange_id, broker_id, headers, data, datetime_indexes,
+        warmup, layout, precision, this->thread_pool.get());
+    for(auto& asset : assets)
+    {
+        this->exchange_map->register_asset(asset, exchange_id);
+    }
+    return assets;
+}
+
 void Hydra::register_index_asset(const asset_sp_t &asset_, string exchange_id_)
 {   
     if(exchange_id_ != "")
@@ -181,9 +349,11 @@ shared_ptr<Portfolio> Hydra::get_portfolio(const string& portfolio_id){
     if(portfolio_id == this->master_portfolio->get_portfolio_id()){
         return this->master_portfolio;
     }
-    else{
-        return this->master_portfolio->find_portfolio(portfolio_id);
+    auto portfolio = this->master_portfolio->find_portfolio(portfolio_id);
+    if(!portfolio){
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidId);
     }
+    return portfolio;
 }
 
 shared_ptr<Portfolio> Hydra::new_portfolio(const string & portfolio_id_, double cash_){
@@ -249,7 +419,8 @@ shared_ptr<Exchange> Hydra::new_exchange(const string &exchange_id)
     auto exchange = make_shared<Exchange>(exchange_id, this->logging);
 
     // insert a clone of the smart pointer into the exchange
-    this->exchange_map->exchanges.emplace(exchange_id, exchange);
+    this->exchange_map->register_exchange(exchange);
+    exchange->set_thread_pool(this->thread_pool);
 
     #ifdef ARGUS_STRIP
     if (this->logging == 1)
@@ -266,6 +437,19 @@ shared_ptr<Exchange> Hydra::new_exchange(const string &exchange_id)
     return exchange;
 }
 
+void Hydra::set_threads(size_t threads)
+{
+    if(threads == 0)
+    {
+        threads = std::max<unsigned>(std::thread::hardware_concurrency(), 1);
+    }
+    this->thread_pool = threads > 1 ? make_shared<ThreadPool>(threads) : nullptr;
+    for(auto& exchange_pair : this->exchange_map->exchanges)
+    {
+        exchange_pair.second->set_thread_pool(this->thread_pool);
+    }
+}
+
 shared_ptr<Broker> Hydra::new_broker(const std::string &broker_id, double cash)
 {
     if (this->brokers->count(broker_id))
@@ -281,7 +465,7 @@ shared_ptr<Broker> Hydra::new_broker(const std::string &broker_id, double cash)
     );
 
     // insert a clone of the smart pointer into the exchange
-    this->brokers->emplace(broker_id, broker);
+    this->brokers->add_broker(broker);
 
     #ifdef ARGUS_STRIP
     if (this->logging == 1)
@@ -363,6 +547,9 @@ void Hydra::cleanup_asset(const string& asset_id){
 
 void Hydra::forward_pass()
 {
+    ARGUS_HYDRA_PHASE(ProfilePhase::ForwardPass);
+    ARGUS_ALLOC_STRICT(this->alloc_strict && this->current_index >= this->alloc_strict_warmup);
+
     //current global simulation time
     this->hydra_time = this->datetime_index[this->current_index];
 
@@ -373,23 +560,25 @@ void Hydra::forward_pass()
     }
     #endif
 
-    // build market views for exchanges
+    // build market views for the exchanges with a row at the hydra time, the view of an idle
+    // exchange has not changed since its resting orders were last checked
     this->exchange_map->on_close = false;
-    for (auto &exchange_pair : this->exchange_map->exchanges)
+    for (auto exchange : this->step_exchanges)
     {
-        auto exchange = exchange_pair.second;
-        // set the exchange is_close
         exchange->set_on_close(false);
+    }
+    auto tick_schedule_end = this->tick_schedule.end(this->current_index);
+    for (auto it = this->tick_schedule.begin(this->current_index); it != tick_schedule_end; it++)
+    {
+        auto exchange = this->step_exchanges[*it];
+        exchange->get_market_view();
 
-        // if the exchange time is equal to the hydra time then build market view
-        if (exchange->get_datetime() == this->hydra_time)
+        // allow exchanges to process open orders
         {
-            auto exchange_steaming = exchange->get_market_view();
+            ARGUS_HYDRA_PHASE(ProfilePhase::ExchangeProcessOrders);
+            exchange->process_orders();
         }
-
-        // allow exchanges to process open orders
-        exchange_pair.second->process_orders();
-    }  
+    }
     #ifdef ARGUS_STRIP
     if(this->logging == 1)
     {
@@ -397,26 +586,37 @@ void Hydra::forward_pass()
     }
 
     //evaluate master portfolio at open
-    this->master_portfolio->evaluate(false);
+    {
+        ARGUS_HYDRA_PHASE(ProfilePhase::PortfolioEvaluate);
+        this->master_portfolio->evaluate(false);
+    }
 
     #endif 
 }
 
 void Hydra::on_open(){
+    ARGUS_HYDRA_PHASE(ProfilePhase::OnOpen);
+
      // allow broker to process orders that have been filled or orders that were placed by 
      // strategies with lazy execution
     for (auto &broker_pair : *this->brokers)
     {   
-        broker_pair.second->send_orders();    
-        broker_pair.second->process_orders();
+        {
+            ARGUS_HYDRA_PHASE(ProfilePhase::BrokerSendOrders);
+            broker_pair.second->send_orders();
+        }
+        {
+            ARGUS_HYDRA_PHASE(ProfilePhase::BrokerProcessOrders);
+            broker_pair.second->process_orders();
+        }
     }   
 
 
     // move exchanges to close
     this->exchange_map->on_close = true;
-    for (auto &exchange_pair : this->exchange_map->exchanges)
+    for (auto exchange : this->step_exchanges)
     {
-        exchange_pair.second->set_on_close(true);
+        exchange->set_on_close(true);
     }
 
     #ifdef ARGUS_STRIP
@@ -424,7 +624,10 @@ void Hydra::on_open(){
     #endif
 
     //evaluate master portfolio at close
-    this->master_portfolio->evaluate(true);
+    {
+        ARGUS_HYDRA_PHASE(ProfilePhase::PortfolioEvaluate);
+        this->master_portfolio->evaluate(true);
+    }
 
     #ifdef ARGUS_STRIP
     if(this->logging == 1){this->log("master portfolio evaluation complete");}
@@ -433,6 +636,9 @@ void Hydra::on_open(){
 }
 
 void Hydra::backward_pass(){
+    ARGUS_HYDRA_PHASE(ProfilePhase::BackwardPass);
+    ARGUS_ALLOC_STRICT(this->alloc_strict && this->current_index >= this->alloc_strict_warmup);
+
     #ifdef ARGUS_STRIP
     if(this->logging == 1)
     {
@@ -443,44 +649,52 @@ void Hydra::backward_pass(){
     // send any orders that were placed with lazy execution
     for (auto &broker_pair : *this->brokers)
     {
+        ARGUS_HYDRA_PHASE(ProfilePhase::BrokerSendOrders);
         broker_pair.second->send_orders();
     }
 
-    // allow exchanges to process orders placed at close
-    for (auto &exchange_pair : this->exchange_map->exchanges)
+    // allow exchanges to process orders placed at close, orders placed on an idle exchange are
+    // checked against its last close when they are placed
+    auto tick_schedule_end = this->tick_schedule.end(this->current_index);
+    for (auto it = this->tick_schedule.begin(this->current_index); it != tick_schedule_end; it++)
     {
-        exchange_pair.second->process_orders();
+        ARGUS_HYDRA_PHASE(ProfilePhase::ExchangeProcessOrders);
+        this->step_exchanges[*it]->process_orders();
     }
 
     // process any orders that have just been filled
     for (auto &broker_pair : *this->brokers)
     {
+        ARGUS_HYDRA_PHASE(ProfilePhase::BrokerProcessOrders);
         broker_pair.second->process_orders();
     }
 
     //update historicals values
-    this->master_portfolio->update(this->hydra_time);
+    {
+        ARGUS_HYDRA_PHASE(ProfilePhase::PortfolioUpdate);
+        this->master_portfolio->update(this->hydra_time);
+    }
         
     // hanndle any assets done streaming
     if(this->current_index < datetime_index_length - 1)
     {
-        for (auto &exchange_pair : this->exchange_map->exchanges)
+        auto expire_schedule_end = this->expire_schedule.end(this->current_index);
+        for (auto it = this->expire_schedule.begin(this->current_index); it != expire_schedule_end; it++)
         {
             //find expired assets and remove them from portfolio and appropriate exchange
-            auto expired_assets =  exchange_pair.second->get_expired_assets();
-        
+            auto exchange = this->step_exchanges[*it];
+            auto expired_assets = exchange->get_expired_assets();
             if(!expired_assets.has_value()){
                 continue;
             }
-            else{
-                // close any open positions in the asset
-                for(auto const & asset : *expired_assets.value()){
-                    this->cleanup_asset(asset->get_asset_id());
-                }
 
-                //remove the asset from the market and market view
-                exchange_pair.second->move_expired_assets();
+            // close any open positions in the asset
+            for(auto const & asset : *expired_assets.value()){
+                this->cleanup_asset(asset->get_asset_id());
             }
+
+            //remove the asset from the market and market view
+            exchange->move_expired_assets();
         }
     }
 
@@ -513,7 +727,7 @@ void Hydra::process_order_history(
             if(order->get_placed_on_close() == on_close)
             {
                 // find the broker the order was placed to
-                auto broker= this->brokers->at(order->get_broker_id());
+                auto broker = this->brokers->get_broker(order->get_broker_symbol());
                 
                 //unfill the order, and replace it at the broker
                 order->unfill();
@@ -590,28 +804,30 @@ void Hydra::goto_datetime(long long datetime)
         ARGUS_RUNTIME_ERROR(ArgusErrorCode::NotBuilt);
     }
 
-    // move exchanges forward in time
+    // find the datetime in the hydra index before moving anything
+    auto index = sorted_array_find(
+        this->datetime_index,
+        this->datetime_index_length,
+        datetime
+    );
+    if(!index.has_value())
+    {
+        throw runtime_error("failed to find datetime in hydra index");
+    }
+
+    // move exchanges in time
     for(auto& exchange_pair : this->exchange_map->exchanges)
     {
         exchange_pair.second->goto_datetime(datetime);
     }
 
-    // move the indivual asssets forward in time
+    // move the indivual asssets in time
     for(auto& asset_pair : this->exchange_map->asset_map)
     {
         asset_pair.second->goto_datetime(datetime);
     }
 
-    // move the hydra index forward in time
-    for(int i = 0; i < this->datetime_index_length; i++)
-    {
-        if(this->datetime_index[i] == datetime)
-        {
-            this->current_index = i;
-            return;
-        }
-    }
-    throw runtime_error("failed to find datetime in hydra index");
+    this->current_index = index.value();
 }
 
 void Hydra::run(long long to, size_t steps){
@@ -628,27 +844,45 @@ void Hydra::run(long long to, size_t steps){
     //core event loop
     for(int i = this->current_index; i < this->datetime_index_length; i++)
     {
+        #ifdef ARGUS_ALLOC_TRACKING
+        auto step_start = AllocTracker::get_total_counter();
+        #endif
+
         //generate market view and handle broker,exchange objects on open
         this->forward_pass();
 
         //allow strategies to place orders at open
-        for(auto & strategy : this->strategies)
         {
-            strategy->cxx_handler_on_open();    
-        };
+            ARGUS_HYDRA_PHASE(ProfilePhase::StrategyOnOpen);
+            for(auto & strategy : this->strategies)
+            {
+                ARGUS_PROFILE_SCOPE(strategy->on_open_profile);
+                strategy->cxx_handler_on_open();    
+            };
+        }
 
         // process orders that were placed on open
         this->on_open();
 
         //allow strategies to place orders at close
-        for(auto & strategy : this->strategies)
         {
-            strategy->cxx_handler_on_close();    
-        };
+            ARGUS_HYDRA_PHASE(ProfilePhase::StrategyOnClose);
+            for(auto & strategy : this->strategies)
+            {
+                ARGUS_PROFILE_SCOPE(strategy->on_close_profile);
+                strategy->cxx_handler_on_close();    
+            };
+        }
 
         //cleanup and move forward in time
         this->backward_pass();
 
+        #ifdef ARGUS_ALLOC_TRACKING
+        auto const & step_end = AllocTracker::get_total_counter();
+        this->step_allocations.push_back(step_end.allocations - step_start.allocations);
+        this->step_bytes.push_back(step_end.bytes - step_start.bytes);
+        #endif
+
         //check if running to specific point in time
         if(to && this->hydra_time == to)
         {
@@ -665,4 +899,82 @@ void Hydra::run(long long to, size_t steps){
     {
         this->log("hydra run complete");
     }
-}
\ No newline at end of file
+}
+
+py::dict Hydra::get_profile()
+{
+    auto ns_per_tick = this->profiler.get_ns_per_tick();
+
+    py::dict profile;
+    py::dict phases;
+    for(size_t i = 0; i < ProfilePhase::PhaseCount; i++)
+    {
+        phases[py::str(ProfilePhaseStrings[i])] = this->profiler.get_phase(static_cast<ProfilePhase>(i)).to_dict(ns_per_tick);
+    }
+    profile["phases"] = phases;
+
+    py::dict strategies;
+    for(auto& strategy : this->strategies)
+    {
+        py::dict strategy_profile;
+        strategy_profile["on_open"] = strategy->on_open_profile.to_dict(ns_per_tick);
+        strategy_profile["on_close"] = strategy->on_close_profile.to_dict(ns_per_tick);
+        strategies[py::str(strategy->get_strategy_id())] = strategy_profile;
+    }
+    profile["strategies"] = strategies;
+    profile["bucket_edges_ns"] = this->profiler.get_bucket_edges(ns_per_tick);
+    return profile;
+}
+
+void Hydra::reset_profile()
+{
+    this->profiler.reset();
+    for(auto& strategy : this->strategies)
+    {
+        strategy->on_open_profile.reset();
+        strategy->on_close_profile.reset();
+    }
+}
+
+void Hydra::set_alloc_strict(bool strict, size_t warmup_steps)
+{
+    this->alloc_strict = strict;
+    this->alloc_strict_warmup = warmup_steps;
+}
+
+static py::dict alloc_counter_to_dict(const AllocCounter& counter)
+{
+    py::dict result;
+    result["allocations"] = counter.allocations;
+    result["bytes"] = counter.bytes;
+    result["frees"] = counter.frees;
+    return result;
+}
+
+py::dict Hydra::get_alloc_profile()
+{
+    py::dict profile;
+    profile["enabled"] = AllocTracker::is_enabled();
+
+    py::dict phases;
+    for(size_t i = 0; i < ProfilePhase::PhaseCount; i++)
+    {
+        auto phase = static_cast<ProfilePhase>(i);
+        auto counter = alloc_counter_to_dict(AllocTracker::get_phase_counter(phase));
+        counter["violations"] = AllocTracker::get_phase_violations(phase);
+        phases[py::str(ProfilePhaseStrings[i])] = counter;
+    }
+    profile["phases"] = phases;
+    profile["total"] = alloc_counter_to_dict(AllocTracker::get_total_counter());
+    profile["violations"] = AllocTracker::get_violations();
+    profile["step_allocations"] = py::array_t<size_t>(this->step_allocations.size(), this->step_allocations.data());
+    profile["step_bytes"] = py::array_t<size_t>(this->step_bytes.size(), this->step_bytes.data());
+    return profile;
+}
+
+void Hydra::reset_alloc_profile()
+{
+    AllocTracker::reset();
+    this->step_allocations.clear();
+    this->step_bytes.clear();
+}
@@ -3,6 +3,7 @@
 //
 #include <cstddef>
 #include <fmt/core.h>
+#include <sstream>
 #include <string>
 #include <memory>
 #include <pybind11/pybind11.h>
@@ -10,41 +11,100 @@
 
 #include "account.h"
 #include "asset.h"
+#include "asset_file.h"
 #include "broker.h"
 #include "exchange.h"
+#include "generator.h"
 #include "hydra.h"
 #include "order.h"
 #include "portfolio.h"
 #include "position.h"
 #include "pybind11/cast.h"
+#include "runner.h"
 #include "settings.h"
+#include "utils_time.h"
 
 namespace py = pybind11;
 using namespace std;
 
 void init_asset_ext(py::module &m)
 {
+    py::class_<FeatureHandle>(m, "FeatureHandle")
+        .def_readonly("column",         &FeatureHandle::column)
+        .def_readonly("column_index",   &FeatureHandle::column_index)
+        .def_readonly("query_scaler",   &FeatureHandle::query_scaler)
+        .def_readonly("panel_index",    &FeatureHandle::panel_index);
+
     py::class_<Asset, std::shared_ptr<Asset>>(m, "Asset")
         .def("get_asset_id",            &Asset::get_asset_id)
         .def("load_headers",            &Asset::load_headers)
-        .def("load_data",               &Asset::py_load_data)
+        .def("load_data",               &Asset::py_load_data,
+            py::arg("data"),
+            py::arg("datetime_index"),
+            py::arg("rows"),
+            py::arg("cols"),
+            py::arg("is_view") = false,
+            py::arg("layout") = AssetLayout::RowMajor,
+            py::arg("precision") = AssetPrecision::Float64)
+        .def("load_view",               &Asset::py_load_view,
+            py::arg("data"),
+            py::arg("datetime_index"))
+        .def("save_binary",             &Asset::save_binary,
+            py::arg("path"))
+        .def("load_mmap",               &Asset::load_mmap,
+            py::arg("path"))
+        .def("load_stream",             &Asset::py_load_stream,
+            py::arg("chunks"),
+            py::arg("datetime_index"),
+            py::arg("chunk_rows") = ASSET_STREAM_CHUNK_ROWS,
+            py::arg("lookback") = 0)
+        .def("load_file_stream",        &Asset::load_file_stream,
+            py::arg("path"),
+            py::arg("chunk_rows") = ASSET_STREAM_CHUNK_ROWS,
+            py::arg("lookback") = 0)
+        .def("is_streaming",            &Asset::get_is_streaming)
         .def("get_rows",                &Asset::get_rows)
         .def("get_cols",                &Asset::get_cols)
+        .def("get_layout",              &Asset::get_layout)
+        .def("get_precision",           &Asset::get_precision)
         .def("get_headers",             &Asset::get_headers)
-        .def("get",                     &Asset::get)
+        .def("get",                     static_cast<double (Asset::*)(const string&, size_t) const>(&Asset::get))
+        .def("get",                     static_cast<double (Asset::*)(const FeatureHandle&, size_t) const>(&Asset::get))
+        .def("get_feature_handle",      &Asset::get_feature_handle,
+            py::arg("column_name"),
+            py::arg("query_scaler") = nullopt)
+        .def("get_asset_feature",
+            static_cast<double (Asset::*)(const FeatureHandle&, int)>(&Asset::get_asset_feature),
+            py::arg("handle"),
+            py::arg("index") = 0)
         .def("get_mem_address",         &Asset::get_mem_address)
-        .def("get_column",              &Asset::get_column)
+        // column views are based on the asset so they can outlive the python references to it
+        .def("get_column",
+            [](const std::shared_ptr<Asset>& self, const string& column_name, size_t length) {
+                return self->get_column(column_name, length, py::cast(self));
+            },
+            py::arg("column_name"),
+            py::arg("length"))
         .def("get_volatility",          &Asset::get_volatility)
         .def("get_beta",                &Asset::get_beta)
-        .def("get_datetime_index_view", &Asset::get_datetime_index_view,
-            py::return_value_policy::reference)
-        .def("get_data_view",           &Asset::get_data_view,
-            py::return_value_policy::reference)
-
-        .def("add_tracer", &Asset::add_tracer),
+        .def("get_tracer_value",        &Asset::get_tracer_value)
+        .def("get_lazy_tracers",        &Asset::get_lazy_tracers)
+        .def("get_datetime_index_view",
+            [](const std::shared_ptr<Asset>& self) {
+                return self->get_datetime_index_view(py::cast(self));
+            })
+        .def("get_data_view",
+            [](const std::shared_ptr<Asset>& self) {
+                return self->get_data_view(py::cast(self));
+            })
+
+        .def("add_tracer",
+            static_cast<void (Asset::*)(AssetTracerType, size_t, bool, const string&, const string&)>(&Asset::add_tracer),
             py::arg("tracer_type"),
             py::arg("lookback"),
-            py::arg("adjust_warmup") = false;
+            py::arg("adjust_warmup") = false,
+            py::arg("column") = "",
+            py::arg("name") = "");
 
     m.def("new_asset", &new_asset, py::return_value_policy::reference,
             py::arg("asset_id"),
@@ -53,6 +113,71 @@ void init_asset_ext(py::module &m)
             py::arg("warmup") = 0
     );
 
+    m.def("generate_universe", [](
+            const string& exchange_id,
+            const string& broker_id,
+            size_t assets,
+            size_t rows,
+            const vector<string>& columns,
+            double gap,
+            unsigned long long seed,
+            long long start_time,
+            long long spacing,
+            double drift,
+            double volatility,
+            const string& prefix,
+            size_t warmup,
+            AssetLayout layout,
+            AssetPrecision precision)
+        {
+            UniverseConfig config;
+            config.assets = assets;
+            config.rows = rows;
+            config.columns = columns;
+            config.gap = gap;
+            config.seed = seed;
+            config.start_time = start_time;
+            config.spacing = spacing;
+            config.drift = drift;
+            config.volatility = volatility;
+            config.prefix = prefix;
+            config.warmup = warmup;
+            config.layout = layout;
+            config.precision = precision;
+            return generate_universe(exchange_id, broker_id, config);
+        },
+            py::arg("exchange_id"),
+            py::arg("broker_id"),
+            py::arg("assets"),
+            py::arg("rows"),
+            py::arg("columns") = vector<string>{"open", "close"},
+            py::arg("gap") = 0.0,
+            py::arg("seed") = 0,
+            py::arg("start_time") = UniverseConfig{}.start_time,
+            py::arg("spacing") = UniverseConfig{}.spacing,
+            py::arg("drift") = UniverseConfig{}.drift,
+            py::arg("volatility") = UniverseConfig{}.volatility,
+            py::arg("prefix") = "ASSET",
+            py::arg("warmup") = 0,
+            py::arg("layout") = AssetLayout::RowMajor,
+            py::arg("precision") = AssetPrecision::Float64
+    );
+
+    m.def("load_asset_file",
+        static_cast<Asset::asset_sp_t (*)(const string&, const string&, const string&, size_t)>(&load_asset_file),
+            py::arg("path"),
+            py::arg("exchange_id"),
+            py::arg("broker_id"),
+            py::arg("warmup") = 0
+    );
+
+    m.def("load_asset_directory", &load_asset_directory,
+            py::arg("path"),
+            py::arg("exchange_id"),
+            py::arg("broker_id"),
+            py::arg("warmup") = 0
+    );
+
     // Define a function that returns the memory address of a MyClass instance
     m.def("mem_address", [](Asset &instance)
           { return reinterpret_cast<std::uintptr_t>(&instance); });
@@ -72,24 +197,107 @@ void init_exchange_ext(py::module &m)
              py::return_value_policy::reference
         )
         .def("get_exchange_feature", 
-            &Exchange::get_exchange_feature, 
+            static_cast<py::dict (Exchange::*)(const string&, int, ExchangeQueryType, optional<AssetTracerType>, int)>(
+                &Exchange::get_exchange_feature), 
+            py::arg("column_name"),
+            py::arg("row") = 0,
+            py::arg("query_type") = ExchangeQueryType::Default,
+            py::arg("query_scaler") = nullopt,
+            py::arg("N") = -1)
+        .def("get_exchange_feature", 
+            static_cast<py::dict (Exchange::*)(const FeatureHandle&, int, ExchangeQueryType, int)>(
+                &Exchange::get_exchange_feature), 
+            py::arg("handle"),
+            py::arg("row") = 0,
+            py::arg("query_type") = ExchangeQueryType::Default,
+            py::arg("N") = -1)
+        .def("get_exchange_feature_array", 
+            static_cast<py::tuple (Exchange::*)(const string&, int, ExchangeQueryType, optional<AssetTracerType>, int)>(
+                &Exchange::get_exchange_feature_array), 
             py::arg("column_name"),
             py::arg("row") = 0,
             py::arg("query_type") = ExchangeQueryType::Default,
             py::arg("query_scaler") = nullopt,
             py::arg("N") = -1)
+        .def("get_exchange_feature_array", 
+            static_cast<py::tuple (Exchange::*)(const FeatureHandle&, int, ExchangeQueryType, int)>(
+                &Exchange::get_exchange_feature_array), 
+            py::arg("handle"),
+            py::arg("row") = 0,
+            py::arg("query_type") = ExchangeQueryType::Default,
+            py::arg("N") = -1)
+        .def("get_slot_asset_ids", &Exchange::get_slot_asset_ids)
+        .def("get_expired_asset_ids", [](Exchange& self) {
+                vector<string> asset_ids;
+                if(auto expired_assets = self.get_expired_assets())
+                {
+                    for(auto const & asset : *expired_assets.value())
+                    {
+                        asset_ids.push_back(asset->get_asset_id());
+                    }
+                }
+                return asset_ids;
+            })
+        .def("get_open_order_count", &Exchange::get_open_order_count)
+        .def("set_asset_group", &Exchange::set_asset_group, py::arg("asset_id"), py::arg("group"))
+        .def("get_cross_section", 
+            static_cast<py::array_t<double> (Exchange::*)(const string&, CrossSectionTransform, int, optional<AssetTracerType>, double, double)>(
+                &Exchange::get_cross_section), 
+            py::arg("column_name"),
+            py::arg("transform"),
+            py::arg("row") = 0,
+            py::arg("query_scaler") = nullopt,
+            py::arg("lower") = 0.01,
+            py::arg("upper") = 0.99)
+        .def("get_cross_section", 
+            static_cast<py::array_t<double> (Exchange::*)(const FeatureHandle&, CrossSectionTransform, int, double, double)>(
+                &Exchange::get_cross_section), 
+            py::arg("handle"),
+            py::arg("transform"),
+            py::arg("row") = 0,
+            py::arg("lower") = 0.01,
+            py::arg("upper") = 0.99)
+        .def("get_feature_handle",
+            &Exchange::get_feature_handle,
+            py::arg("column_name"),
+            py::arg("query_scaler") = nullopt)
 
         .def("get_asset_feature", 
-            &Exchange::get_asset_feature, 
+            static_cast<optional<double> (Exchange::*)(const string&, const string&, int)>(
+                &Exchange::get_asset_feature), 
             py::arg("asset_id"),
             py::arg("column_name"),
             py::arg("index") = 0)
+        .def("get_asset_feature", 
+            static_cast<optional<double> (Exchange::*)(const string&, const FeatureHandle&, int)>(
+                &Exchange::get_asset_feature), 
+            py::arg("asset_id"),
+            py::arg("handle"),
+            py::arg("index") = 0)
 
         .def("get_datetime_index_view", &Exchange::get_datetime_index_view)
-        .def("add_tracer", &Exchange::add_tracer),
+
+        .def("enable_panel", &Exchange::enable_panel, py::arg("columns") = vector<string>{})
+        // panel views share the panel's value block so they can outlive the python references to it
+        .def("get_panel",               &Exchange::get_panel_view,
+            py::arg("column_name"))
+        .def("get_panel_row",           &Exchange::get_panel_row_view,
+            py::arg("column_name"),
+            py::arg("row") = 0)
+        .def("get_panel_valid", [](Exchange& self) {
+                return self.get_panel().get_valid_view();
+            })
+        .def("get_panel_asset_ids", [](Exchange& self) {
+                return self.get_panel().get_asset_ids();
+            })
+
+        .def("add_tracer",              &Exchange::add_tracer,
             py::arg("tracer_type"),
             py::arg("lookback"),
-            py::arg("adjust_warmup") = false;
+            py::arg("adjust_warmup") = false,
+            py::arg("column") = "",
+            py::arg("name") = "")
+        .def("set_lazy_tracers",        &Exchange::set_lazy_tracers, py::arg("lazy_tracers"));
 }
 
 void init_hydra_ext(py::module &m)
@@ -100,11 +308,22 @@ void init_hydra_ext(py::module &m)
                     void* ptr = self.void_ptr();
                     return py::capsule(ptr, "void*");
                 })
-        .def("build", &Hydra::build)
+        // building only reads python objects through stream sources, which take the gil themselves
+        .def("build", &Hydra::build, py::call_guard<py::gil_scoped_release>())
         .def("run", &Hydra::run,
             py::arg("steps") = 0,
             py::arg("to") = 0)
         .def("register_asset", &Hydra::register_asset)
+        .def("register_assets", &Hydra::register_assets,
+            py::arg("asset_ids"),
+            py::arg("exchange_id"),
+            py::arg("broker_id"),
+            py::arg("headers"),
+            py::arg("data"),
+            py::arg("datetime_indexes"),
+            py::arg("warmup") = 0,
+            py::arg("layout") = AssetLayout::RowMajor,
+            py::arg("precision") = AssetPrecision::Float64)
         .def("register_index_asset", &Hydra::register_index_asset,
             py::arg("asset"),
             py::arg("exchange_id") = "")
@@ -114,6 +333,8 @@ void init_hydra_ext(py::module &m)
             py::arg("clear_strategies") = false)
         .def("replay", &Hydra::replay)
         .def("goto_datetime", &Hydra::goto_datetime)
+        .def("set_threads", &Hydra::set_threads, py::arg("threads"))
+        .def("get_threads", &Hydra::get_threads)
 
         #ifdef ARGUS_STRIP
         .def("forward_pass", &Hydra::forward_pass)
@@ -132,6 +353,13 @@ void init_hydra_ext(py::module &m)
         .def("get_datetime_index_view", &Hydra::get_datetime_index_view)
         .def("get_order_history",       &Hydra::get_order_history)
         .def("get_candles",             &Hydra::get_candles)
+        .def("get_profile",             &Hydra::get_profile)
+        .def("reset_profile",           &Hydra::reset_profile)
+        .def("get_alloc_profile",       &Hydra::get_alloc_profile)
+        .def("reset_alloc_profile",     &Hydra::reset_alloc_profile)
+        .def("set_alloc_strict",        &Hydra::set_alloc_strict,
+            py::arg("strict"),
+            py::arg("warmup_steps") = 1)
         .def("get_broker",              &Hydra::get_broker)
         .def("get_master_portfolio",    &Hydra::get_master_portflio)
         .def("get_portfolio",           &Hydra::get_portfolio)
@@ -159,7 +387,7 @@ void init_portfolio_ext(py::module &m)
     py::class_<Portfolio, std::shared_ptr<Portfolio>>(m, "Portfolio")
         .def("get_mem_address", &Portfolio::get_mem_address)
         .def("get_portfolio_id", &Portfolio::get_portfolio_id)
-        .def("get_position", &Portfolio::get_position)
+        .def("get_position", static_cast<std::optional<Portfolio::position_sp_t> (Portfolio::*)(const string&)>(&Portfolio::get_position))
         .def("get_portfolio_history", &Portfolio::get_portfolio_history)
 
         .def("add_tracer", &Portfolio::add_tracer, py::return_value_policy::reference)
@@ -177,6 +405,27 @@ void init_portfolio_ext(py::module &m)
             py::arg("strategy_id"),
             py::arg("order_execution_type") = OrderExecutionType::LAZY,
             py::arg("trade_id") = -1)
+        .def("place_limit_order", &Portfolio::place_limit_order,
+            py::arg("asset_id"),
+            py::arg("units"),
+            py::arg("limit"),
+            py::arg("strategy_id"),
+            py::arg("order_execution_type") = OrderExecutionType::LAZY,
+            py::arg("trade_id") = -1)
+        .def("place_stop_loss_order", &Portfolio::place_stop_loss_order,
+            py::arg("asset_id"),
+            py::arg("units"),
+            py::arg("limit"),
+            py::arg("strategy_id"),
+            py::arg("order_execution_type") = OrderExecutionType::LAZY,
+            py::arg("trade_id") = -1)
+        .def("place_take_profit_order", &Portfolio::place_take_profit_order,
+            py::arg("asset_id"),
+            py::arg("units"),
+            py::arg("limit"),
+            py::arg("strategy_id"),
+            py::arg("order_execution_type") = OrderExecutionType::LAZY,
+            py::arg("trade_id") = -1)
         .def("order_target_allocations",&Portfolio::order_target_allocations,
             py::arg("allocations"),
             py::arg("strategy_id"),
@@ -236,7 +485,9 @@ void init_position_ext(py::module &m)
 
 void init_broker_ext(py::module &m)
 {
-    py::class_<Broker, std::shared_ptr<Broker>>(m, "Broker");
+    py::class_<Broker, std::shared_ptr<Broker>>(m, "Broker")
+        .def("get_open_orders", &Broker::get_open_orders)
+        .def("cancel_order", &Broker::cancel_order, py::arg("order_id"));
 
     py::class_<Order, std::shared_ptr<Order>>(m, "Order")
         .def("get_order_type", &Order::get_order_type)
@@ -291,9 +542,25 @@ void init_enum(py::module &m){
         .value("EVENT", PortfolioTracerType::Event)
         .export_values();
 
+    py::enum_<AssetLayout>(m, "AssetLayout")
+        .value("ROW_MAJOR",     AssetLayout::RowMajor)
+        .value("COLUMN_MAJOR",  AssetLayout::ColumnMajor)
+        .export_values();
+
+    py::enum_<AssetPrecision>(m, "AssetPrecision")
+        .value("FLOAT64",       AssetPrecision::Float64)
+        .value("FLOAT32",       AssetPrecision::Float32)
+        .export_values();
+
     py::enum_<AssetTracerType>(m, "AssetTracerType")
         .value("VOLATILITY",    AssetTracerType::Volatility)
         .value("BETA",          AssetTracerType::Beta)
+        .value("SMA",           AssetTracerType::MovingAverage)
+        .value("EMA",           AssetTracerType::ExponentialMovingAverage)
+        .value("ROLLING_MIN",   AssetTracerType::RollingMin)
+        .value("ROLLING_MAX",   AssetTracerType::RollingMax)
+        .value("ROLLING_ZSCORE",AssetTracerType::RollingZScore)
+        .value("ATR",           AssetTracerType::AverageTrueRange)
         .export_values();
 
     py::enum_<ExchangeQueryType>(m, "ExchangeQueryType")
@@ -302,6 +569,56 @@ void init_enum(py::module &m){
         .value("NSMALLEST", ExchangeQueryType::NSmallest)
         .value("NEXTREME",  ExchangeQueryType::NExtreme)
         .export_values();     
+
+    py::enum_<CrossSectionTransform>(m, "CrossSectionTransform")
+        .value("RANK",          CrossSectionTransform::Rank)
+        .value("PERCENTILE",    CrossSectionTransform::Percentile)
+        .value("ZSCORE",        CrossSectionTransform::ZScore)
+        .value("WINSORIZE",     CrossSectionTransform::Winsorize)
+        .value("GROUP_DEMEAN",  CrossSectionTransform::GroupDemean)
+        .export_values();
+}
+
+void init_runner_ext(py::module &m)
+{
+    m.def("load_asset_csv", &load_asset_csv,
+            py::arg("path"),
+            py::arg("asset_id"),
+            py::arg("exchange_id"),
+            py::arg("broker_id"),
+            py::arg("warmup") = 0,
+            py::arg("layout") = AssetLayout::RowMajor,
+            py::arg("precision") = AssetPrecision::Float64
+    );
+    m.def("string_to_nanosecond_epoch_time", &string_to_nanosecond_epoch_time, py::arg("datetime"));
+
+    py::class_<RunSection>(m, "RunSection")
+        .def_readonly("type",   &RunSection::type)
+        .def_readonly("id",     &RunSection::id)
+        .def_readonly("line",   &RunSection::line)
+        .def_readonly("values", &RunSection::values)
+        .def("get_size",        &RunSection::get_size, py::arg("key"), py::arg("default_value"))
+        .def("get_double",      &RunSection::get_double, py::arg("key"), py::arg("default_value"))
+        .def("get_bool",        &RunSection::get_bool, py::arg("key"), py::arg("default_value"))
+        .def("get_list",        &RunSection::get_list, py::arg("key"));
+
+    py::class_<RunDescription>(m, "RunDescription")
+        .def_static("parse", [](const string& text, const string& base_directory) {
+                std::istringstream stream(text);
+                return RunDescription::parse(stream, base_directory);
+            },
+            py::arg("text"),
+            py::arg("base_directory") = ".")
+        .def_static("parse_file", &RunDescription::parse_file, py::arg("path"))
+        .def_readonly("sections", &RunDescription::sections)
+        .def("resolve_path", &RunDescription::resolve_path, py::arg("path"));
+
+    py::class_<Runner>(m, "Runner")
+        .def(py::init<RunDescription>(), py::arg("description"))
+        .def("build", &Runner::build)
+        .def("run", &Runner::run)
+        .def("write_output", &Runner::write_output, py::arg("directory") = "")
+        .def("get_hydra", &Runner::get_hydra);
 }
 
 PYBIND11_MODULE(FastTest, m)
@@ -334,4 +651,7 @@ PYBIND11_MODULE(FastTest, m)
 
     // build python position class bindings
     init_position_ext(m);
+
+    // build python headless runner bindings
+    init_runner_ext(m);
 }
\ No newline at end of file
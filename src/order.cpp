@@ -34,18 +34,18 @@ OrderConsolidated::OrderConsolidated(vector<shared_ptr<Order>> orders, Portfolio
 
     //get the first asset id (all must match)
     auto order = orders[0];
-    auto asset_id_ = order->get_asset_id();
-    auto broker_id_ = order->get_broker_id();
+    auto asset_symbol_ = order->get_asset_symbol();
+    auto broker_symbol_ = order->get_broker_symbol();
 
     for(auto const &order : orders){
         units_ += order->get_units();
 
         #ifdef ARGUS_RUNTIME_ASSERT
         //orders must have same asset id
-        assert(order->get_asset_id() == asset_id_);
+        assert(order->get_asset_symbol() == asset_symbol_);
 
         //orders must have same broker id
-        assert(order->get_broker_id() == broker_id_);
+        assert(order->get_broker_symbol() == broker_symbol_);
         
         //orders must be market orders
         assert(order->get_order_type() == MARKET_ORDER);
@@ -53,12 +53,12 @@ OrderConsolidated::OrderConsolidated(vector<shared_ptr<Order>> orders, Portfolio
     }
     
     this->parent_order = make_shared<Order>(MARKET_ORDER,
-            asset_id_,
+            asset_symbol_,
             units_,
-            order->get_exchange_id(),
-            broker_id_,
+            order->get_exchange_symbol(),
+            broker_symbol_,
             source_portfolio,
-            "master",
+            intern_symbol(SymbolType::Strategy, "master"),
             0);
 
     this->child_orders = std::move(orders);
@@ -78,19 +78,33 @@ void OrderConsolidated::fill_child_orders(){
     }
 }
 
-Order::Order(OrderType order_type_, string asset_id_, double units_, string exchange_id_,
-             string broker_id_, Portfolio* source_portfolio, string strategy_id_, int trade_id_)
+Order::Order(OrderType order_type_, const string& asset_id_, double units_, const string& exchange_id_,
+             const string& broker_id_, Portfolio* source_portfolio, const string& strategy_id_, int trade_id_) :
+    Order(
+        order_type_,
+        intern_symbol(SymbolType::Asset, asset_id_),
+        units_,
+        intern_symbol(SymbolType::Exchange, exchange_id_),
+        intern_symbol(SymbolType::Broker, broker_id_),
+        source_portfolio,
+        intern_symbol(SymbolType::Strategy, strategy_id_),
+        trade_id_)
+{
+}
+
+Order::Order(OrderType order_type_, symbol_t asset_symbol_, double units_, symbol_t exchange_symbol_,
+             symbol_t broker_symbol_, Portfolio* source_portfolio, symbol_t strategy_symbol_, int trade_id_)
 {
     this->order_type = order_type_;
     this->units = units_;
     this->average_price = 0.0;
     this->order_fill_time = 0;
 
-    // populate the ids of the order
-    this->asset_id = asset_id_;
-    this->exchange_id = exchange_id_;
-    this->broker_id = broker_id_;
-    this->strategy_id = strategy_id_;
+    // populate the symbols of the order
+    this->asset_symbol = asset_symbol_;
+    this->exchange_symbol = exchange_symbol_;
+    this->broker_symbol = broker_symbol_;
+    this->strategy_symbol = strategy_symbol_;
 
     // verify we have a valid source portfolio
     assert(source_portfolio);    
@@ -0,0 +1,199 @@
+//
+// exchange wide panel of asset values packed against the exchange datetime index
+//
+#include "pch.h"
+#include <cmath>
+#include <limits>
+
+#include "panel.h"
+#include "settings.h"
+#include "utils_array.h"
+
+using namespace std;
+
+py::object ExchangePanel::values_owner() const
+{
+    return py::capsule(new shared_ptr<double>(this->values), [](void* ptr)
+    {
+        delete static_cast<shared_ptr<double>*>(ptr);
+    });
+}
+
+void ExchangePanel::build(
+    const vector<Asset*>& assets,
+    long long const * datetime_index,
+    size_t times_,
+    vector<string> columns_)
+{
+    if(assets.empty())
+    {
+        throw runtime_error("no assets to build the panel from");
+    }
+
+    // default to the columns every asset has, in the order of the first asset
+    if(columns_.empty())
+    {
+        for(auto const & column : assets.front()->get_headers())
+        {
+            bool shared = std::all_of(assets.begin(), assets.end(), [&](Asset* asset)
+            {
+                return asset->get_column_index(column).has_value();
+            });
+            if(shared)
+            {
+                columns_.push_back(column);
+            }
+        }
+    }
+
+    // resolve the column index of each packed column in each asset, streaming assets only hold a
+    // window of their rows and can not be packed
+    vector<vector<size_t>> asset_columns(assets.size());
+    for(size_t slot = 0; slot < assets.size(); slot++)
+    {
+        if(assets[slot]->get_is_streaming())
+        {
+            ARGUS_RUNTIME_ERROR(ArgusErrorCode::NotImplemented);
+        }
+        for(auto const & column : columns_)
+        {
+            auto column_index = assets[slot]->get_column_index(column);
+            if(!column_index.has_value())
+            {
+                ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidDataRequest);
+            }
+            asset_columns[slot].push_back(column_index.value());
+        }
+    }
+
+    this->columns = std::move(columns_);
+    this->column_indices.clear();
+    for(size_t j = 0; j < this->columns.size(); j++)
+    {
+        this->column_indices.emplace(this->columns[j], j);
+    }
+    this->asset_ids.clear();
+    for(auto asset : assets)
+    {
+        this->asset_ids.push_back(asset->get_asset_id());
+    }
+
+    // pad rows to a cache line so every cross section starts on an aligned boundary
+    size_t constexpr doubles_per_line = ASSET_DATA_ALIGNMENT / sizeof(double);
+    this->times = times_;
+    this->asset_stride = (assets.size() + doubles_per_line - 1) / doubles_per_line * doubles_per_line;
+    this->valid_words = (assets.size() + 63) / 64;
+    this->valid.assign(this->times * this->valid_words, 0);
+
+    // views hold on to the block, a block of the same shape is refilled in place so they stay valid
+    auto size = std::max<size_t>(this->columns.size() * this->times * this->asset_stride, 1);
+    if(!this->values || size != this->values_size)
+    {
+        this->values = shared_ptr<double>(
+            static_cast<double*>(::operator new[](size * sizeof(double), std::align_val_t{ASSET_DATA_ALIGNMENT})),
+            [](double* ptr) { ::operator delete[](ptr, std::align_val_t{ASSET_DATA_ALIGNMENT}); });
+        this->values_size = size;
+    }
+    std::fill(this->values.get(), this->values.get() + size, std::numeric_limits<double>::quiet_NaN());
+
+    // merge each asset's datetime index (from the warmup on) into the panel's
+    for(size_t slot = 0; slot < assets.size(); slot++)
+    {
+        auto asset = assets[slot];
+        auto asset_index = asset->get_datetime_index();
+        auto row_stride = asset->get_row_stride();
+        auto col_stride = asset->get_col_stride();
+        auto f64 = asset->get_data();
+        auto f32 = asset->get_data_f32();
+
+        size_t time = 0;
+        for(size_t i = asset->get_warmup(); i < asset->get_rows(); i++)
+        {
+            while(time < this->times && datetime_index[time] < asset_index[i])
+            {
+                time++;
+            }
+            if(time == this->times || datetime_index[time] != asset_index[i])
+            {
+                ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidArrayValues);
+            }
+
+            this->valid[time * this->valid_words + slot / 64] |= uint64_t{1} << (slot % 64);
+            for(size_t j = 0; j < this->columns.size(); j++)
+            {
+                auto offset = i * row_stride + asset_columns[slot][j] * col_stride;
+                this->values.get()[(j * this->times + time) * this->asset_stride + slot] = f64 ? f64[offset] : f32[offset];
+            }
+        }
+    }
+}
+
+optional<size_t> ExchangePanel::get_column_index(const string& column) const
+{
+    auto it = this->column_indices.find(column);
+    if(it == this->column_indices.end())
+    {
+        return nullopt;
+    }
+    return it->second;
+}
+
+size_t ExchangePanel::require_column(const string& column) const
+{
+    if(!this->get_is_built())
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::NotBuilt);
+    }
+    auto column_index = this->get_column_index(column);
+    if(!column_index.has_value())
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidDataRequest);
+    }
+    return column_index.value();
+}
+
+py::array_t<double> ExchangePanel::get_column_view(const string& column) const
+{
+    auto column_index = this->require_column(column);
+    return to_py_array_strided(
+        this->get_row(column_index, 0),
+        {static_cast<py::ssize_t>(this->times), static_cast<py::ssize_t>(this->asset_ids.size())},
+        {static_cast<py::ssize_t>(this->asset_stride), 1},
+        true,
+        this->values_owner()
+    );
+}
+
+py::array_t<double> ExchangePanel::get_row_view(const string& column, size_t time) const
+{
+    auto column_index = this->require_column(column);
+    if(time >= this->times)
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::IndexOutOfBounds);
+    }
+    return to_py_array(
+        this->get_row(column_index, time),
+        static_cast<long>(this->asset_ids.size()),
+        true,
+        this->values_owner()
+    );
+}
+
+py::array_t<bool> ExchangePanel::get_valid_view() const
+{
+    if(!this->get_is_built())
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::NotBuilt);
+    }
+    auto assets = this->asset_ids.size();
+    py::array_t<bool> mask({static_cast<py::ssize_t>(this->times), static_cast<py::ssize_t>(assets)});
+    auto mask_ptr = mask.mutable_data();
+    for(size_t time = 0; time < this->times; time++)
+    {
+        for(size_t slot = 0; slot < assets; slot++)
+        {
+            mask_ptr[time * assets + slot] = this->is_valid(time, slot);
+        }
+    }
+    return mask;
+}
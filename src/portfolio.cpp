@@ -78,9 +78,24 @@ void Portfolio::reset(bool clear_history)
     }
 }
 
+bool Portfolio::position_exists(const string &asset_id) const
+{
+    auto asset_symbol = SymbolTable::get(SymbolType::Asset).find(asset_id);
+    return asset_symbol.has_value() && this->position_exists(asset_symbol.value());
+}
+
 std::optional<position_sp_t> Portfolio::get_position(const string &asset_id)
 {
-    auto position = this->positions_map.find(asset_id);
+    auto asset_symbol = SymbolTable::get(SymbolType::Asset).find(asset_id);
+    if(!asset_symbol.has_value()){
+        return nullopt;
+    }
+    return this->get_position(asset_symbol.value());
+}
+
+std::optional<position_sp_t> Portfolio::get_position(symbol_t asset_symbol)
+{
+    auto position = this->positions_map.find(asset_symbol);
     if(position == this->positions_map.end()){
         return nullopt;
     }
@@ -100,10 +115,11 @@ void Portfolio::order_target_allocations(py::dict allocations,
     {
         for(auto& position_pair : this->positions_map)
         {
-            if(!allocations.contains(position_pair.first))
+            auto const & asset_id = position_pair.second->get_asset_id();
+            if(!allocations.contains(asset_id))
             {
                 std::vector<order_sp_t> orders;
-                auto orders_nullopt = this->generate_order_inverse(position_pair.first, true, false);
+                auto orders_nullopt = this->generate_order_inverse(asset_id, true, false);
             }
         }
     }
@@ -207,7 +223,7 @@ void Portfolio::place_market_order(const string &asset_id_, double units_,
         this->event_tracer->remember_order(market_order);
     }
     
-    auto broker = this->brokers->at(asset_rp->broker_id);
+    auto broker = this->brokers->get_broker(asset_rp->broker_symbol);
 
     #ifdef ARGUS_STRIP
     if(this->logging){
@@ -231,39 +247,68 @@ void Portfolio::place_limit_order(const string &asset_id_, double units_, double
                                const string &strategy_id_,
                                OrderExecutionType order_execution_type,
                                int trade_id)
+{
+    this->place_resting_order(LIMIT_ORDER, asset_id_, units_, limit_, strategy_id_, order_execution_type, trade_id);
+}
+
+void Portfolio::place_stop_loss_order(const string &asset_id_, double units_, double limit_,
+                               const string &strategy_id_,
+                               OrderExecutionType order_execution_type,
+                               int trade_id)
+{
+    this->place_resting_order(STOP_LOSS_ORDER, asset_id_, units_, limit_, strategy_id_, order_execution_type, trade_id);
+}
+
+void Portfolio::place_take_profit_order(const string &asset_id_, double units_, double limit_,
+                               const string &strategy_id_,
+                               OrderExecutionType order_execution_type,
+                               int trade_id)
+{
+    this->place_resting_order(TAKE_PROFIT_ORDER, asset_id_, units_, limit_, strategy_id_, order_execution_type, trade_id);
+}
+
+void Portfolio::place_resting_order(OrderType order_type, const string &asset_id_, double units_, double limit_,
+                               const string &strategy_id_,
+                               OrderExecutionType order_execution_type,
+                               int trade_id)
 {       
+    // a zero unit order never crosses its limit, it would stay open on the exchange
+    if(units_ == 0)
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidDataRequest);
+    }
 
     auto asset_rp = this->exchange_map->asset_map.at(asset_id_);
 
     // build new smart pointer to shared order
-    auto limit_order = make_shared<Order>(LIMIT_ORDER,
-                                          asset_id_,
-                                          units_,
-                                          asset_rp->exchange_id,
-                                          asset_rp->broker_id,
-                                          this,
-                                          strategy_id_,
-                                          trade_id);
+    auto order = make_shared<Order>(order_type,
+                                    asset_id_,
+                                    units_,
+                                    asset_rp->exchange_id,
+                                    asset_rp->broker_id,
+                                    this,
+                                    strategy_id_,
+                                    trade_id);
 
     if(this->event_tracer)
     {
-        this->event_tracer->remember_order(limit_order);
+        this->event_tracer->remember_order(order);
     }
 
     // set the limit of the order
-    limit_order->set_limit(limit_);
+    order->set_limit(limit_);
 
-    auto broker = this->brokers->at(asset_rp->broker_id);
+    auto broker = this->brokers->get_broker(asset_rp->broker_symbol);
 
     if (order_execution_type == EAGER)
     {
         // place order directly and process
-        broker->place_order(limit_order);
+        broker->place_order(order);
     }
     else
     {
         // push the order to the buffer that will be processed when the buffer is flushed
-        broker->place_order_buffer(limit_order);
+        broker->place_order_buffer(order);
     }
 }
 
@@ -279,7 +324,7 @@ void Portfolio::py_close_position(const string& asset_id)
     {
         for(auto& position_pair : this->positions_map)
         {
-            auto orders_nullopt = this->generate_order_inverse(position_pair.first, false, true);
+            auto orders_nullopt = this->generate_order_inverse(position_pair.second->get_asset_id(), false, true);
         }
     }
 }
@@ -295,18 +340,18 @@ void Portfolio::on_order_fill(order_sp_t filled_order)
     #endif
 
     // no position exists in the portfolio with the filled order's asset_id
-    if (!this->position_exists(filled_order->get_asset_id()))
+    if (!this->position_exists(filled_order->get_asset_symbol()))
     {   
         this->open_position(filled_order, true);
         
         // set the trade's source portfolio
-        auto position_sp = this->positions_map.at(filled_order->get_asset_id());
+        auto position_sp = this->positions_map.at(filled_order->get_asset_symbol());
         auto trade_sp = position_sp->get_trades().begin()->second;
         trade_sp->set_source_position(position_sp.get());
     }
     else
     {
-        auto position = this->get_position(filled_order->get_asset_id()).value();
+        auto position = this->get_position(filled_order->get_asset_symbol()).value();
         auto position_units = position->get_units();
         auto order_units = filled_order->get_units();
 
@@ -344,16 +389,16 @@ void Portfolio::on_order_fill(order_sp_t filled_order)
     // place child orders from the filled order
     for (auto &child_order : filled_order->get_child_orders())
     {
-        auto broker = this->brokers->find(child_order->get_broker_id());
-        broker->second->place_order(child_order);
+        auto broker = this->brokers->get_broker(child_order->get_broker_symbol());
+        broker->place_order(child_order);
     }
 };
 
 void Portfolio::modify_position(shared_ptr<Order> filled_order)
 {
     // get the position and account to modify
-    auto asset_id = filled_order->get_asset_id();
-    auto position = this->get_position(asset_id).value();
+    auto asset_symbol = filled_order->get_asset_symbol();
+    auto position = this->get_position(asset_symbol).value();
 
     // adjust position and close out trade if needed
     auto trade = position->adjust_order(filled_order, this);
@@ -379,11 +424,11 @@ void Portfolio::modify_position(shared_ptr<Order> filled_order)
             source_portfolio->propogate_trade_close_up(trade, true);
 
             // propogate_trade_close_up does not adjust the source, need to adjust the source portfolio
-            auto source_position = source_portfolio->get_position(trade->get_asset_id()).value();
+            auto source_position = source_portfolio->get_position(trade->get_asset_symbol()).value();
             source_position->adjust_trade(trade);
             if(!source_position->is_open)
             {
-                source_portfolio->positions_map.erase(trade->get_asset_id());
+                source_portfolio->positions_map.erase(trade->get_asset_symbol());
                 if(source_portfolio->event_tracer){source_portfolio->event_tracer->remember_position(position);}
             }
         }
@@ -418,8 +463,8 @@ void Portfolio::modify_position(shared_ptr<Order> filled_order)
 void Portfolio::close_position(shared_ptr<Order> filled_order)
 {
     // get the position to close and close it 
-    auto asset_id = filled_order->get_asset_id();
-    auto position = this->get_position(asset_id).value();
+    auto asset_symbol = filled_order->get_asset_symbol();
+    auto position = this->get_position(asset_symbol).value();
 
     #ifdef ARGUS_RUNTIME_ASSERT
     assert(abs(position->get_units() + filled_order->get_units()) < 1e-7);
@@ -462,11 +507,11 @@ void Portfolio::close_position(shared_ptr<Order> filled_order)
             source_portfolio->propogate_trade_close_up(trade, true);
 
             // propogate_trade_close_up does not adjust the source, need to adjust the source portfolio
-            auto source_position = source_portfolio->get_position(trade->get_asset_id()).value();
+            auto source_position = source_portfolio->get_position(trade->get_asset_symbol()).value();
             source_position->adjust_trade(trade);
             if(!source_position->is_open)
             {
-                source_portfolio->positions_map.erase(trade->get_asset_id());
+                source_portfolio->positions_map.erase(trade->get_asset_symbol());
                 if(source_portfolio->event_tracer){source_portfolio->event_tracer->remember_position(position);}
             }
         }
@@ -494,7 +539,7 @@ void Portfolio::close_position(shared_ptr<Order> filled_order)
     position->get_trades().clear();
 
     // remove the position from portfolio
-    this->positions_map.erase(asset_id);
+    this->positions_map.erase(asset_symbol);
 
     // push position to history
     position->set_is_open(false);
@@ -511,12 +556,12 @@ void Portfolio::propogate_trade_close_up(trade_sp_t trade_sp, bool adjust_cash){
     auto parent = this->parent_portfolio;
     
     #ifdef ARGUS_RUNTIME_ASSERT
-    auto parent_position = parent->get_position(trade_sp->get_asset_id());
+    auto parent_position = parent->get_position(trade_sp->get_asset_symbol());
     assert(parent_position.has_value());
     #endif
     
     //get the parent position
-    auto position = parent->get_position(trade_sp->get_asset_id()).value();
+    auto position = parent->get_position(trade_sp->get_asset_symbol()).value();
     position->adjust_trade(trade_sp);
 
     //adjust parent portfolio cash
@@ -536,7 +581,7 @@ void Portfolio::propogate_trade_close_up(trade_sp_t trade_sp, bool adjust_cash){
         #endif
 
         // remove position from parent portfolio if there are no more trades
-        parent->positions_map.erase(trade_sp->get_asset_id());
+        parent->positions_map.erase(trade_sp->get_asset_symbol());
 
         // remember the postiion of the parent
         if(this->event_tracer)
@@ -561,14 +606,14 @@ void Portfolio::propogate_trade_open_up(trade_sp_t trade_sp, bool adjust_cash){
     auto parent = this->parent_portfolio;
     
     //position does not exist in portfolio
-    if(!parent->position_exists(trade_sp->get_asset_id()))
+    if(!parent->position_exists(trade_sp->get_asset_symbol()))
     {
             parent->open_position(trade_sp, adjust_cash);
     }
     //position already exists, add the new trade
     else
     {
-        auto position = *parent->get_position(trade_sp->get_asset_id());
+        auto position = *parent->get_position(trade_sp->get_asset_symbol());
         //insert the trade into the position
         position->adjust_trade(trade_sp);
 
@@ -604,7 +649,7 @@ shared_ptr<Portfolio> Portfolio::create_sub_portfolio(const string& portfolio_id
         );
     
     //insert into child portfolio map
-    this->portfolio_map.insert({portfolio_id, portfolio_});
+    this->portfolio_map.insert({portfolio_id_, portfolio_});
 
     //update parent portfolio's values
     this->add_cash(portfolio_->get_cash());
@@ -620,7 +665,7 @@ void Portfolio::add_sub_portfolio(const string &portfolio_id_, portfolio_sp_t po
     {
         ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidId);
     }
-    this->portfolio_map.insert({portfolio_id, portfolio_});
+    this->portfolio_map.insert({portfolio_id_, portfolio_});
 
     //make sure the parent portfolio of the passed portfolio is equal to this
     assert(this == portfolio_->get_parent_portfolio());
@@ -672,7 +717,7 @@ double Portfolio::calculate_beta(bool on_close)
     for(auto& position_pair : this->positions_map)
     {
         auto position = position_pair.second;
-        auto asset = this->exchange_map->get_asset(position->get_asset_id()).value();
+        auto asset = this->exchange_map->get_asset(position_pair.first);
         auto market_price = asset->get_market_price(on_close);
         beta_dollars += asset->get_beta() * position->get_units() * market_price;
     }
@@ -694,7 +739,7 @@ void Portfolio::evaluate(bool on_close)
     for(auto it = this->positions_map.begin(); it != positions_map.end(); ++it) 
     {
         auto position = it->second;
-        auto asset = this->exchange_map->get_asset(it->first).value();
+        auto asset = this->exchange_map->get_asset(it->first);
         auto market_price = asset->get_market_price(on_close);
 
         // asset is not in market view
@@ -758,7 +803,7 @@ void Portfolio::position_cancel_order(Broker::position_sp_t position_sp)
         // cancel orders whose parent is the closed trade
         for (auto &order : trade->get_open_orders())
         {
-            auto broker = this->brokers->at(order->get_broker_id());
+            auto broker = this->brokers->get_broker(order->get_broker_symbol());
             broker->cancel_order(order->get_order_id());
         }
     }
@@ -786,8 +831,7 @@ optional<vector<order_sp_t>> Portfolio::generate_order_inverse(
         auto orders_consolidated = OrderConsolidated(orders, this);
 
         //send order to broker
-        auto broker_id = orders[0]->get_broker_id();
-        auto broker = this->brokers->at(broker_id);
+        auto broker = this->brokers->get_broker(orders[0]->get_broker_symbol());
         auto parent_order = orders_consolidated.get_parent_order();
 
         broker->place_order(parent_order, false);
@@ -808,8 +852,7 @@ optional<vector<order_sp_t>> Portfolio::generate_order_inverse(
     }
     else if (send_orders){
         for(auto& order : orders){
-            auto broker_id = order->get_broker_id();
-            auto broker = this->brokers->at(broker_id);
+            auto broker = this->brokers->get_broker(order->get_broker_symbol());
             broker->place_order(order);
 
             //make sure the order was filled
@@ -831,7 +874,7 @@ void Portfolio::trade_cancel_order(Broker::trade_sp_t &trade_sp)
     for (auto &order : trade_sp->get_open_orders())
     {   
         // get corresponding broker for the order then cancel it
-        auto broker = this->brokers->at(order->get_broker_id());
+        auto broker = this->brokers->get_broker(order->get_broker_symbol());
         broker->cancel_order(order->get_order_id());
     }
 }
@@ -849,7 +892,7 @@ shared_ptr<Portfolio> Portfolio::find_portfolio(const string &portfolio_id_){
             return found;
         }
     }
-    ARGUS_RUNTIME_ERROR(ArgusErrorCode::InvalidId);
+    return nullptr;
 };
 
 void Portfolio::add_cash(double cash_)
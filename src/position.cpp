@@ -18,8 +18,8 @@ Position::Position(trade_sp_t trade){
     //populate common position values
     this->position_id = this->positition_counter;
     this->positition_counter++;
-    this->asset_id = trade->get_asset_id();
-    this->exchange_id = trade->get_exchange_id();
+    this->asset_symbol = trade->get_asset_symbol();
+    this->exchange_symbol = trade->get_exchange_symbol();
     this->units = trade->get_units();
 
     // populate order values
@@ -41,8 +41,8 @@ Position::Position(shared_ptr<Order> filled_order_)
     //populate common position values
     this->position_id = this->positition_counter;
     this->positition_counter++;
-    this->asset_id = filled_order_->get_asset_id();
-    this->exchange_id = filled_order_->get_exchange_id();
+    this->asset_symbol = filled_order_->get_asset_symbol();
+    this->exchange_symbol = filled_order_->get_exchange_symbol();
     this->units = filled_order_->get_units();
     this->is_open = true;
 
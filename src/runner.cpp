@@ -0,0 +1,761 @@
+//
+// headless backtest runner, builds and runs a hydra from a run description file
+//
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include "pch.h"
+#include <fmt/core.h>
+
+#include "asset.h"
+#include "asset_file.h"
+#include "exchange.h"
+#include "hydra.h"
+#include "order.h"
+#include "portfolio.h"
+#include "position.h"
+#include "runner.h"
+#include "settings.h"
+#include "trade.h"
+#include "utils_time.h"
+
+using namespace std;
+namespace fs = std::filesystem;
+
+using asset_sp_t = Asset::asset_sp_t;
+
+static string trim(const string& str)
+{
+    auto start = str.find_first_not_of(" \t\r\n");
+    if(start == string::npos)
+    {
+        return "";
+    }
+    auto end = str.find_last_not_of(" \t\r\n");
+    return str.substr(start, end - start + 1);
+}
+
+static vector<string> split(const string& str, char delim)
+{
+    vector<string> items;
+    std::stringstream stream(str);
+    string item;
+    while(std::getline(stream, item, delim))
+    {
+        items.push_back(trim(item));
+    }
+    return items;
+}
+
+static string to_lower(string str)
+{
+    std::transform(str.begin(), str.end(), str.begin(),
+        [](unsigned char c){ return std::tolower(c); });
+    return str;
+}
+
+/// parse a base 10 unsigned integer, the whole string must be digits
+static bool parse_size(const string& str, size_t& value)
+{
+    if(str.empty() || !std::isdigit(static_cast<unsigned char>(str.front())))
+    {
+        return false;
+    }
+    char* end;
+    errno = 0;
+    value = std::strtoull(str.c_str(), &end, 10);
+    return *end == '\0' && errno != ERANGE;
+}
+
+static runtime_error section_error(const RunSection& section, const string& msg)
+{
+    return runtime_error(fmt::format("run description line {} [{} {}]: {}",
+        section.line, section.type, section.id, msg));
+}
+
+//============================================================================
+const string& RunSection::get(const string& key) const
+{
+    auto it = this->values.find(key);
+    if(it == this->values.end())
+    {
+        throw section_error(*this, fmt::format("missing required key \"{}\"", key));
+    }
+    return it->second;
+}
+
+string RunSection::get(const string& key, const string& default_value) const
+{
+    auto it = this->values.find(key);
+    return it == this->values.end() ? default_value : it->second;
+}
+
+double RunSection::get_double(const string& key, double default_value) const
+{
+    auto it = this->values.find(key);
+    if(it == this->values.end())
+    {
+        return default_value;
+    }
+    char* end;
+    auto value = std::strtod(it->second.c_str(), &end);
+    if(end == it->second.c_str() || *end != '\0')
+    {
+        throw section_error(*this, fmt::format("invalid number for \"{}\": {}", key, it->second));
+    }
+    return value;
+}
+
+size_t RunSection::get_size(const string& key, size_t default_value) const
+{
+    auto it = this->values.find(key);
+    if(it == this->values.end())
+    {
+        return default_value;
+    }
+    size_t value;
+    if(!parse_size(it->second, value))
+    {
+        throw section_error(*this, fmt::format("invalid integer for \"{}\": {}", key, it->second));
+    }
+    return value;
+}
+
+bool RunSection::get_bool(const string& key, bool default_value) const
+{
+    auto it = this->values.find(key);
+    if(it == this->values.end())
+    {
+        return default_value;
+    }
+    auto value = to_lower(it->second);
+    if(value == "true" || value == "1" || value == "yes")
+    {
+        return true;
+    }
+    if(value == "false" || value == "0" || value == "no")
+    {
+        return false;
+    }
+    throw section_error(*this, fmt::format("invalid boolean for \"{}\": {}", key, it->second));
+}
+
+vector<string> RunSection::get_list(const string& key) const
+{
+    auto it = this->values.find(key);
+    if(it == this->values.end() || it->second.empty())
+    {
+        return {};
+    }
+    return split(it->second, ',');
+}
+
+//============================================================================
+RunDescription RunDescription::parse(std::istream& stream, const string& base_directory_)
+{
+    RunDescription description;
+    description.base_directory = base_directory_;
+
+    string line;
+    size_t line_number = 0;
+    while(std::getline(stream, line))
+    {
+        line_number++;
+
+        // strip comments and whitespace
+        auto comment = line.find_first_of("#;");
+        if(comment != string::npos)
+        {
+            line = line.substr(0, comment);
+        }
+        line = trim(line);
+        if(line.empty())
+        {
+            continue;
+        }
+
+        // new section header
+        if(line.front() == '[')
+        {
+            if(line.back() != ']')
+            {
+                throw runtime_error(fmt::format("run description line {}: unterminated section header", line_number));
+            }
+            auto header = trim(line.substr(1, line.size() - 2));
+            auto space = header.find_first_of(" \t");
+
+            RunSection section;
+            section.line = line_number;
+            section.type = to_lower(header.substr(0, space));
+            section.id = space == string::npos ? "" : trim(header.substr(space));
+            description.sections.push_back(std::move(section));
+            continue;
+        }
+
+        // key value pair in the current section
+        auto equals = line.find('=');
+        if(equals == string::npos)
+        {
+            throw runtime_error(fmt::format("run description line {}: expected key = value", line_number));
+        }
+        if(description.sections.empty())
+        {
+            throw runtime_error(fmt::format("run description line {}: key outside of a section", line_number));
+        }
+        auto key = to_lower(trim(line.substr(0, equals)));
+        auto value = trim(line.substr(equals + 1));
+        description.sections.back().values[key] = value;
+    }
+    return description;
+}
+
+RunDescription RunDescription::parse_file(const string& path)
+{
+    std::ifstream file(path);
+    if(!file.is_open())
+    {
+        throw runtime_error("failed to open run description: " + path);
+    }
+    auto base_directory = fs::path(path).parent_path().string();
+    return RunDescription::parse(file, base_directory.empty() ? "." : base_directory);
+}
+
+vector<const RunSection*> RunDescription::get_sections(const string& type) const
+{
+    vector<const RunSection*> matches;
+    for(auto& section : this->sections)
+    {
+        if(section.type == type)
+        {
+            matches.push_back(&section);
+        }
+    }
+    return matches;
+}
+
+string RunDescription::resolve_path(const string& path) const
+{
+    fs::path p(path);
+    if(p.is_absolute())
+    {
+        return p.string();
+    }
+    return (fs::path(this->base_directory) / p).string();
+}
+
+//============================================================================
+static unordered_map<string, native_strategy_factory_t>& native_strategy_registry()
+{
+    static unordered_map<string, native_strategy_factory_t> registry;
+    return registry;
+}
+
+void register_native_strategy(const string& type, native_strategy_factory_t factory)
+{
+    native_strategy_registry()[type] = std::move(factory);
+}
+
+optional<native_strategy_factory_t> get_native_strategy(const string& type)
+{
+    auto& registry = native_strategy_registry();
+    auto it = registry.find(type);
+    if(it == registry.end())
+    {
+        return nullopt;
+    }
+    return it->second;
+}
+
+/// get the assets currently streaming on an exchange, or across all exchanges if no id passed. The ids
+/// are sorted as the exchanges are kept in an unordered map, so orders are placed in the same order
+/// every run
+static vector<string> streaming_assets(Hydra* hydra, const string& exchange_id)
+{
+    vector<string> asset_ids;
+    for(auto& exchange_pair : hydra->exchange_map->exchanges)
+    {
+        if(!exchange_id.empty() && exchange_pair.first != exchange_id)
+        {
+            continue;
+        }
+        exchange_pair.second->for_each_streaming([&](Asset* asset)
+        {
+            asset_ids.push_back(asset->get_asset_id());
+            return true;
+        });
+    }
+    std::sort(asset_ids.begin(), asset_ids.end());
+    return asset_ids;
+}
+
+/**
+ * @brief rebalance the portfolio to an equal pct allocation across streaming assets every n bars,
+ *  with frequency = 0 the allocation is only placed on the first bar (buy and hold)
+ *
+ *  keys: exchange, allocation (total pct of nlv, default 1), frequency (bars, default 0), epsilon
+ */
+static void equal_weight_strategy(Hydra* hydra, Portfolio* portfolio, Strategy* strategy, const RunSection& section, size_t frequency)
+{
+    auto exchange_id = section.get("exchange", "");
+    auto allocation = section.get_double("allocation", 1.0);
+    auto epsilon = section.get_double("epsilon", 0.01);
+    auto strategy_id = strategy->get_strategy_id();
+    auto bar = make_shared<size_t>(0);
+
+    strategy->cxx_handler_on_open = [](){};
+    strategy->cxx_handler_on_close = [=]()
+    {
+        auto current_bar = (*bar)++;
+        if(frequency ? current_bar % frequency : current_bar)
+        {
+            return;
+        }
+        auto asset_ids = streaming_assets(hydra, exchange_id);
+        if(asset_ids.empty())
+        {
+            return;
+        }
+        auto weight = allocation / asset_ids.size();
+        for(auto& asset_id : asset_ids)
+        {
+            portfolio->order_target_size(
+                asset_id,
+                weight,
+                strategy_id,
+                epsilon,
+                OrderTargetType::PCT,
+                OrderExecutionType::LAZY
+            );
+        }
+    };
+}
+
+static bool register_builtin_strategies()
+{
+    register_native_strategy("noop", [](Hydra*, Portfolio*, Strategy* strategy, const RunSection&)
+    {
+        strategy->cxx_handler_on_open = [](){};
+        strategy->cxx_handler_on_close = [](){};
+    });
+    register_native_strategy("buy_and_hold", [](Hydra* hydra, Portfolio* portfolio, Strategy* strategy, const RunSection& section)
+    {
+        equal_weight_strategy(hydra, portfolio, strategy, section, 0);
+    });
+    register_native_strategy("equal_weight", [](Hydra* hydra, Portfolio* portfolio, Strategy* strategy, const RunSection& section)
+    {
+        equal_weight_strategy(hydra, portfolio, strategy, section, section.get_size("frequency", 21));
+    });
+    return true;
+}
+
+static const bool builtin_strategies_registered = register_builtin_strategies();
+
+//============================================================================
+asset_sp_t load_asset_csv(
+    const string& path,
+    const string& asset_id,
+    const string& exchange_id,
+    const string& broker_id,
+    size_t warmup,
+    AssetLayout layout,
+    AssetPrecision precision)
+{
+    std::ifstream file(path);
+    if(!file.is_open())
+    {
+        throw runtime_error("failed to open asset file: " + path);
+    }
+
+    // first column of the header is the datetime index
+    string line;
+    if(!std::getline(file, line))
+    {
+        throw runtime_error("empty asset file: " + path);
+    }
+    auto headers = split(line, ',');
+    if(headers.size() < 2)
+    {
+        throw runtime_error("asset file has no data columns: " + path);
+    }
+    headers.erase(headers.begin());
+    auto cols = headers.size();
+
+    // read rows in row major order then transpose into the column format load_data expects
+    vector<long long> datetime_index;
+    vector<double> rows_data;
+    size_t line_number = 1;
+    while(std::getline(file, line))
+    {
+        line_number++;
+        if(trim(line).empty())
+        {
+            continue;
+        }
+        auto values = split(line, ',');
+        if(values.size() != cols + 1)
+        {
+            throw runtime_error(fmt::format("{}:{}: expected {} columns, found {}",
+                path, line_number, cols + 1, values.size()));
+        }
+        datetime_index.push_back(string_to_nanosecond_epoch_time(values[0]));
+        for(size_t j = 1; j <= cols; j++)
+        {
+            // empty fields are loaded as nan
+            if(values[j].empty())
+            {
+                rows_data.push_back(NAN);
+                continue;
+            }
+            char* end;
+            auto value = std::strtod(values[j].c_str(), &end);
+            if(end == values[j].c_str())
+            {
+                throw runtime_error(fmt::format("{}:{}: invalid value {}", path, line_number, values[j]));
+            }
+            rows_data.push_back(value);
+        }
+    }
+
+    auto rows = datetime_index.size();
+    if(!rows)
+    {
+        throw runtime_error("asset file has no rows: " + path);
+    }
+    vector<double> column_data(rows * cols);
+    for(size_t i = 0; i < rows; i++)
+    {
+        for(size_t j = 0; j < cols; j++)
+        {
+            column_data[j * rows + i] = rows_data[i * cols + j];
+        }
+    }
+
+    auto asset = new_asset(asset_id, exchange_id, broker_id, warmup);
+    asset->load_headers(headers);
+    asset->load_data(column_data.data(), datetime_index.data(), rows, cols, layout, precision);
+    return asset;
+}
+
+//============================================================================
+Runner::Runner(RunDescription description_) : description(std::move(description_))
+{
+}
+
+void Runner::build_assets(const RunSection& section, bool is_index)
+{
+    auto path = fs::path(this->description.resolve_path(section.get("path")));
+    auto exchange_id = section.get("exchange", "");
+    auto broker_id = section.get("broker", "");
+    auto warmup = section.get_size("warmup", 0);
+
+    if(!is_index && exchange_id.empty())
+    {
+        throw section_error(section, "missing required key \"exchange\"");
+    }
+
+    auto layout_name = to_lower(section.get("layout", "row"));
+    if(layout_name != "row" && layout_name != "column")
+    {
+        throw section_error(section, "layout must be row or column");
+    }
+    auto layout = layout_name == "row" ? AssetLayout::RowMajor : AssetLayout::ColumnMajor;
+
+    auto precision_name = to_lower(section.get("precision", "float64"));
+    if(precision_name != "float64" && precision_name != "float32")
+    {
+        throw section_error(section, "precision must be float64 or float32");
+    }
+    auto precision = precision_name == "float64" ? AssetPrecision::Float64 : AssetPrecision::Float32;
+
+    // a directory loads every csv and binary asset file in it using the file stem as the asset id
+    vector<pair<string, string>> files;
+    if(fs::is_directory(path))
+    {
+        for(auto& entry : fs::directory_iterator(path))
+        {
+            auto extension = to_lower(entry.path().extension().string());
+            if(entry.is_regular_file() && (extension == ".csv" || extension == ASSET_FILE_EXTENSION))
+            {
+                files.emplace_back(entry.path().stem().string(), entry.path().string());
+            }
+        }
+        std::sort(files.begin(), files.end());
+    }
+    else
+    {
+        files.emplace_back(section.id.empty() ? path.stem().string() : section.id, path.string());
+    }
+
+    // binary asset files can be streamed through a window of rows instead of mapped in full
+    auto stream = section.get_bool("stream", false);
+    auto chunk_rows = section.get_size("chunk_rows", ASSET_STREAM_CHUNK_ROWS);
+    auto lookback = section.get_size("lookback", 0);
+
+    for(auto& [asset_id, file] : files)
+    {
+        // binary asset files are memory mapped in the layout and precision they were written with
+        asset_sp_t asset;
+        if(to_lower(fs::path(file).extension().string()) == ASSET_FILE_EXTENSION)
+        {
+            asset = new_asset(asset_id, exchange_id, broker_id, warmup);
+            if(stream)
+            {
+                asset->load_file_stream(file, chunk_rows, lookback);
+            }
+            else
+            {
+                asset->load_mmap(file);
+            }
+        }
+        else
+        {
+            asset = load_asset_csv(file, asset_id, exchange_id, broker_id, warmup, layout, precision);
+        }
+        if(is_index)
+        {
+            this->hydra->register_index_asset(asset, exchange_id);
+        }
+        else
+        {
+            this->hydra->register_asset(asset, exchange_id);
+        }
+    }
+}
+
+void Runner::build_portfolio(const RunSection& section)
+{
+    if(section.id.empty())
+    {
+        throw section_error(section, "portfolio section requires an id");
+    }
+
+    // the master portfolio can only have tracers registered
+    shared_ptr<Portfolio> portfolio;
+    if(section.id == this->hydra->get_master_portflio()->get_portfolio_id())
+    {
+        portfolio = this->hydra->get_master_portflio();
+    }
+    else
+    {
+        auto parent = this->hydra->get_portfolio(section.get("parent", "master"));
+        portfolio = parent->create_sub_portfolio(section.id, section.get_double("cash", 0.0));
+    }
+
+    auto tracers = section.get_list("tracers");
+    for(auto& tracer : tracers)
+    {
+        PortfolioTracerType tracer_type;
+        auto tracer_name = to_lower(tracer);
+        if(tracer_name == "value")      tracer_type = PortfolioTracerType::Value;
+        else if(tracer_name == "event") tracer_type = PortfolioTracerType::Event;
+        else if(tracer_name == "beta")  tracer_type = PortfolioTracerType::PortfolioBeta;
+        else throw section_error(section, "invalid portfolio tracer type: " + tracer);
+
+        // portfolios may already hold a value tracer by default
+        if(!portfolio->get_portfolio_history()->get_tracer(tracer_type))
+        {
+            portfolio->add_tracer(tracer_type);
+        }
+    }
+    if(!tracers.empty())
+    {
+        this->traced_portfolios.push_back(portfolio);
+    }
+}
+
+void Runner::build_strategy(const RunSection& section)
+{
+    auto type = section.get("type");
+    auto factory = get_native_strategy(type);
+    if(!factory.has_value())
+    {
+        throw section_error(section, "unknown native strategy type: " + type);
+    }
+    auto strategy_id = section.id.empty() ? type : section.id;
+    auto portfolio = this->hydra->get_portfolio(section.get("portfolio", "master"));
+    auto strategy = this->hydra->new_strategy(strategy_id);
+    factory.value()(this->hydra.get(), portfolio.get(), strategy.get(), section);
+}
+
+void Runner::build()
+{
+    auto hydra_sections = this->description.get_sections("hydra");
+    RunSection hydra_section = hydra_sections.empty() ? RunSection{} : *hydra_sections.front();
+    this->hydra = make_shared<Hydra>(
+        static_cast<int>(hydra_section.get_size("logging", 0)),
+        hydra_section.get_double("cash", 0.0)
+    );
+    this->hydra->set_threads(hydra_section.get_size("threads", 1));
+    this->traced_portfolios.clear();
+
+    for(auto section : this->description.get_sections("exchange"))
+    {
+        auto exchange = this->hydra->new_exchange(section->id);
+        if(section->get_bool("panel", false))
+        {
+            exchange->enable_panel(section->get_list("panel_columns"));
+        }
+        exchange->set_lazy_tracers(section->get_bool("lazy_tracers", false));
+    }
+    for(auto section : this->description.get_sections("broker"))
+    {
+        this->hydra->new_broker(section->id, section->get_double("cash", 0.0));
+    }
+    for(auto section : this->description.get_sections("asset"))
+    {
+        this->build_assets(*section, false);
+    }
+    for(auto section : this->description.get_sections("index"))
+    {
+        this->build_assets(*section, true);
+    }
+
+    // exchange tracers are written as type:lookback[:column] and registered to every asset on the exchange
+    for(auto section : this->description.get_sections("exchange"))
+    {
+        auto exchange = this->hydra->get_exchange(section->id);
+        auto adjust_warmup = section->get_bool("adjust_warmup", true);
+        for(auto& tracer : section->get_list("tracers"))
+        {
+            auto parts = split(tracer, ':');
+            if(parts.size() != 2 && parts.size() != 3)
+            {
+                throw section_error(*section, "asset tracers must be written as type:lookback[:column], found " + tracer);
+            }
+            auto tracer_type = to_lower(parts[0]);
+            size_t lookback;
+            if(!parse_size(parts[1], lookback))
+            {
+                throw section_error(*section, fmt::format("invalid lookback for \"tracers\": {}", tracer));
+            }
+            auto column = parts.size() == 3 ? parts[2] : "";
+            if(tracer_type == "volatility")  exchange->add_tracer(AssetTracerType::Volatility, lookback, adjust_warmup);
+            else if(tracer_type == "beta")   exchange->add_tracer(AssetTracerType::Beta, lookback, adjust_warmup);
+            else if(tracer_type == "sma")    exchange->add_tracer(AssetTracerType::MovingAverage, lookback, adjust_warmup, column);
+            else if(tracer_type == "ema")    exchange->add_tracer(AssetTracerType::ExponentialMovingAverage, lookback, adjust_warmup, column);
+            else if(tracer_type == "min")    exchange->add_tracer(AssetTracerType::RollingMin, lookback, adjust_warmup, column);
+            else if(tracer_type == "max")    exchange->add_tracer(AssetTracerType::RollingMax, lookback, adjust_warmup, column);
+            else if(tracer_type == "zscore") exchange->add_tracer(AssetTracerType::RollingZScore, lookback, adjust_warmup, column);
+            else if(tracer_type == "atr")    exchange->add_tracer(AssetTracerType::AverageTrueRange, lookback, adjust_warmup);
+            else throw section_error(*section, "invalid asset tracer type: " + tracer);
+        }
+    }
+
+    for(auto section : this->description.get_sections("portfolio"))
+    {
+        this->build_portfolio(*section);
+    }
+    for(auto section : this->description.get_sections("strategy"))
+    {
+        this->build_strategy(*section);
+    }
+
+    this->hydra->build();
+}
+
+void Runner::run()
+{
+    if(!this->hydra)
+    {
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::NotBuilt);
+    }
+    this->hydra->run();
+}
+
+static std::ofstream open_output(const fs::path& path)
+{
+    std::ofstream file(path);
+    if(!file.is_open())
+    {
+        throw runtime_error("failed to open output file: " + path.string());
+    }
+    file.precision(17);
+    return file;
+}
+
+void Runner::write_output(string directory)
+{
+    if(directory.empty())
+    {
+        auto output_sections = this->description.get_sections("output");
+        directory = output_sections.empty() ? "." : output_sections.front()->get("directory", ".");
+        directory = this->description.resolve_path(directory);
+    }
+    fs::create_directories(directory);
+
+    for(auto& portfolio : this->traced_portfolios)
+    {
+        auto& portfolio_id = portfolio->get_portfolio_id();
+        auto portfolio_history = portfolio->get_portfolio_history();
+
+        auto value_tracer = portfolio_history->get_tracer(PortfolioTracerType::Value);
+        if(value_tracer)
+        {
+            auto tracer = static_pointer_cast<ValueTracer>(value_tracer);
+            auto file = open_output(fs::path(directory) / (portfolio_id + "_value.csv"));
+            file << "datetime,nlv,cash\n";
+            for(size_t i = 0; i < tracer->datetime_index.size(); i++)
+            {
+                file << tracer->datetime_index[i] << ','
+                     << tracer->nlv_history[i] << ','
+                     << tracer->cash_history[i] << '\n';
+            }
+        }
+
+        auto event_tracer = portfolio_history->get_tracer(PortfolioTracerType::Event);
+        if(event_tracer)
+        {
+            auto tracer = static_pointer_cast<EventTracer>(event_tracer);
+
+            auto orders = open_output(fs::path(directory) / (portfolio_id + "_orders.csv"));
+            orders << "order_id,fill_time,asset_id,exchange_id,broker_id,strategy_id,units,average_price,order_type,order_state,trade_id\n";
+            for(auto& order : tracer->get_order_history())
+            {
+                orders << order->get_order_id() << ','
+                       << order->get_fill_time() << ','
+                       << order->get_asset_id() << ','
+                       << order->get_exchange_id() << ','
+                       << order->get_broker_id() << ','
+                       << order->get_strategy_id() << ','
+                       << order->get_units() << ','
+                       << order->get_average_price() << ','
+                       << order->get_order_type() << ','
+                       << order->get_order_state() << ','
+                       << order->get_trade_id() << '\n';
+            }
+
+            auto trades = open_output(fs::path(directory) / (portfolio_id + "_trades.csv"));
+            trades << "trade_id,asset_id,exchange_id,units,average_price,close_price,open_time,close_time,realized_pl\n";
+            for(auto& trade : tracer->get_trade_history())
+            {
+                trades << trade->get_trade_id() << ','
+                       << trade->get_asset_id() << ','
+                       << trade->get_exchange_id() << ','
+                       << trade->get_units() << ','
+                       << trade->get_average_price() << ','
+                       << trade->get_close_price() << ','
+                       << trade->get_trade_open_time() << ','
+                       << trade->get_trade_close_time() << ','
+                       << trade->get_realized_pl() << '\n';
+            }
+
+            auto positions = open_output(fs::path(directory) / (portfolio_id + "_positions.csv"));
+            positions << "position_id,asset_id,exchange_id,units,average_price,close_price,open_time,close_time,trade_count\n";
+            for(auto& position : tracer->get_position_history())
+            {
+                positions << position->get_position_id() << ','
+                          << position->get_asset_id() << ','
+                          << position->get_exchange_id() << ','
+                          << position->get_units() << ','
+                          << position->get_average_price() << ','
+                          << position->get_close_price() << ','
+                          << position->get_position_open_time() << ','
+                          << position->get_position_close_time() << ','
+                          << position->get_trade_count() << '\n';
+            }
+        }
+    }
+}
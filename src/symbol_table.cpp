@@ -0,0 +1,36 @@
+//
+// interning of the string ids of assets, exchanges, brokers, strategies and asset groups into dense integer symbols
+//
+#include <array>
+
+#include "symbol_table.h"
+
+symbol_t SymbolTable::intern(const string& id)
+{
+    auto it = this->symbols.find(id);
+    if(it != this->symbols.end())
+    {
+        return it->second;
+    }
+
+    auto symbol = static_cast<symbol_t>(this->ids.size());
+    this->ids.push_back(id);
+    this->symbols.emplace(id, symbol);
+    return symbol;
+}
+
+optional<symbol_t> SymbolTable::find(const string& id) const
+{
+    auto it = this->symbols.find(id);
+    if(it == this->symbols.end())
+    {
+        return nullopt;
+    }
+    return it->second;
+}
+
+SymbolTable& SymbolTable::get(SymbolType symbol_type)
+{
+    static std::array<SymbolTable, SYMBOL_TYPE_COUNT> tables;
+    return tables[static_cast<size_t>(symbol_type)];
+}
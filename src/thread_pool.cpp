@@ -0,0 +1,140 @@
+//
+// work stealing thread pool used to step the assets of a bar in parallel
+//
+#include "alloc_tracker.h"
+#include "thread_pool.h"
+
+/// number of times an idle worker polls for a new range before sleeping
+static size_t constexpr THREAD_POOL_SPIN = 4096;
+
+ThreadPool::ThreadPool(size_t workers_) : participants(std::max<size_t>(workers_, 1))
+{
+    this->ranges = std::make_unique<WorkRange[]>(this->participants);
+    this->threads.reserve(this->participants - 1);
+    for(size_t participant = 1; participant < this->participants; participant++)
+    {
+        this->threads.emplace_back(&ThreadPool::worker_loop, this, participant);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    this->stopping.store(true, std::memory_order_release);
+    this->epoch.fetch_add(1, std::memory_order_release);
+    this->epoch.notify_all();
+    for(auto& thread : this->threads)
+    {
+        thread.join();
+    }
+}
+
+void ThreadPool::run(size_t n, size_t grain_, task_t task_, void* context_)
+{
+    // give each participant an equal contiguous share of the range
+    auto share = n / this->participants;
+    auto remainder = n % this->participants;
+    size_t begin = 0;
+    for(size_t participant = 0; participant < this->participants; participant++)
+    {
+        auto end = begin + share + (participant < remainder ? 1 : 0);
+        this->ranges[participant].next.store(begin, std::memory_order_relaxed);
+        this->ranges[participant].end = end;
+        begin = end;
+    }
+    this->task = task_;
+    this->context = context_;
+    this->grain = std::max<size_t>(grain_, 1);
+    this->pending.store(this->threads.size(), std::memory_order_relaxed);
+#ifdef ARGUS_ALLOC_TRACKING
+    this->alloc_phase = AllocTracker::get_phase();
+    this->alloc_strict = AllocTracker::get_strict();
+#endif
+
+    // publish the range and wake the workers, the calling thread is participant 0
+    this->epoch.fetch_add(1, std::memory_order_release);
+    this->epoch.notify_all();
+    this->work(0);
+
+    size_t remaining;
+    while((remaining = this->pending.load(std::memory_order_acquire)) != 0)
+    {
+        this->pending.wait(remaining, std::memory_order_acquire);
+    }
+
+    if(this->error)
+    {
+        auto error_ = this->error;
+        this->error = nullptr;
+        std::rethrow_exception(error_);
+    }
+}
+
+void ThreadPool::work(size_t participant)
+{
+    // start on the participant's own share then steal from the next participants in turn
+    for(size_t i = 0; i < this->participants; i++)
+    {
+        auto& range = this->ranges[(participant + i) % this->participants];
+        while(true)
+        {
+            auto begin = range.next.fetch_add(this->grain, std::memory_order_relaxed);
+            if(begin >= range.end)
+            {
+                break;
+            }
+            try
+            {
+                this->task(this->context, begin, std::min(begin + this->grain, range.end));
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> lock(this->error_mutex);
+                if(!this->error)
+                {
+                    this->error = std::current_exception();
+                }
+            }
+        }
+    }
+}
+
+void ThreadPool::worker_loop(size_t participant)
+{
+    uint64_t seen = 0;
+    while(true)
+    {
+        // poll for the next range for a while before sleeping, bars arrive back to back in a run
+        uint64_t current = this->epoch.load(std::memory_order_acquire);
+        for(size_t spin = 0; current == seen && spin < THREAD_POOL_SPIN; spin++)
+        {
+            std::this_thread::yield();
+            current = this->epoch.load(std::memory_order_acquire);
+        }
+        if(current == seen)
+        {
+            this->epoch.wait(seen, std::memory_order_acquire);
+            continue;
+        }
+        seen = current;
+
+        if(this->stopping.load(std::memory_order_acquire))
+        {
+            return;
+        }
+#ifdef ARGUS_ALLOC_TRACKING
+        // allocations made on the worker count against the caller's phase
+        AllocTracker::set_phase(this->alloc_phase);
+        AllocTracker::set_strict(this->alloc_strict);
+        this->work(participant);
+        AllocTracker::set_phase(-1);
+        AllocTracker::set_strict(false);
+#else
+        this->work(participant);
+#endif
+
+        if(this->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            this->pending.notify_one();
+        }
+    }
+}
@@ -0,0 +1,154 @@
+//
+// volatility tracers of every asset on an exchange kept as arrays indexed by market slot
+//
+#include "tracer_bank.h"
+
+void VolatilityBank::resize(size_t slots)
+{
+    this->assets.assign(slots, nullptr);
+    this->assigned = 0;
+    this->start_ptrs.assign(slots, nullptr);
+    this->end_ptrs.assign(slots, nullptr);
+    this->strides.assign(slots, 0);
+    this->sums.assign(slots, 0);
+    this->sum_squares.assign(slots, 0);
+    this->volatilities.assign(slots, 0);
+    this->rows_needed.assign(slots, 0);
+    this->old_pcts.assign(slots, 0);
+    this->new_pcts.assign(slots, 0);
+}
+
+void VolatilityBank::assign(uint32_t slot, Asset* asset)
+{
+    if(!this->assets[slot])
+    {
+        this->assigned++;
+    }
+    this->assets[slot] = asset;
+}
+
+void VolatilityBank::build(uint32_t slot)
+{
+    auto asset = this->assets[slot];
+    auto window = init_array_window(asset, this->lookback);
+    this->start_ptrs[slot] = window.start_ptr;
+    this->end_ptrs[slot] = window.end_ptr;
+    this->strides[slot] = window.stride;
+    this->rows_needed[slot] = window.rows_needed;
+
+    // sum the percent changes already in the window, as the volatility tracer does
+    double sum = 0;
+    double sum_squares = 0;
+    auto previous = *window.start_ptr;
+    for(auto ptr = window.start_ptr + window.stride; ptr < window.end_ptr; ptr += window.stride)
+    {
+        auto pct_change = (*ptr - previous) / previous;
+        sum += pct_change;
+        sum_squares += pct_change * pct_change;
+        previous = *ptr;
+    }
+    this->sums[slot] = sum;
+    this->sum_squares[slot] = sum_squares;
+    this->volatilities[slot] = 0;
+
+    // if the window is fully loaded set the volatility
+    if(asset->current_index >= this->lookback)
+    {
+        auto n = static_cast<double>(this->lookback);
+        this->volatilities[slot] = (sum_squares - (sum * sum) / n) / (n - 1);
+        asset->set_volatility(&this->volatilities[slot]);
+    }
+    else
+    {
+        asset->set_volatility(nullptr);
+    }
+}
+
+void VolatilityBank::step(uint32_t const * slots, size_t count)
+{
+    if(count == 0)
+    {
+        return;
+    }
+
+    // a contiguous run of slots in a full bank is stepped by position, the gather reads one row
+    // of each asset and the update runs over contiguous arrays
+    auto first = slots[0];
+    if(this->assigned == this->assets.size() && slots[count - 1] - first + 1 == count)
+    {
+        auto last = first + static_cast<uint32_t>(count);
+        for(auto slot = first; slot < last; slot++)
+        {
+            this->gather(slot);
+        }
+        for(auto slot = first; slot < last; slot++)
+        {
+            this->accumulate(slot);
+        }
+        for(auto slot = first; slot < last; slot++)
+        {
+            this->warm_up(slot);
+        }
+        return;
+    }
+
+    // otherwise follow the slot list, skipping slots without a tracer
+    for(size_t i = 0; i < count; i++)
+    {
+        if(this->assets[slots[i]])
+        {
+            this->gather(slots[i]);
+            this->accumulate(slots[i]);
+            this->warm_up(slots[i]);
+        }
+    }
+}
+
+void VolatilityBank::rebase(uint32_t slot, double* old_base, double* new_base)
+{
+    this->start_ptrs[slot] = new_base + (this->start_ptrs[slot] - old_base);
+    this->end_ptrs[slot] = new_base + (this->end_ptrs[slot] - old_base);
+}
+
+BankedVolatilityTracer::BankedVolatilityTracer(Asset* parent_asset_, shared_ptr<VolatilityBank> bank_)
+    : AssetTracer(parent_asset_, bank_->get_lookback()), bank(std::move(bank_))
+{
+}
+
+void BankedVolatilityTracer::step()
+{
+    // the exchange steps the bank, an asset stepped on its own steps its slot
+    if(this->slot != std::numeric_limits<uint32_t>::max())
+    {
+        this->bank->step(&this->slot, 1);
+    }
+}
+
+void BankedVolatilityTracer::build()
+{
+    // the slot is assigned when the exchange is built
+    if(this->slot == std::numeric_limits<uint32_t>::max())
+    {
+        this->parent_asset->set_volatility(nullptr);
+        return;
+    }
+    this->bank->build(this->slot);
+}
+
+void BankedVolatilityTracer::rebase(double* old_base, double* new_base)
+{
+    if(this->slot != std::numeric_limits<uint32_t>::max())
+    {
+        this->bank->rebase(this->slot, old_base, new_base);
+    }
+}
+
+double BankedVolatilityTracer::get_value() const
+{
+    return this->slot == std::numeric_limits<uint32_t>::max() ? 0 : this->bank->get_volatility(this->slot);
+}
+
+bool BankedVolatilityTracer::get_is_warm() const
+{
+    return this->slot != std::numeric_limits<uint32_t>::max() && this->bank->get_is_warm(this->slot);
+}
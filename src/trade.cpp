@@ -33,10 +33,10 @@ Trade::Trade(shared_ptr<Order> filled_order, bool dummy) : source_portfolio(fill
         this->trade_counter++;
     }
 
-    this->asset_id = filled_order->get_asset_id();
-    this->exchange_id = filled_order->get_exchange_id();
-    this->broker_id = filled_order->get_broker_id();
-    this->strategy_id = filled_order->get_strategy_id();
+    this->asset_symbol = filled_order->get_asset_symbol();
+    this->exchange_symbol = filled_order->get_exchange_symbol();
+    this->broker_symbol = filled_order->get_broker_symbol();
+    this->strategy_symbol = filled_order->get_strategy_symbol();
 
     // set the trade member variables
     this->units = filled_order->get_units();
@@ -118,12 +118,12 @@ void Trade::reduce(double market_price_, double units_, long long int trade_chan
 shared_ptr<Order> Trade::generate_order_inverse(){
     return std::make_shared<Order>(
         MARKET_ORDER,
-        this->asset_id,
+        this->asset_symbol,
         this->units * -1,
-        this->exchange_id,
-        this->broker_id,
+        this->exchange_symbol,
+        this->broker_symbol,
         this->source_portfolio,
-        this->strategy_id,
+        this->strategy_symbol,
         this->trade_id
     );
 }
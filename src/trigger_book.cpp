@@ -0,0 +1,111 @@
+//
+// resting limit, stop loss and take profit orders of an exchange indexed by market slot and trigger price
+//
+#include <cassert>
+#include <limits>
+
+#include "settings.h"
+#include "trigger_book.h"
+
+/// position of a slot that is not active
+static uint32_t constexpr TRIGGER_SLOT_INACTIVE = std::numeric_limits<uint32_t>::max();
+
+void TriggerBook::resize(size_t slots)
+{
+    this->books.clear();
+    this->books.resize(slots);
+    this->active_slots.clear();
+    this->active_slots.reserve(slots);
+    this->active_positions.assign(slots, TRIGGER_SLOT_INACTIVE);
+    this->orders = 0;
+}
+
+void TriggerBook::clear()
+{
+    for(auto slot : this->active_slots)
+    {
+        this->books[slot].below.clear();
+        this->books[slot].above.clear();
+        this->active_positions[slot] = TRIGGER_SLOT_INACTIVE;
+    }
+    this->active_slots.clear();
+    this->orders = 0;
+}
+
+void TriggerBook::insert(uint32_t slot, const shared_ptr<Order>& order)
+{
+    // zero unit orders are rejected when they are placed
+    auto units = order->get_units();
+    #ifdef ARGUS_RUNTIME_ASSERT
+    assert(units != 0);
+    #endif
+    // a buy limit, a sell stop loss and a buy take profit fill once the price falls to the limit
+    bool below;
+    switch (order->get_order_type())
+    {
+    case LIMIT_ORDER:
+        below = units > 0;
+        break;
+    case STOP_LOSS_ORDER:
+        below = units < 0;
+        break;
+    case TAKE_PROFIT_ORDER:
+        below = units > 0;
+        break;
+    default:
+        ARGUS_RUNTIME_ERROR(ArgusErrorCode::NotImplemented);
+    }
+
+    auto& book = this->books[slot];
+    if(below)
+    {
+        book.below.push_back({order->get_limit(), order->get_order_id(), order});
+        std::push_heap(book.below.begin(), book.below.end(), TriggerBook::below_order);
+    }
+    else
+    {
+        book.above.push_back({order->get_limit(), order->get_order_id(), order});
+        std::push_heap(book.above.begin(), book.above.end(), TriggerBook::above_order);
+    }
+    this->orders++;
+
+    if(this->active_positions[slot] == TRIGGER_SLOT_INACTIVE)
+    {
+        this->active_positions[slot] = static_cast<uint32_t>(this->active_slots.size());
+        this->active_slots.push_back(slot);
+    }
+}
+
+bool TriggerBook::remove(uint32_t slot, size_t order_id)
+{
+    if(this->active_positions[slot] == TRIGGER_SLOT_INACTIVE)
+    {
+        return false;
+    }
+    auto& book = this->books[slot];
+    if(!this->remove_from(book.below, TriggerBook::below_order, order_id)
+        && !this->remove_from(book.above, TriggerBook::above_order, order_id))
+    {
+        return false;
+    }
+    this->orders--;
+    if(book.below.empty() && book.above.empty())
+    {
+        this->deactivate(slot);
+    }
+    return true;
+}
+
+void TriggerBook::deactivate(uint32_t slot)
+{
+    auto position = this->active_positions[slot];
+    if(position == TRIGGER_SLOT_INACTIVE)
+    {
+        return;
+    }
+    auto last = this->active_slots.back();
+    this->active_slots[position] = last;
+    this->active_positions[last] = position;
+    this->active_slots.pop_back();
+    this->active_positions[slot] = TRIGGER_SLOT_INACTIVE;
+}
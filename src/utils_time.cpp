@@ -5,6 +5,10 @@
 #include <string>
 #include <chrono>
 #include <ctime>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
 
 std::string nanosecond_epoch_time_to_string(long long ns_epoch_time) {
     // Define the epoch time for the system clock
@@ -31,3 +35,54 @@ std::string nanosecond_epoch_time_to_string(long long ns_epoch_time) {
 
     return str;
 }
+
+static long long days_from_civil(long long y, unsigned m, unsigned d)
+{
+    // days since 1970-01-01 of a proleptic gregorian date
+    y -= m <= 2;
+    const long long era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<long long>(doe) - 719468;
+}
+
+long long string_to_nanosecond_epoch_time(const std::string& datetime)
+{
+    // trim surrounding whitespace
+    auto start = datetime.find_first_not_of(" \t\r\n\"");
+    auto end = datetime.find_last_not_of(" \t\r\n\"");
+    if(start == std::string::npos)
+    {
+        throw std::runtime_error("empty datetime string");
+    }
+    auto str = datetime.substr(start, end - start + 1);
+
+    // raw ns epoch time stamp
+    if(str.find('-', 1) == std::string::npos)
+    {
+        char* end;
+        errno = 0;
+        auto epoch = std::strtoll(str.c_str(), &end, 10);
+        if(end == str.c_str() || *end != '\0' || errno == ERANGE)
+        {
+            throw std::runtime_error("invalid datetime string: " + datetime);
+        }
+        return epoch;
+    }
+
+    int year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+    char sep = ' ';
+    int parsed = std::sscanf(str.c_str(), "%d-%d-%d%c%d:%d:%d",
+        &year, &month, &day, &sep, &hour, &minute, &second);
+    if(parsed < 3 || month < 1 || month > 12 || day < 1 || day > 31)
+    {
+        throw std::runtime_error("invalid datetime string: " + datetime);
+    }
+
+    long long seconds = days_from_civil(year, month, day) * 86400LL
+        + hour * 3600LL
+        + minute * 60LL
+        + second;
+    return seconds * 1000000000LL;
+}
@@ -0,0 +1,64 @@
+//
+// argus_run: headless backtest driver, runs a backtest described by a run description file
+//
+// usage: argus_run <run description> [--output DIR] [--quiet]
+//
+#include <chrono>
+#include <cstring>
+#include <fmt/core.h>
+
+#include "runner.h"
+
+using namespace std;
+
+int main(int argc, char** argv)
+{
+    string description_path;
+    string output_directory;
+    bool quiet = false;
+    for(int i = 1; i < argc; i++)
+    {
+        if(!strcmp(argv[i], "--output") && i + 1 < argc) output_directory = argv[++i];
+        else if(!strcmp(argv[i], "--quiet"))             quiet = true;
+        else if(description_path.empty())                description_path = argv[i];
+        else
+        {
+            fmt::print(stderr, "unexpected argument: {}\n", argv[i]);
+            return 2;
+        }
+    }
+    if(description_path.empty())
+    {
+        fmt::print(stderr, "usage: argus_run <run description> [--output DIR] [--quiet]\n");
+        return 2;
+    }
+
+    try
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        Runner runner(RunDescription::parse_file(description_path));
+        runner.build();
+
+        auto t1 = std::chrono::steady_clock::now();
+        runner.run();
+
+        auto t2 = std::chrono::steady_clock::now();
+        runner.write_output(output_directory);
+
+        if(!quiet)
+        {
+            auto hydra = runner.get_hydra();
+            auto master = hydra->get_master_portflio();
+            auto ms = [](auto a, auto b){ return std::chrono::duration<double, std::milli>(b - a).count(); };
+            fmt::print("candles: {}, nlv: {:.2f}, cash: {:.2f}\n",
+                hydra->get_candles(), master->get_nlv(), master->get_cash());
+            fmt::print("build: {:.3f} ms, run: {:.3f} ms\n", ms(t0, t1), ms(t1, t2));
+        }
+    }
+    catch(const std::exception& e)
+    {
+        fmt::print(stderr, "argus_run: {}\n", e.what());
+        return 1;
+    }
+    return 0;
+}